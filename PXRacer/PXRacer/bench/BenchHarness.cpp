@@ -0,0 +1,118 @@
+#include "BenchHarness.h"
+#include "Core/AllocationCounter.h"
+#include "Core/BenchmarkBaseline.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // A calibration batch has to run at least this long to be timed reliably
+    constexpr double MIN_BATCH_SECONDS = 0.001;
+
+    double timeBatch(const std::function<void(std::uint64_t)>& body, std::uint64_t iterations) {
+        const auto start = Clock::now();
+        body(iterations);
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    std::string jsonEscape(const std::string& text) {
+        std::string out;
+        out.reserve(text.size());
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+}
+
+BenchRunner::BenchRunner(const BenchOptions& options)
+    : m_options(options)
+{
+}
+
+void BenchRunner::run(const std::string& name, const std::function<void(std::uint64_t)>& body) {
+    if (!m_options.filter.empty() && name.find(m_options.filter) == std::string::npos) return;
+
+    // Calibrate: double the batch until it is long enough to time, then keep
+    // running it until the warm-up time is used up
+    std::uint64_t iterations = 1;
+    double seconds = timeBatch(body, iterations);
+    double warmup = seconds;
+    while (seconds < MIN_BATCH_SECONDS) {
+        iterations *= 2;
+        seconds = timeBatch(body, iterations);
+        warmup += seconds;
+    }
+    while (warmup < m_options.warmupSeconds) {
+        seconds = timeBatch(body, iterations);
+        warmup += seconds;
+    }
+
+    BenchResult result;
+    result.name = name;
+    const double secondsPerOp = seconds / static_cast<double>(iterations);
+    result.iterations = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(m_options.repetitionSeconds / secondsPerOp));
+
+    std::uint64_t allocations = 0;
+    for (int rep = 0; rep < m_options.repetitions; ++rep) {
+        const std::uint64_t allocationsBefore = AllocationCounter::getThreadAllocations();
+        const double repSeconds = timeBatch(body, result.iterations);
+        allocations += AllocationCounter::getThreadAllocations() - allocationsBefore;
+        result.samples.push_back(repSeconds * 1e9 / static_cast<double>(result.iterations));
+    }
+
+    std::vector<double> sorted = result.samples;
+    std::sort(sorted.begin(), sorted.end());
+    const std::size_t count = sorted.size();
+    result.nsPerOp = count % 2 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+    result.minNs = sorted.front();
+    double sum = 0.0;
+    for (double sample : sorted) sum += sample;
+    result.meanNs = sum / count;
+    double variance = 0.0;
+    for (double sample : sorted) variance += (sample - result.meanNs) * (sample - result.meanNs);
+    result.stddevNs = count > 1 ? std::sqrt(variance / (count - 1)) : 0.0;
+    result.allocsPerOp = static_cast<double>(allocations) / (static_cast<double>(result.iterations) * count);
+
+    std::printf("%-48s %12.1f ns/op %9.2f allocs/op  +-%4.1f%%\n", name.c_str(), result.nsPerOp,
+                result.allocsPerOp, result.meanNs > 0.0 ? 100.0 * result.stddevNs / result.meanNs : 0.0);
+    std::fflush(stdout);
+    m_results.push_back(std::move(result));
+}
+
+bool BenchRunner::writeJson(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    char number[64];
+    out << "{\n  \"machine\": " << MachineFingerprint::current().toJson() << ",\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < m_results.size(); ++i) {
+        const BenchResult& result = m_results[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": \"" << jsonEscape(result.name) << "\"";
+        out << ", \"iterations\": " << result.iterations;
+        out << ", \"repetitions\": " << result.samples.size();
+        std::snprintf(number, sizeof(number), "%.3f", result.nsPerOp);
+        out << ", \"ns_per_op\": " << number;
+        std::snprintf(number, sizeof(number), "%.3f", result.minNs);
+        out << ", \"min_ns\": " << number;
+        std::snprintf(number, sizeof(number), "%.3f", result.meanNs);
+        out << ", \"mean_ns\": " << number;
+        std::snprintf(number, sizeof(number), "%.3f", result.stddevNs);
+        out << ", \"stddev_ns\": " << number;
+        std::snprintf(number, sizeof(number), "%.4f", result.allocsPerOp);
+        out << ", \"allocs_per_op\": " << number;
+        out << ", \"samples\": [";
+        for (std::size_t s = 0; s < result.samples.size(); ++s) {
+            std::snprintf(number, sizeof(number), "%.3f", result.samples[s]);
+            out << (s ? ", " : "") << number;
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct BenchOptions {
+    double warmupSeconds = 0.1;         // per benchmark, before anything is measured
+    double repetitionSeconds = 0.05;    // target duration of one measured repetition
+    int repetitions = 15;
+    std::string filter;                 // only benchmarks whose name contains it
+};
+
+struct BenchResult {
+    std::string name;
+    std::uint64_t iterations = 0;       // per repetition
+    std::vector<double> samples;        // ns/op of each repetition
+    double nsPerOp = 0.0;               // median of the samples
+    double minNs = 0.0;
+    double meanNs = 0.0;
+    double stddevNs = 0.0;
+    double allocsPerOp = 0.0;           // heap allocations, measured repetitions only
+};
+
+// Keeps the compiler from discarding a result the benchmark never uses
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// Warm-up, calibration and repetition for the microbenchmarks. A benchmark is
+// a body that runs the operation a given number of times; the runner first
+// calls it until the warm-up time is spent (caches, arenas and lazily grown
+// buffers settle), sizes a repetition to repetitionSeconds and then times
+// the repetitions. The median is reported so one preempted repetition
+// doesn't move the result.
+class BenchRunner {
+public:
+    explicit BenchRunner(const BenchOptions& options);
+
+    void run(const std::string& name, const std::function<void(std::uint64_t iterations)>& body);
+
+    const std::vector<BenchResult>& getResults() const { return m_results; }
+    bool writeJson(const std::string& path) const;
+
+private:
+    BenchOptions m_options;
+    std::vector<BenchResult> m_results;
+};
@@ -0,0 +1,119 @@
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <string>
+
+// Scheduling overhead of the shared job system: every job is (almost) empty,
+// so the time per task is what submitting, queueing, stealing and waiting cost.
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double nsPer(Clock::duration elapsed, std::size_t count) {
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(count);
+    }
+
+    void report(const char* schedule, const char* test, double nsPerTask) {
+        std::printf("%-18s %-28s %12.1f ns/task\n", schedule, test, nsPerTask);
+    }
+
+    void runSuite(const char* name, JobSystem& jobs, std::size_t tasks) {
+        std::atomic<std::size_t> counter{ 0 };
+
+        // Warm-up: spins the workers up and sizes the queues
+        for (std::size_t i = 0; i < tasks / 10; ++i) jobs.submit([&counter]() { counter++; });
+        jobs.wait();
+
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < tasks; ++i) jobs.submit([&counter]() { counter++; });
+        jobs.wait();
+        report(name, "submit + wait", nsPer(Clock::now() - start, tasks));
+
+        start = Clock::now();
+        {
+            TaskGroup group;
+            for (std::size_t i = 0; i < tasks; ++i) jobs.submit(group, [&counter]() { counter++; });
+            jobs.wait(group);
+        }
+        report(name, "task group", nsPer(Clock::now() - start, tasks));
+
+        // Small ranges, as a frame would issue them: the cost is per chunk
+        constexpr std::size_t RANGE = 4096;
+        constexpr std::size_t GRAIN = 64;
+        const std::size_t loops = std::max<std::size_t>(tasks / (RANGE / GRAIN), 1);
+        std::size_t chunks = 0;
+        start = Clock::now();
+        for (std::size_t i = 0; i < loops; ++i) {
+            std::atomic<std::size_t> calls{ 0 };
+            jobs.parallelFor(RANGE, GRAIN, [&calls](std::size_t, std::size_t) { calls++; });
+            chunks += calls.load();
+        }
+        report(name, "parallelFor chunk", nsPer(Clock::now() - start, chunks));
+
+        // Each continuation is submitted by the job before it: pure latency, no parallelism
+        const std::size_t chainLength = std::max<std::size_t>(tasks / 100, 1);
+        start = Clock::now();
+        for (std::size_t i = 0; i < chainLength; ++i) {
+            TaskGroup first;
+            TaskGroup second;
+            jobs.submit(first, [&counter]() { counter++; });
+            jobs.continueWith(first, [&jobs, &second, &counter]() {
+                jobs.submit(second, [&counter]() { counter++; });
+            });
+            jobs.wait(first);
+            jobs.wait();
+        }
+        report(name, "continuation round trip", nsPer(Clock::now() - start, chainLength));
+
+        // Scratch allocation inside jobs
+        start = Clock::now();
+        for (std::size_t i = 0; i < tasks; ++i) {
+            jobs.submit([&jobs]() {
+                float* values = jobs.getScratch().allocateArray<float>(64);
+                values[0] = 1.0f;
+            });
+        }
+        jobs.wait();
+        report(name, "job with scratch alloc", nsPer(Clock::now() - start, tasks));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        std::size_t tasks = 200000;
+        unsigned threads = 0;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--tasks" && i + 1 < argc) {
+                tasks = static_cast<std::size_t>(std::stoull(argv[++i]));
+            } else if (arg == "--threads" && i + 1 < argc) {
+                threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            } else {
+                std::cerr << "Usage: PXRacerJobBench [--tasks <n>] [--threads <n>]" << std::endl;
+                return arg == "--help" || arg == "-h" ? 0 : 1;
+            }
+        }
+
+        {
+            JobSystem jobs(threads);
+            const std::string name = "parallel x" + std::to_string(jobs.getWorkerCount());
+            runSuite(name.c_str(), jobs, tasks);
+        }
+        {
+            JobSystem jobs(1);
+            runSuite("parallel x1", jobs, tasks);
+        }
+        {
+            JobSystem jobs(0, JobSchedule::SingleThreaded);
+            runSuite("single-threaded", jobs, tasks);
+        }
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[BENCH] Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
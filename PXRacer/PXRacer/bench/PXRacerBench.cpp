@@ -0,0 +1,385 @@
+#include "BenchHarness.h"
+#include "Core/BenchmarkBaseline.h"
+#include "Core/FrameArena.h"
+#include "Core/Logger.h"
+#include "Core/Random.h"
+#include "Gameplay/CurveProcessor.h"
+#include "Gameplay/ObstacleSystem.h"
+#include "Gameplay/Player.h"
+#include "Gameplay/Road.h"
+#include "Gameplay/TrackBuilder.h"
+#include "Gameplay/TrackDefinition.h"
+#include "Gameplay/TrafficSystem.h"
+#include "Rendering/RenderCommandBuffer.h"
+#include "UI/GameHUD.h"
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+// Microbenchmarks of the per-tick and per-frame gameplay kernels. Everything
+// runs on fixed seeds so two runs (or two builds) measure the same work.
+namespace {
+    constexpr std::uint64_t BENCH_SEED = 0x5EED;
+    constexpr int ENDLESS_SEGMENTS = 500;                   // what GameplayManager generates
+    constexpr int LONG_ROAD_SEGMENTS = 50000;               // far more than fits in cache
+    const sf::Vector2u RENDER_SIZE(1920, 1080);
+
+    // Track building and road generation are chatty on std::cout
+    class NullStreamBuf : public std::streambuf {
+    protected:
+        int overflow(int c) override { return traits_type::not_eof(c); }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    // Cheap, deterministic sequence of positions along a road
+    struct Walk {
+        float position = 0.0f;
+        float step;
+        float length;
+
+        Walk(float stepSize, float wrapLength) : step(stepSize), length(wrapLength) {}
+        float next() {
+            position += step;
+            if (position >= length) position -= length;
+            return position;
+        }
+    };
+
+    void benchCurves(BenchRunner& runner, const Road& road) {
+        FrameArena& arena = FrameArena::getInstance();
+        std::vector<float> curves(road.getSegmentCount());
+        for (int i = 0; i < road.getSegmentCount(); ++i) curves[i] = road.getCurveAt(i * RoadConfig::SEGMENT_LENGTH);
+
+        runner.run("CurveProcessor::processSegmentCurves", [&](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                const int base = static_cast<int>(i % curves.size());
+                auto data = CurveProcessor::processSegmentCurves(curves, base, RoadConfig::DRAW_DISTANCE, 0.37f, &arena);
+                doNotOptimize(data.cameraOffset);
+                arena.reset();
+            }
+        });
+
+        runner.run("CurveProcessor::catmullRomInterpolate", [&](std::uint64_t iterations) {
+            float t = 0.0f;
+            float sum = 0.0f;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                const std::size_t index = i % (curves.size() - 3);
+                sum += CurveProcessor::catmullRomInterpolate(curves[index], curves[index + 1], curves[index + 2], curves[index + 3], t);
+                t += 0.25f;
+                if (t >= 1.0f) t = 0.0f;
+            }
+            doNotOptimize(sum);
+        });
+    }
+
+    void benchRoad(BenchRunner& runner) {
+        Road road;
+        road.generateWithDifficulty(ENDLESS_SEGMENTS, EndlessDifficultyLevel::Hard);
+
+        // Prime-ish step so the lookups don't fall into a cache-friendly stride
+        Walk walk(37.3f, road.getLength());
+        runner.run("Road::getSegmentIndex", [&](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                doNotOptimize(road.getSegmentIndex(walk.next()));
+            }
+        });
+
+        // Wheels sweep across the road; a hit pothole stays hit until the lap
+        // resets, as in a race, so most calls take the miss path
+        Walk wheels(3.1f, road.getLength());
+        runner.run("Road::checkPotholeCollision", [&](std::uint64_t iterations) {
+            float damage = 0.0f;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                const float x = static_cast<float>(static_cast<int>(i % 9) - 4) * 200.0f;
+                doNotOptimize(road.checkPotholeCollision(x, wheels.next(), damage));
+            }
+            road.resetPotholes();
+        });
+
+        RenderCommandBuffer commands;
+        RoadRenderState hazards;
+        Walk camera(5.0f, road.getLength());
+        runner.run("Road::render (1920x1080)", [&](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                const float cameraZ = camera.next();
+                road.captureRenderState(cameraZ, hazards);
+                commands.begin(RENDER_SIZE);
+                road.render(commands, cameraZ, hazards);
+                commands.sort();
+                FrameArena::getInstance().reset();
+            }
+        });
+    }
+
+    // Same kernels on a road too long for the cache, where the per-segment
+    // footprint decides the cost of whole-road walks and scattered lookups
+    void benchLongRoad(BenchRunner& runner) {
+        Road road;
+        road.generateWithDifficulty(LONG_ROAD_SEGMENTS, EndlessDifficultyLevel::Hard);
+
+        runner.run("Road::update/50k", [&](std::uint64_t iterations) {
+            float z = 0.0f;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                road.update(z, 1.0f / 120.0f);
+                z += 1.0f;
+            }
+        });
+
+        // What GameplayManager does at every lap boundary
+        runner.run("Road lap reset/50k", [&](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                road.resetPotholes();
+                road.regeneratePickupsForDamage(static_cast<float>(i % 3) * 25.0f);
+            }
+        });
+
+        // Four wheels per tick, as in GameplayManager
+        Walk wheels(3.0f, road.getLength());
+        runner.run("Road::checkPotholeCollision/50k", [&](std::uint64_t iterations) {
+            float damage = 0.0f;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                const float z = wheels.next();
+                road.update(z, 1.0f / 120.0f);
+                for (float x : { -300.0f, 300.0f }) {
+                    doNotOptimize(road.checkPotholeCollision(x, z + 40.0f, damage));
+                    doNotOptimize(road.checkPotholeCollision(x, z - 40.0f, damage));
+                }
+            }
+            road.resetPotholes();
+        });
+
+        Walk walk(3737.3f, road.getLength());
+        runner.run("Road::getCurveAt/50k", [&](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                doNotOptimize(road.getCurveAt(walk.next()));
+            }
+        });
+
+        RenderCommandBuffer commands;
+        RoadRenderState hazards;
+        Walk camera(5.0f, road.getLength());
+        runner.run("Road::render/50k (1920x1080)", [&](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                const float cameraZ = camera.next();
+                road.captureRenderState(cameraZ, hazards);
+                commands.begin(RENDER_SIZE);
+                road.render(commands, cameraZ, hazards);
+                commands.sort();
+                FrameArena::getInstance().reset();
+            }
+        });
+    }
+
+    // Endless road laid out ahead of a car at top speed; the cost per tick
+    // should not depend on how far it has driven
+    void benchStreamingRoad(BenchRunner& runner) {
+        Road road;
+        road.generateStreaming(EndlessDifficultySettings::getSettings(EndlessDifficultyLevel::Hard));
+
+        Walk walk(1.0f, road.getLength());
+        runner.run("Road::update (streaming)", [&](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                road.update(walk.next(), 1.0f / 120.0f);
+            }
+        });
+
+        RenderCommandBuffer commands;
+        RoadRenderState hazards;
+        Walk camera(5.0f, road.getLength());
+        runner.run("Road::render (streaming, 1920x1080)", [&](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                const float cameraZ = camera.next();
+                road.update(cameraZ, 1.0f / 120.0f);
+                road.captureRenderState(cameraZ, hazards);
+                commands.begin(RENDER_SIZE);
+                road.render(commands, cameraZ, hazards);
+                commands.sort();
+                FrameArena::getInstance().reset();
+            }
+        });
+    }
+
+    void benchTraffic(BenchRunner& runner, float trackLength) {
+        TrafficSystem traffic;
+        traffic.init(trackLength, RandomStream(BENCH_SEED));
+        constexpr float TICK = 1.0f / 120.0f;
+
+        runner.run("TrafficSystem::update", [&](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                traffic.savePreviousState();
+                traffic.update(TICK, trackLength, 0.0f, 0.0f);
+            }
+        });
+
+        // Without textures (no assets needed) this is the cull, sort and projection of the render list
+        RenderCommandBuffer commands;
+        Walk camera(2.0f, trackLength);
+        runner.run("TrafficSystem::render (render list)", [&](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                commands.begin(RENDER_SIZE);
+                traffic.render(commands, traffic.getCars(), trackLength, camera.next(), 0.0f, 0.5f);
+                FrameArena::getInstance().reset();
+            }
+        });
+    }
+
+    void benchObstacles(BenchRunner& runner) {
+        ObstacleSystem obstacles{ RandomStream(BENCH_SEED) };
+        obstacles.setDifficulty(1.0f);
+
+        // Drive far enough to spawn everything a race keeps ahead of the car,
+        // then park at the start so nothing despawns and only check collisions
+        for (float z = 0.0f; z < ObstacleConfig::SPAWN_AHEAD_DISTANCE; z += 5.0f) {
+            obstacles.update(0.2f, z, 0.0f, 0.0f, PlayerConfig::CAR_WIDTH, PlayerConfig::CAR_HEIGHT);
+        }
+        obstacles.setSpawnEnabled(false);
+
+        const std::string name = "ObstacleSystem collisions (" + std::to_string(obstacles.getActiveCount()) + " obstacles)";
+        runner.run(name, [&](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                const float playerX = static_cast<float>(static_cast<int>(i % 7) - 3) * 150.0f;
+                obstacles.update(1.0f / 120.0f, 0.0f, playerX, 40.0f, PlayerConfig::CAR_WIDTH, PlayerConfig::CAR_HEIGHT);
+            }
+        });
+    }
+
+    void benchTrackBuilder(BenchRunner& runner) {
+        for (const TrackDefinition& track : TrackLibrary::getAllTracks()) {
+            runner.run("TrackBuilder::buildTrack/" + track.id, [&](std::uint64_t iterations) {
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    Road road;
+                    TrackBuilder::buildTrack(road, track);
+                    doNotOptimize(road.getSegmentCount());
+                }
+            });
+        }
+    }
+
+    void benchHud(BenchRunner& runner) {
+        runner.run("GameHUD::formatTime (buffer)", [](std::uint64_t iterations) {
+            char buffer[32];
+            float seconds = 0.0f;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                GameHUD::formatTime(seconds, buffer, sizeof(buffer));
+                doNotOptimize(buffer);
+                seconds += 0.0167f;
+            }
+        });
+
+        runner.run("GameHUD::formatTime (std::string)", [](std::uint64_t iterations) {
+            float seconds = 0.0f;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                std::string text = GameHUD::formatTime(seconds);
+                doNotOptimize(text);
+                seconds += 0.0167f;
+            }
+        });
+    }
+
+    void printUsage() {
+        std::cerr <<
+            "Usage: PXRacerBench [options]\n"
+            "  --filter <text>        Only run benchmarks whose name contains text\n"
+            "  --repetitions <n>      Measured repetitions per benchmark (default: 15)\n"
+            "  --min-time <s>         Target duration of one repetition (default: 0.05)\n"
+            "  --warmup <s>           Warm-up per benchmark (default: 0.1)\n"
+            "  --json <file>          Also write the results as JSON\n"
+            "  --baseline <file>      Compare with an earlier --json file\n"
+            "  --threshold <spec>     metric:percent[:name], fail if slower, e.g. p95:5:Road::render\n"
+            "                         (metrics: mean, median, p95, p99; repeatable)\n"
+            "  --trust-baseline       Enforce thresholds even if the baseline is from another machine\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        BenchOptions options;
+        std::string jsonPath;
+        std::string baselinePath;
+        BaselineComparison baseline;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--filter" && i + 1 < argc) {
+                options.filter = argv[++i];
+            } else if (arg == "--repetitions" && i + 1 < argc) {
+                options.repetitions = std::max(1, std::stoi(argv[++i]));
+            } else if (arg == "--min-time" && i + 1 < argc) {
+                options.repetitionSeconds = std::stod(argv[++i]);
+            } else if (arg == "--warmup" && i + 1 < argc) {
+                options.warmupSeconds = std::stod(argv[++i]);
+            } else if (arg == "--json" && i + 1 < argc) {
+                jsonPath = argv[++i];
+            } else if (arg == "--baseline" && i + 1 < argc) {
+                baselinePath = argv[++i];
+            } else if (arg == "--threshold" && i + 1 < argc) {
+                RegressionThreshold threshold;
+                if (!RegressionThreshold::parse(argv[++i], threshold)) {
+                    std::cerr << "[BENCH] Bad threshold " << argv[i] << std::endl;
+                    printUsage();
+                    return 1;
+                }
+                baseline.addThreshold(threshold);
+            } else if (arg == "--trust-baseline") {
+                baseline.setTrustBaseline(true);
+            } else {
+                printUsage();
+                return arg == "--help" || arg == "-h" ? 0 : 1;
+            }
+        }
+
+        // A missing or broken baseline should fail before minutes of benchmarking
+        std::string error;
+        if (!baselinePath.empty() && !baseline.load(baselinePath, error)) {
+            std::cerr << "[BENCH] Baseline: " << error << std::endl;
+            return 1;
+        }
+
+        NullStreamBuf null;
+        std::streambuf* previous = std::cout.rdbuf(&null);
+        Logger::getInstance().setOutput(nullptr);
+        RandomService::getInstance().setSeed(BENCH_SEED);
+
+        BenchRunner runner(options);
+        {
+            // A real circuit, so the curve kernels see actual curvature
+            Road circuit;
+            TrackBuilder::buildTrack(circuit, *TrackLibrary::getTrackById("monaco_gp"));
+            benchCurves(runner, circuit);
+            benchTraffic(runner, circuit.getLength());
+        }
+        benchRoad(runner);
+        benchLongRoad(runner);
+        benchStreamingRoad(runner);
+        benchObstacles(runner);
+        benchTrackBuilder(runner);
+        benchHud(runner);
+
+        std::cout.rdbuf(previous);
+        if (runner.getResults().empty()) {
+            std::cerr << "[BENCH] No benchmark matches '" << options.filter << "'" << std::endl;
+            return 1;
+        }
+        if (!jsonPath.empty()) {
+            if (!runner.writeJson(jsonPath)) {
+                std::cerr << "[BENCH] Failed to write " << jsonPath << std::endl;
+                return 1;
+            }
+            std::cerr << "[BENCH] Wrote " << jsonPath << std::endl;
+        }
+        if (!baselinePath.empty()) {
+            std::vector<BenchmarkSamples> samples;
+            for (const BenchResult& result : runner.getResults()) {
+                samples.push_back({ result.name, result.samples });
+            }
+            if (baseline.compare(samples, stdout) > 0) return 1;
+        }
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[BENCH] Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
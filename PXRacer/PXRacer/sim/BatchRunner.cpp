@@ -0,0 +1,227 @@
+#include "BatchRunner.h"
+#include "Core/JobSystem.h"
+#include "Core/Random.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    struct BatchJob {
+        std::string group;
+        int sessionIndex;
+        SimConfig config;
+    };
+
+    struct Distribution {
+        size_t count = 0;
+        double mean = 0.0;
+        double stddev = 0.0;
+        double min = 0.0;
+        double p5 = 0.0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double max = 0.0;
+    };
+
+    // Linear interpolation between closest ranks, values must be sorted
+    double percentile(const std::vector<double>& sorted, double p) {
+        if (sorted.empty()) return 0.0;
+        double rank = p * (sorted.size() - 1);
+        size_t lower = static_cast<size_t>(rank);
+        size_t upper = std::min(lower + 1, sorted.size() - 1);
+        double frac = rank - lower;
+        return sorted[lower] + (sorted[upper] - sorted[lower]) * frac;
+    }
+
+    Distribution summarize(std::vector<double> values) {
+        Distribution d;
+        d.count = values.size();
+        if (values.empty()) return d;
+
+        std::sort(values.begin(), values.end());
+
+        double sum = 0.0;
+        for (double v : values) sum += v;
+        d.mean = sum / values.size();
+
+        double variance = 0.0;
+        for (double v : values) variance += (v - d.mean) * (v - d.mean);
+        d.stddev = values.size() > 1 ? std::sqrt(variance / (values.size() - 1)) : 0.0;
+
+        d.min = values.front();
+        d.max = values.back();
+        d.p5 = percentile(values, 0.05);
+        d.p50 = percentile(values, 0.50);
+        d.p95 = percentile(values, 0.95);
+        return d;
+    }
+
+    // Metrics collected per session; lap time only counts sessions that completed a lap
+    const char* const METRIC_NAMES[] = { "lapTime", "damageTaken", "survivalDistance", "survivalTime", "score" };
+    constexpr int METRIC_COUNT = 5;
+
+    bool metricValue(const SimResult& r, int metric, double& out) {
+        switch (metric) {
+            case 0: out = r.bestLapTime; return r.laps > 0 && r.bestLapTime > 0.0f;
+            case 1: out = r.damageTaken; return true;
+            case 2: out = r.distance; return true;
+            case 3: out = r.simulatedSeconds; return true;
+            case 4: out = r.endlessStats.currentScore; return true;
+        }
+        return false;
+    }
+
+    void writeDistributionJson(std::ostream& out, const Distribution& d) {
+        out << "{ \"count\": " << d.count
+            << ", \"mean\": " << d.mean
+            << ", \"stddev\": " << d.stddev
+            << ", \"min\": " << d.min
+            << ", \"p5\": " << d.p5
+            << ", \"p50\": " << d.p50
+            << ", \"p95\": " << d.p95
+            << ", \"max\": " << d.max << " }";
+    }
+}
+
+bool runBatch(const BatchConfig& config, std::string& summaryJson) {
+    // Build the job list: every group gets its own seed sequence so adding a
+    // group or changing the session count never reshuffles the others
+    RandomService seeds(config.base.seed);
+    std::vector<std::string> groups;
+    std::vector<BatchJob> jobs;
+
+    auto addGroup = [&](const std::string& group, const SimConfig& groupConfig) {
+        groups.push_back(group);
+        RandomStream groupSeeds = seeds.stream(group);
+        for (int i = 0; i < config.sessionsPerGroup; ++i) {
+            BatchJob job{ group, i, groupConfig };
+            job.config.seed = groupSeeds.at(static_cast<std::uint64_t>(i));
+            jobs.push_back(std::move(job));
+        }
+    };
+
+    for (EndlessDifficultyLevel difficulty : config.difficulties) {
+        SimConfig groupConfig = config.base;
+        groupConfig.mode = GameMode::Endless;
+        groupConfig.difficulty = difficulty;
+        addGroup(difficultyToString(difficulty), groupConfig);
+    }
+    for (const std::string& trackId : config.trackIds) {
+        SimConfig groupConfig = config.base;
+        groupConfig.mode = GameMode::Campaign;
+        groupConfig.trackId = trackId;
+        addGroup(trackId, groupConfig);
+    }
+
+    std::vector<SimResult> results(jobs.size());
+
+    auto start = std::chrono::steady_clock::now();
+    unsigned threadCount;
+    {
+        JobSystem pool(config.threads);
+        threadCount = pool.getWorkerCount();
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            pool.submit([&jobs, &results, i]() {
+                results[i] = runSimSession(jobs[i].config);
+            });
+        }
+        pool.wait();
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::uint64_t totalTicks = 0;
+    for (const auto& r : results) totalTicks += r.ticks;
+
+    std::cerr << "[SIM] Batch: " << jobs.size() << " sessions on " << threadCount << " threads in "
+              << wallSeconds << " s (" << static_cast<long long>(jobs.size() / std::max(wallSeconds, 1e-9))
+              << " sessions/s, " << static_cast<long long>(totalTicks / std::max(wallSeconds, 1e-9))
+              << " ticks/s)" << std::endl;
+
+    bool ok = true;
+
+    if (!config.csvPath.empty()) {
+        std::ofstream csv(config.csvPath);
+        if (!csv.is_open()) {
+            std::cerr << "[SIM] Could not write " << config.csvPath << std::endl;
+            ok = false;
+        } else {
+            csv << std::setprecision(9);
+            csv << "group,session,seed,ticks,sim_seconds,laps,best_lap_time,damage_taken,distance,score,game_over,race_finished\n";
+            for (size_t i = 0; i < jobs.size(); ++i) {
+                const SimResult& r = results[i];
+                csv << jobs[i].group << ',' << jobs[i].sessionIndex << ',' << jobs[i].config.seed << ','
+                    << r.ticks << ',' << r.simulatedSeconds << ',' << r.laps << ',' << r.bestLapTime << ','
+                    << r.damageTaken << ',' << r.distance << ',' << r.endlessStats.currentScore << ','
+                    << (r.gameOver ? 1 : 0) << ',' << (r.raceFinished ? 1 : 0) << '\n';
+            }
+        }
+    }
+
+    std::ofstream summaryCsv;
+    if (!config.summaryCsvPath.empty()) {
+        summaryCsv.open(config.summaryCsvPath);
+        if (!summaryCsv.is_open()) {
+            std::cerr << "[SIM] Could not write " << config.summaryCsvPath << std::endl;
+            ok = false;
+        } else {
+            summaryCsv << std::setprecision(9);
+            summaryCsv << "group,metric,count,mean,stddev,min,p5,p50,p95,max\n";
+        }
+    }
+
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+    json << "{\n";
+    json << "  \"sessions\": " << jobs.size() << ",\n";
+    json << "  \"threads\": " << threadCount << ",\n";
+    json << "  \"wallSeconds\": " << wallSeconds << ",\n";
+    json << "  \"ticksPerSecond\": " << totalTicks / std::max(wallSeconds, 1e-9) << ",\n";
+    json << "  \"groups\": [\n";
+
+    for (size_t g = 0; g < groups.size(); ++g) {
+        int sessions = 0, gameOvers = 0, finishes = 0;
+        std::vector<double> values[METRIC_COUNT];
+
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            if (jobs[i].group != groups[g]) continue;
+            const SimResult& r = results[i];
+            sessions++;
+            if (r.gameOver) gameOvers++;
+            if (r.raceFinished) finishes++;
+            for (int m = 0; m < METRIC_COUNT; ++m) {
+                double v;
+                if (metricValue(r, m, v)) values[m].push_back(v);
+            }
+        }
+
+        json << "    {\n";
+        json << "      \"group\": \"" << groups[g] << "\",\n";
+        json << "      \"sessions\": " << sessions << ",\n";
+        json << "      \"gameOverRate\": " << (sessions ? static_cast<double>(gameOvers) / sessions : 0.0) << ",\n";
+        json << "      \"finishRate\": " << (sessions ? static_cast<double>(finishes) / sessions : 0.0) << ",\n";
+        json << "      \"metrics\": {\n";
+        for (int m = 0; m < METRIC_COUNT; ++m) {
+            Distribution d = summarize(std::move(values[m]));
+            json << "        \"" << METRIC_NAMES[m] << "\": ";
+            writeDistributionJson(json, d);
+            json << (m + 1 < METRIC_COUNT ? ",\n" : "\n");
+
+            if (summaryCsv.is_open()) {
+                summaryCsv << groups[g] << ',' << METRIC_NAMES[m] << ',' << d.count << ',' << d.mean << ','
+                           << d.stddev << ',' << d.min << ',' << d.p5 << ',' << d.p50 << ',' << d.p95 << ','
+                           << d.max << '\n';
+            }
+        }
+        json << "      }\n";
+        json << "    }" << (g + 1 < groups.size() ? ",\n" : "\n");
+    }
+    json << "  ]\n";
+    json << "}";
+
+    summaryJson = json.str();
+    return ok;
+}
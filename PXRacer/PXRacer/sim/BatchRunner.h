@@ -0,0 +1,20 @@
+#pragma once
+#include "SimSession.h"
+#include <string>
+#include <vector>
+
+// Monte Carlo batch: many independent seeded sessions per group
+// (endless difficulty or campaign track), spread over a work-stealing pool.
+struct BatchConfig {
+    SimConfig base;                                     // shared settings (overrides, time limit...)
+    std::vector<EndlessDifficultyLevel> difficulties;   // endless groups
+    std::vector<std::string> trackIds;                  // campaign groups
+    int sessionsPerGroup = 1000;
+    unsigned threads = 0;                               // 0 = all hardware threads
+    std::string csvPath;                                // one row per session
+    std::string summaryCsvPath;                         // one row per group and metric
+};
+
+// Runs the batch and fills summaryJson with the per-group distributions.
+// Returns false if an output file could not be written.
+bool runBatch(const BatchConfig& config, std::string& summaryJson);
@@ -0,0 +1,75 @@
+#include "InputReplay.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    bool sameInput(const InputSnapshot& a, const InputSnapshot& b) {
+        return a.throttle == b.throttle && a.brake == b.brake &&
+               a.steer == b.steer && a.clutch == b.clutch;
+    }
+}
+
+bool InputReplay::loadFromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[Replay] Could not open " << path << std::endl;
+        return false;
+    }
+
+    m_entries.clear();
+    m_cursor = 0;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream iss(line);
+        Entry entry;
+        int clutch = 0;
+        if (!(iss >> entry.tick >> entry.input.throttle >> entry.input.brake >> entry.input.steer >> clutch)) {
+            std::cerr << "[Replay] Malformed line " << lineNumber << " in " << path << std::endl;
+            return false;
+        }
+        entry.input.clutch = clutch != 0;
+
+        if (!m_entries.empty() && entry.tick < m_entries.back().tick) {
+            std::cerr << "[Replay] Ticks out of order at line " << lineNumber << std::endl;
+            return false;
+        }
+        m_entries.push_back(entry);
+    }
+    return true;
+}
+
+bool InputReplay::saveToFile(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[Replay] Could not write " << path << std::endl;
+        return false;
+    }
+
+    file << "# PXRacer input replay v1: tick throttle brake steer clutch\n";
+    file << std::setprecision(9);  // round-trips floats exactly
+    for (const auto& entry : m_entries) {
+        file << entry.tick << ' ' << entry.input.throttle << ' ' << entry.input.brake << ' '
+             << entry.input.steer << ' ' << (entry.input.clutch ? 1 : 0) << '\n';
+    }
+    return true;
+}
+
+void InputReplay::record(std::uint64_t tick, const InputSnapshot& input) {
+    if (!m_entries.empty() && sameInput(m_entries.back().input, input)) return;
+    m_entries.push_back({ tick, input });
+}
+
+InputSnapshot InputReplay::inputAt(std::uint64_t tick) {
+    while (m_cursor + 1 < m_entries.size() && m_entries[m_cursor + 1].tick <= tick) {
+        m_cursor++;
+    }
+    if (m_entries.empty() || m_entries[m_cursor].tick > tick) return InputSnapshot{};
+    return m_entries[m_cursor].input;
+}
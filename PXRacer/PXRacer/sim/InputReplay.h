@@ -0,0 +1,33 @@
+#pragma once
+#include "Gameplay/Player.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Recorded driver input, one entry per tick where the input changed.
+// Text format (one entry per line, '#' starts a comment):
+//   <tick> <throttle> <brake> <steer> <clutch>
+class InputReplay {
+public:
+    bool loadFromFile(const std::string& path);
+    bool saveToFile(const std::string& path) const;
+
+    // Recording - only stores the tick if the input differs from the last entry
+    void record(std::uint64_t tick, const InputSnapshot& input);
+
+    // Playback - input held at the given tick (ticks must be queried in order)
+    InputSnapshot inputAt(std::uint64_t tick);
+    void rewind() { m_cursor = 0; }
+
+    bool empty() const { return m_entries.empty(); }
+    size_t size() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        std::uint64_t tick;
+        InputSnapshot input;
+    };
+
+    std::vector<Entry> m_entries;
+    size_t m_cursor = 0;
+};
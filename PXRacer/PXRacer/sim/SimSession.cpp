@@ -0,0 +1,216 @@
+#include "SimSession.h"
+#include "InputReplay.h"
+#include "Gameplay/GameplayManager.h"
+#include "Gameplay/Autopilot.h"
+#include "Gameplay/TrackDefinition.h"
+#include "Core/FrameArena.h"
+#include "Rendering/RenderCommandBuffer.h"
+#include "Rendering/RenderBackend.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <iomanip>
+
+namespace {
+    std::string jsonEscape(const std::string& text) {
+        std::string out;
+        out.reserve(text.size());
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+}
+
+const char* difficultyToString(EndlessDifficultyLevel level) {
+    switch (level) {
+        case EndlessDifficultyLevel::Easy:   return "easy";
+        case EndlessDifficultyLevel::Medium: return "medium";
+        case EndlessDifficultyLevel::Hard:   return "hard";
+    }
+    return "medium";
+}
+
+bool difficultyFromString(const std::string& text, EndlessDifficultyLevel& out) {
+    if (text == "easy")   { out = EndlessDifficultyLevel::Easy;   return true; }
+    if (text == "medium") { out = EndlessDifficultyLevel::Medium; return true; }
+    if (text == "hard")   { out = EndlessDifficultyLevel::Hard;   return true; }
+    return false;
+}
+
+SimResult runSimSession(const SimConfig& config, InputReplay* replay, InputReplay* record) {
+    SimResult result;
+
+    std::unique_ptr<GameplayManager> gameplay;
+    if (config.mode == GameMode::Campaign) {
+        const TrackDefinition* track = TrackLibrary::getTrackById(config.trackId);
+        if (!track) return result;
+
+        gameplay = std::make_unique<GameplayManager>(GameMode::Campaign, track, config.seed);
+
+        CampaignTrackData campaignTrack;
+        campaignTrack.trackId = track->id;
+        campaignTrack.name = track->name;
+        campaignTrack.requiredLaps = config.laps > 0 ? config.laps : track->recommendedLaps;
+        gameplay->setCampaignTrack(campaignTrack);
+    } else {
+        gameplay = std::make_unique<GameplayManager>(GameMode::Endless, config.difficulty, config.seed);
+
+        if (config.potholeChance || config.repairPickupChance || config.bonusMultiplier) {
+            EndlessDifficultySettings settings = EndlessDifficultySettings::getSettings(config.difficulty);
+            if (config.potholeChance) settings.potholeChance = *config.potholeChance;
+            if (config.repairPickupChance) settings.repairPickupChance = *config.repairPickupChance;
+            if (config.bonusMultiplier) settings.bonusMultiplier = *config.bonusMultiplier;
+            gameplay->setDifficultySettings(settings);
+        }
+    }
+    result.trackName = gameplay->getTrackName();
+
+    if (replay) replay->rewind();
+
+    const float dt = 1.0f / config.tickRate;
+    const std::uint64_t maxTicks = static_cast<std::uint64_t>(config.maxSimSeconds * config.tickRate);
+
+    const Autopilot bot;
+
+    const bool rendering = config.renderWidth > 0 && config.renderHeight > 0;
+    GameplayRenderState renderState;
+    RenderCommandBuffer commands;
+    NullRenderBackend backend;
+    std::chrono::steady_clock::duration renderTime{};
+
+    auto start = std::chrono::steady_clock::now();
+
+    while (result.ticks < maxTicks) {
+        if (gameplay->isRaceFinished() || gameplay->isGameOver()) break;
+
+        InputSnapshot input;
+        if (config.input == SimInputSource::Replay && replay) {
+            input = replay->inputAt(result.ticks);
+        } else {
+            input = bot.computeInput(gameplay->getRoad(), gameplay->getPlayer());
+        }
+        if (record) record->record(result.ticks, input);
+
+        gameplay->setInput(input);
+        gameplay->update(dt);
+        result.ticks++;
+
+        if (rendering) {
+            auto renderStart = std::chrono::steady_clock::now();
+            gameplay->captureRenderState(renderState);
+            commands.begin(sf::Vector2u(config.renderWidth, config.renderHeight));
+            gameplay->render(commands, renderState);
+            commands.sort();
+            backend.execute(commands);
+            FrameArena::getInstance().reset();
+            renderTime += std::chrono::steady_clock::now() - renderStart;
+
+            const RenderStats& stats = backend.getStats();
+            result.renderFrames++;
+            result.renderCommands += stats.commands;
+            result.renderDrawCalls += stats.drawCalls;
+            result.renderVertices += stats.vertices;
+            result.renderTextureSwitches += stats.textureSwitches;
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    result.renderSeconds = std::chrono::duration<double>(renderTime).count();
+    result.wallSeconds = std::chrono::duration<double>(end - start).count() - result.renderSeconds;
+    result.simulatedSeconds = result.ticks * static_cast<double>(dt);
+
+    result.raceFinished = gameplay->isRaceFinished();
+    result.gameOver = gameplay->isGameOver();
+    result.timedOut = !result.raceFinished && !result.gameOver;
+    result.laps = gameplay->getLapCount();
+    // Campaign keeps its own lap records
+    result.bestLapTime = config.mode == GameMode::Campaign ? gameplay->getCampaignProgress().bestLapTime
+                                                           : gameplay->getBestLapTime();
+    result.lastLapTime = gameplay->getLastLapTime();
+    result.damage = gameplay->getPlayer().getTotalDamage();
+    result.damageTaken = gameplay->getStats().damageTaken;
+    result.distance = gameplay->getRunDistance();
+    result.endlessStats = gameplay->getStats();
+    result.campaignProgress = gameplay->getCampaignProgress();
+    return result;
+}
+
+std::string simResultToJson(const SimConfig& config, const SimResult& result) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\n";
+    out << "  \"mode\": \"" << (config.mode == GameMode::Campaign ? "campaign" : "endless") << "\",\n";
+    if (config.mode == GameMode::Campaign) {
+        out << "  \"track\": \"" << jsonEscape(config.trackId) << "\",\n";
+    } else {
+        out << "  \"difficulty\": \"" << difficultyToString(config.difficulty) << "\",\n";
+    }
+    out << "  \"trackName\": \"" << jsonEscape(result.trackName) << "\",\n";
+    out << "  \"seed\": " << config.seed << ",\n";
+    out << "  \"input\": \"" << (config.input == SimInputSource::Replay ? "replay" : "bot") << "\",\n";
+    out << "  \"tickRate\": " << config.tickRate << ",\n";
+    out << "  \"ticks\": " << result.ticks << ",\n";
+    out << "  \"simulatedSeconds\": " << result.simulatedSeconds << ",\n";
+    out << "  \"wallSeconds\": " << result.wallSeconds << ",\n";
+    out << "  \"ticksPerSecond\": " << result.ticksPerSecond() << ",\n";
+    out << "  \"raceFinished\": " << (result.raceFinished ? "true" : "false") << ",\n";
+    out << "  \"gameOver\": " << (result.gameOver ? "true" : "false") << ",\n";
+    out << "  \"timedOut\": " << (result.timedOut ? "true" : "false") << ",\n";
+    out << "  \"laps\": " << result.laps << ",\n";
+    out << "  \"bestLapTime\": " << result.bestLapTime << ",\n";
+    out << "  \"lastLapTime\": " << result.lastLapTime << ",\n";
+    out << "  \"damage\": " << result.damage << ",\n";
+    out << "  \"damageTaken\": " << result.damageTaken << ",\n";
+    out << "  \"distance\": " << result.distance << ",\n";
+
+    if (result.renderFrames > 0) {
+        const double frames = static_cast<double>(result.renderFrames);
+        out << "  \"render\": {\n";
+        out << "    \"width\": " << config.renderWidth << ",\n";
+        out << "    \"height\": " << config.renderHeight << ",\n";
+        out << "    \"frames\": " << result.renderFrames << ",\n";
+        out << "    \"seconds\": " << result.renderSeconds << ",\n";
+        out << "    \"usPerFrame\": " << result.renderSeconds * 1e6 / frames << ",\n";
+        out << "    \"commandsPerFrame\": " << result.renderCommands / frames << ",\n";
+        out << "    \"drawCallsPerFrame\": " << result.renderDrawCalls / frames << ",\n";
+        out << "    \"verticesPerFrame\": " << result.renderVertices / frames << ",\n";
+        out << "    \"textureSwitchesPerFrame\": " << result.renderTextureSwitches / frames << "\n";
+        out << "  },\n";
+    }
+
+    if (config.mode == GameMode::Campaign) {
+        const CampaignProgress& p = result.campaignProgress;
+        out << "  \"campaignProgress\": {\n";
+        out << "    \"currentLap\": " << p.currentLap << ",\n";
+        out << "    \"totalLaps\": " << p.totalLaps << ",\n";
+        out << "    \"raceTime\": " << p.raceTime << ",\n";
+        out << "    \"bestLapTime\": " << p.bestLapTime << ",\n";
+        out << "    \"topSpeed\": " << p.topSpeed << ",\n";
+        out << "    \"spinoutCount\": " << p.spinoutCount << ",\n";
+        out << "    \"offTrackCount\": " << p.offTrackCount << ",\n";
+        out << "    \"perfectLapsCount\": " << p.perfectLapsCount << "\n";
+        out << "  }\n";
+    } else {
+        const EndlessStats& s = result.endlessStats;
+        out << "  \"endlessStats\": {\n";
+        out << "    \"totalDistance\": " << s.totalDistance << ",\n";
+        out << "    \"currentScore\": " << s.currentScore << ",\n";
+        out << "    \"topSpeed\": " << s.topSpeed << ",\n";
+        out << "    \"averageSpeed\": " << s.averageSpeed << ",\n";
+        out << "    \"timeElapsed\": " << s.timeElapsed << ",\n";
+        out << "    \"checkpointsReached\": " << s.checkpointsReached << ",\n";
+        out << "    \"perfectCornersCount\": " << s.perfectCornersCount << ",\n";
+        out << "    \"lapsWithoutDamage\": " << s.lapsWithoutDamage << ",\n";
+        out << "    \"repairPickupsCollected\": " << s.repairPickupsCollected << ",\n";
+        out << "    \"highscoreKm\": " << s.highscoreKm << ",\n";
+        out << "    \"damageTaken\": " << s.damageTaken << "\n";
+        out << "  }\n";
+    }
+    out << "}";
+    return out.str();
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include "Gameplay/GameModeConfig.h"
+#include "Core/Random.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+
+class InputReplay;
+
+enum class SimInputSource {
+    Bot,
+    Replay
+};
+
+// Everything needed to reproduce one headless session
+struct SimConfig {
+    GameMode mode = GameMode::Endless;
+    EndlessDifficultyLevel difficulty = EndlessDifficultyLevel::Medium;
+    std::string trackId;            // Campaign only
+    int laps = 0;                   // Campaign only, 0 = track's recommended laps
+    std::uint64_t seed = RandomConfig::DEFAULT_SEED;
+    SimInputSource input = SimInputSource::Bot;
+    float tickRate = 60.0f;         // simulated ticks per second of game time
+    float maxSimSeconds = 600.0f;   // stop even if the session is still alive
+
+    // Records a frame of render commands per tick into a NullRenderBackend
+    // (CPU cost of rendering without a GPU); 0 = simulation only
+    unsigned renderWidth = 0;
+    unsigned renderHeight = 0;
+
+    // Endless tuning overrides applied on top of the difficulty's defaults
+    std::optional<float> potholeChance;
+    std::optional<float> repairPickupChance;
+    std::optional<float> bonusMultiplier;
+};
+
+struct SimResult {
+    std::string trackName;
+    std::uint64_t ticks = 0;
+    double simulatedSeconds = 0.0;
+    double wallSeconds = 0.0;
+    bool raceFinished = false;
+    bool gameOver = false;
+    bool timedOut = false;
+
+    int laps = 0;
+    float bestLapTime = 0.0f;
+    float lastLapTime = 0.0f;
+    float damage = 0.0f;            // damage left at the end
+    float damageTaken = 0.0f;       // all damage received (before repairs)
+    double distance = 0.0;          // metres driven over all laps
+
+    EndlessStats endlessStats;
+    CampaignProgress campaignProgress;
+
+    // Only filled when the config asks for rendering
+    std::uint64_t renderFrames = 0;
+    double renderSeconds = 0.0;     // recording + sort + null execute, not part of wallSeconds
+    std::uint64_t renderCommands = 0;
+    std::uint64_t renderDrawCalls = 0;
+    std::uint64_t renderVertices = 0;
+    std::uint64_t renderTextureSwitches = 0;
+
+    double ticksPerSecond() const { return wallSeconds > 0.0 ? ticks / wallSeconds : 0.0; }
+};
+
+// Runs one session as fast as possible without a window or audio.
+// replay is read for SimInputSource::Replay; record (optional) receives every input used.
+SimResult runSimSession(const SimConfig& config, InputReplay* replay = nullptr, InputReplay* record = nullptr);
+
+// JSON summary (one object) of a finished session
+std::string simResultToJson(const SimConfig& config, const SimResult& result);
+
+const char* difficultyToString(EndlessDifficultyLevel level);
+bool difficultyFromString(const std::string& text, EndlessDifficultyLevel& out);
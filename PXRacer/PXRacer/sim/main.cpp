@@ -0,0 +1,217 @@
+#include "SimSession.h"
+#include "InputReplay.h"
+#include "BatchRunner.h"
+#include "Core/AudioManager.h"
+#include "Core/Constants.h"
+#include "Core/Logger.h"
+#include "Gameplay/TrackDefinition.h"
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+
+namespace {
+    // Swallows the gameplay chatter on std::cout so stdout stays pure JSON
+    class NullStreamBuf : public std::streambuf {
+    protected:
+        int overflow(int c) override { return traits_type::not_eof(c); }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    // Redirects std::cout and mutes the Logger for its lifetime
+    class CoutSilencer {
+    public:
+        explicit CoutSilencer(bool enabled) : m_previous(enabled ? std::cout.rdbuf(&m_null) : nullptr) {
+            if (enabled) Logger::getInstance().setOutput(nullptr);
+        }
+        ~CoutSilencer() { restore(); }
+        void restore() {
+            // Verbose runs: get the queued log lines out before the results
+            Logger::getInstance().flush();
+            if (m_previous) {
+                std::cout.rdbuf(m_previous);
+                m_previous = nullptr;
+                Logger::getInstance().setOutput(stdout);
+            }
+        }
+
+    private:
+        NullStreamBuf m_null;
+        std::streambuf* m_previous;
+    };
+
+    void printUsage() {
+        std::cerr <<
+            "Usage: PXRacerSim [options]\n"
+            "  --endless <easy|medium|hard>  Endless session (default: medium, 'all' in batch mode)\n"
+            "  --track <id>                  Campaign session on a TrackLibrary track ('all' in batch mode)\n"
+            "  --laps <n>                    Campaign laps (default: track's recommended laps)\n"
+            "  --seed <n>                    Session seed (default: fixed)\n"
+            "  --bot                         Drive with the autopilot (default)\n"
+            "  --replay <file>               Drive from a recorded input file\n"
+            "  --record <file>               Save the inputs used to a replay file\n"
+            "  --tick-rate <hz>              Simulation rate (default: " << Config::SIM_TICK_RATE << ")\n"
+            "  --max-seconds <s>             Simulated time limit (default: 600)\n"
+            "  --render <WxH>                Also record render commands every tick (null backend, no GPU)\n"
+            "  --verbose                     Keep gameplay log output\n"
+            "  --pothole-chance <p>          Override the difficulty's pothole chance\n"
+            "  --repair-chance <p>           Override the difficulty's repair pickup chance\n"
+            "  --bonus-multiplier <x>        Override the difficulty's score multiplier\n"
+            "Batch mode (Monte Carlo, autopilot only):\n"
+            "  --batch <n>                   Sessions per difficulty/track (default groups: all difficulties)\n"
+            "  --threads <n>                 Worker threads (default: all cores)\n"
+            "  --csv <file>                  Write one row per session\n"
+            "  --summary-csv <file>          Write per-group distributions\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        SimConfig config;
+        config.tickRate = static_cast<float>(Config::SIM_TICK_RATE);
+
+        std::string replayPath;
+        std::string recordPath;
+        bool verbose = false;
+
+        BatchConfig batch;
+        int batchSessions = 0;
+        bool allDifficulties = false;
+        bool allTracks = false;
+        bool modeGiven = false;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error("missing value for " + arg);
+                return argv[++i];
+            };
+
+            if (arg == "--endless") {
+                config.mode = GameMode::Endless;
+                modeGiven = true;
+                std::string value = next();
+                if (value == "all") {
+                    allDifficulties = true;
+                } else if (!difficultyFromString(value, config.difficulty)) {
+                    throw std::runtime_error("unknown difficulty (use easy, medium, hard or all)");
+                }
+            } else if (arg == "--track") {
+                config.mode = GameMode::Campaign;
+                modeGiven = true;
+                config.trackId = next();
+                allTracks = config.trackId == "all";
+            } else if (arg == "--laps") {
+                config.laps = std::stoi(next());
+            } else if (arg == "--seed") {
+                config.seed = std::stoull(next(), nullptr, 0);
+            } else if (arg == "--bot") {
+                config.input = SimInputSource::Bot;
+            } else if (arg == "--replay") {
+                config.input = SimInputSource::Replay;
+                replayPath = next();
+            } else if (arg == "--record") {
+                recordPath = next();
+            } else if (arg == "--tick-rate") {
+                config.tickRate = std::stof(next());
+            } else if (arg == "--max-seconds") {
+                config.maxSimSeconds = std::stof(next());
+            } else if (arg == "--render") {
+                const std::string size = next();
+                const auto split = size.find('x');
+                if (split == std::string::npos) throw std::runtime_error("--render expects WIDTHxHEIGHT");
+                config.renderWidth = static_cast<unsigned>(std::stoul(size.substr(0, split)));
+                config.renderHeight = static_cast<unsigned>(std::stoul(size.substr(split + 1)));
+            } else if (arg == "--pothole-chance") {
+                config.potholeChance = std::stof(next());
+            } else if (arg == "--repair-chance") {
+                config.repairPickupChance = std::stof(next());
+            } else if (arg == "--bonus-multiplier") {
+                config.bonusMultiplier = std::stof(next());
+            } else if (arg == "--batch") {
+                batchSessions = std::stoi(next());
+            } else if (arg == "--threads") {
+                batch.threads = static_cast<unsigned>(std::stoul(next()));
+            } else if (arg == "--csv") {
+                batch.csvPath = next();
+            } else if (arg == "--summary-csv") {
+                batch.summaryCsvPath = next();
+            } else if (arg == "--verbose") {
+                verbose = true;
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else {
+                throw std::runtime_error("unknown option " + arg);
+            }
+        }
+
+        if (config.tickRate <= 0.0f) throw std::runtime_error("--tick-rate must be positive");
+
+        CoutSilencer silencer(!verbose);
+
+        // Build the track cache up front; it is not safe to initialize from worker threads
+        TrackLibrary::getAllTracks();
+        // No window, no audio device - and AudioManager is not thread-safe for batch workers
+        AudioManager::getInstance().setEnabled(false);
+
+        if (batchSessions > 0) {
+            if (config.input == SimInputSource::Replay) throw std::runtime_error("--batch only supports the scripted bot");
+
+            batch.base = config;
+            batch.sessionsPerGroup = batchSessions;
+            if (config.mode == GameMode::Campaign) {
+                if (allTracks) {
+                    for (const auto& track : TrackLibrary::getAllTracks()) batch.trackIds.push_back(track.id);
+                } else if (TrackLibrary::getTrackById(config.trackId)) {
+                    batch.trackIds.push_back(config.trackId);
+                } else {
+                    throw std::runtime_error("unknown track " + config.trackId);
+                }
+            } else if (allDifficulties || !modeGiven) {
+                batch.difficulties = { EndlessDifficultyLevel::Easy, EndlessDifficultyLevel::Medium, EndlessDifficultyLevel::Hard };
+            } else {
+                batch.difficulties = { config.difficulty };
+            }
+
+            std::string summary;
+            bool ok = runBatch(batch, summary);
+            silencer.restore();
+            std::cout << summary << std::endl;
+            return ok ? 0 : 1;
+        }
+
+        if (allDifficulties || allTracks) throw std::runtime_error("'all' is only valid with --batch");
+
+        if (config.mode == GameMode::Campaign && !TrackLibrary::getTrackById(config.trackId)) {
+            std::cerr << "[SIM] Unknown track '" << config.trackId << "'. Available:";
+            for (const auto& track : TrackLibrary::getAllTracks()) std::cerr << ' ' << track.id;
+            std::cerr << std::endl;
+            return 1;
+        }
+
+        InputReplay replay;
+        if (config.input == SimInputSource::Replay && !replay.loadFromFile(replayPath)) {
+            return 1;
+        }
+        InputReplay recording;
+
+        SimResult result = runSimSession(config, &replay, recordPath.empty() ? nullptr : &recording);
+        silencer.restore();
+
+        if (!recordPath.empty() && !recording.saveToFile(recordPath)) {
+            return 1;
+        }
+
+        std::cerr << "[SIM] " << result.ticks << " ticks in " << result.wallSeconds << " s ("
+                  << static_cast<long long>(result.ticksPerSecond()) << " ticks/s)" << std::endl;
+        std::cout << simResultToJson(config, result) << std::endl;
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[SIM] Error: " << e.what() << std::endl;
+        printUsage();
+        return 1;
+    }
+}
@@ -0,0 +1,106 @@
+#include "AllocationCounter.h"
+#include "AllocationTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    thread_local std::uint64_t t_allocations = 0;
+    std::atomic<std::uint64_t> g_allocations{ 0 };
+}
+
+std::uint64_t AllocationCounter::getThreadAllocations() {
+    return t_allocations;
+}
+
+std::uint64_t AllocationCounter::getTotalAllocations() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+#if PXRACER_COUNT_ALLOCATIONS
+
+namespace {
+    void countAllocation(std::size_t size) {
+        ++t_allocations;
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        AllocationTracker::getInstance().recordAllocation(size);
+    }
+
+    void* allocate(std::size_t size) {
+        countAllocation(size);
+        if (size == 0) size = 1;
+        return std::malloc(size);
+    }
+
+    void* allocateAligned(std::size_t size, std::size_t alignment) {
+        countAllocation(size);
+        if (size == 0) size = 1;
+#if defined(_MSC_VER)
+        return _aligned_malloc(size, alignment);
+#else
+        // std::pmr asks for any alignment (4 for floats); posix_memalign rejects less than a pointer
+        void* ptr = nullptr;
+        return posix_memalign(&ptr, std::max(alignment, sizeof(void*)), size) == 0 ? ptr : nullptr;
+#endif
+    }
+
+    void freeAligned(void* ptr) {
+#if defined(_MSC_VER)
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+}
+
+void* operator new(std::size_t size) {
+    if (void* ptr = allocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* ptr = allocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = allocateAligned(size, static_cast<std::size_t>(alignment))) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* ptr = allocateAligned(size, static_cast<std::size_t>(alignment))) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { freeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { freeAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { freeAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { freeAligned(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { freeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { freeAligned(ptr); }
+
+#endif
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+
+// Debug builds replace the global operator new/delete to count heap
+// allocations per thread (Core/AllocationCounter.cpp). Release builds keep the
+// standard ones and every query below returns 0. Core/AllocationTracker
+// builds the per-scope reports on top of the same hooks.
+#ifndef PXRACER_COUNT_ALLOCATIONS
+#ifdef NDEBUG
+#define PXRACER_COUNT_ALLOCATIONS 0
+#else
+#define PXRACER_COUNT_ALLOCATIONS 1
+#endif
+#endif
+
+namespace AllocationCounter {
+    constexpr bool ENABLED = PXRACER_COUNT_ALLOCATIONS != 0;
+
+    // operator new calls made by the calling thread since it started
+    std::uint64_t getThreadAllocations();
+    // operator new calls made by every thread
+    std::uint64_t getTotalAllocations();
+}
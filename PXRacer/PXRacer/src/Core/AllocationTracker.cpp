@@ -0,0 +1,129 @@
+#include "AllocationTracker.h"
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+namespace {
+    constexpr const char* UNSCOPED = "(unscoped)";
+
+    // Slot index per open scope; plain zero-initialised TLS so the allocation
+    // hook can read it without running any thread_local constructor
+    thread_local std::size_t t_scopeSlots[AllocationTracker::MAX_SCOPE_DEPTH];
+    thread_local int t_scopeDepth = 0;
+}
+
+AllocationTracker& AllocationTracker::getInstance() {
+    static AllocationTracker instance;
+    return instance;
+}
+
+AllocationTracker::AllocationTracker() {
+    // Slot 0 catches allocations outside any scope and scopes that don't fit
+    m_slots[0].name.store(UNSCOPED, std::memory_order_relaxed);
+    m_slots[0].stats.name = UNSCOPED;
+    m_totals.name = "(frame)";
+}
+
+std::size_t AllocationTracker::findSlot(const char* name) {
+    const std::size_t hash = (reinterpret_cast<std::uintptr_t>(name) >> 3) * 0x9E3779B97F4A7C15ull >> 32;
+    for (std::size_t probe = 0; probe < MAX_SCOPES - 1; ++probe) {
+        Slot& slot = m_slots[1 + (hash + probe) % (MAX_SCOPES - 1)];
+        const char* current = slot.name.load(std::memory_order_acquire);
+        if (current == name) return &slot - m_slots;
+        if (current == nullptr) {
+            const char* expected = nullptr;
+            if (slot.name.compare_exchange_strong(expected, name, std::memory_order_acq_rel) || expected == name) {
+                return &slot - m_slots;
+            }
+        }
+    }
+    return 0;
+}
+
+void AllocationTracker::pushScope(const char* name) {
+    if (t_scopeDepth < MAX_SCOPE_DEPTH) {
+        t_scopeSlots[t_scopeDepth] = getInstance().findSlot(name);
+    }
+    ++t_scopeDepth;
+}
+
+void AllocationTracker::popScope() {
+    if (t_scopeDepth > 0) --t_scopeDepth;
+}
+
+void AllocationTracker::recordAllocation(std::size_t bytes) {
+    if (!isEnabled()) return;
+
+    const int depth = std::min(t_scopeDepth, MAX_SCOPE_DEPTH);
+    Slot& slot = m_slots[depth > 0 ? t_scopeSlots[depth - 1] : 0];
+    slot.count.fetch_add(1, std::memory_order_relaxed);
+    slot.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocationTracker::endFrame() {
+    if (!isEnabled()) return;
+
+    AllocationScopeStats frame;
+    for (Slot& slot : m_slots) {
+        const char* name = slot.name.load(std::memory_order_acquire);
+        if (!name) continue;
+
+        AllocationScopeStats& stats = slot.stats;
+        stats.name = name;
+        stats.frameCount = slot.count.exchange(0, std::memory_order_relaxed);
+        stats.frameBytes = slot.bytes.exchange(0, std::memory_order_relaxed);
+        stats.peakCount = std::max(stats.peakCount, stats.frameCount);
+        stats.peakBytes = std::max(stats.peakBytes, stats.frameBytes);
+        stats.totalCount += stats.frameCount;
+        stats.totalBytes += stats.frameBytes;
+
+        frame.frameCount += stats.frameCount;
+        frame.frameBytes += stats.frameBytes;
+    }
+
+    m_totals.frameCount = frame.frameCount;
+    m_totals.frameBytes = frame.frameBytes;
+    m_totals.peakCount = std::max(m_totals.peakCount, frame.frameCount);
+    m_totals.peakBytes = std::max(m_totals.peakBytes, frame.frameBytes);
+    m_totals.totalCount += frame.frameCount;
+    m_totals.totalBytes += frame.frameBytes;
+    m_frames++;
+}
+
+void AllocationTracker::getScopes(std::vector<AllocationScopeStats>& out) const {
+    out.clear();
+    for (const Slot& slot : m_slots) {
+        if (slot.stats.name) out.push_back(slot.stats);
+    }
+    std::sort(out.begin(), out.end(), [](const AllocationScopeStats& a, const AllocationScopeStats& b) {
+        if (a.frameCount != b.frameCount) return a.frameCount > b.frameCount;
+        return a.totalCount > b.totalCount;
+    });
+}
+
+void AllocationTracker::dump(std::ostream& out) const {
+    std::vector<AllocationScopeStats> scopes;
+    getScopes(scopes);
+    std::sort(scopes.begin(), scopes.end(), [](const AllocationScopeStats& a, const AllocationScopeStats& b) {
+        return a.totalCount > b.totalCount;
+    });
+
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    const double frames = static_cast<double>(std::max<std::uint64_t>(m_frames, 1));
+    out << "[ALLOC] " << m_totals.totalCount << " allocations (" << m_totals.totalBytes << " bytes) over "
+        << m_frames << " frames, peak " << m_totals.peakCount << " / " << m_totals.peakBytes << " bytes per frame\n";
+    out << "[ALLOC] " << std::left << std::setw(32) << "scope" << std::right
+        << std::setw(12) << "allocs" << std::setw(14) << "bytes"
+        << std::setw(10) << "/frame" << std::setw(10) << "peak" << std::setw(12) << "peak bytes" << "\n";
+    for (const AllocationScopeStats& scope : scopes) {
+        if (scope.totalCount == 0) continue;
+        out << "[ALLOC] " << std::left << std::setw(32) << scope.name << std::right
+            << std::setw(12) << scope.totalCount << std::setw(14) << scope.totalBytes
+            << std::setw(10) << std::fixed << std::setprecision(2) << scope.totalCount / frames
+            << std::setw(10) << scope.peakCount << std::setw(12) << scope.peakBytes << "\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+    out.flush();
+}
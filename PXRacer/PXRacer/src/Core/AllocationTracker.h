@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+#include "Core/AllocationCounter.h"
+
+struct AllocationScopeStats {
+    const char* name = nullptr;
+    std::uint64_t frameCount = 0;   // last finished frame
+    std::uint64_t frameBytes = 0;
+    std::uint64_t peakCount = 0;    // worst frame so far
+    std::uint64_t peakBytes = 0;
+    std::uint64_t totalCount = 0;
+    std::uint64_t totalBytes = 0;
+};
+
+// Opt-in (--track-allocations) attribution of heap allocations. The operator
+// new hook of Core/AllocationCounter reports every allocation here and it is
+// charged to the innermost ALLOCATION_SCOPE or PROFILE_SCOPE (Core/Profiler)
+// of the allocating thread, or to "(unscoped)". Game closes a frame after each render; the per-scope counters
+// of that frame become the "frame" columns and feed the peaks and totals.
+//
+// Only works where the hooks are compiled in (debug builds, or the
+// PXRACER_ALLOCATION_HOOKS CMake option).
+class AllocationTracker {
+public:
+    static constexpr std::size_t MAX_SCOPES = 128;
+    static constexpr int MAX_SCOPE_DEPTH = 32;
+
+    static AllocationTracker& getInstance();
+
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // Scope names must be string literals (scopes are keyed by pointer)
+    static void pushScope(const char* name);
+    static void popScope();
+
+    // From the operator new hook; never allocates
+    void recordAllocation(std::size_t bytes);
+
+    // Main thread, once per frame
+    void endFrame();
+
+    // Scopes seen so far, most allocations in the last frame first
+    void getScopes(std::vector<AllocationScopeStats>& out) const;
+    const AllocationScopeStats& getFrameTotals() const { return m_totals; }
+    std::uint64_t getFrameCount() const { return m_frames; }
+
+    // Per-scope totals, peaks and averages, worst offenders first
+    void dump(std::ostream& out) const;
+
+private:
+    AllocationTracker();
+
+    struct Slot {
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<std::uint64_t> count{ 0 };   // current frame
+        std::atomic<std::uint64_t> bytes{ 0 };
+        AllocationScopeStats stats;              // main thread only
+    };
+
+    std::size_t findSlot(const char* name);
+
+    std::atomic<bool> m_enabled{ false };
+    Slot m_slots[MAX_SCOPES];
+    AllocationScopeStats m_totals;
+    std::uint64_t m_frames = 0;
+};
+
+// Charges the allocations made until the end of the enclosing block to name
+class AllocationScope {
+public:
+    explicit AllocationScope(const char* name) { AllocationTracker::pushScope(name); }
+    ~AllocationScope() { AllocationTracker::popScope(); }
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+};
+
+#if PXRACER_COUNT_ALLOCATIONS
+#define PXRACER_ALLOCATION_SCOPE_JOIN2(a, b) a##b
+#define PXRACER_ALLOCATION_SCOPE_JOIN(a, b) PXRACER_ALLOCATION_SCOPE_JOIN2(a, b)
+#define ALLOCATION_SCOPE(name) AllocationScope PXRACER_ALLOCATION_SCOPE_JOIN(allocationScope_, __LINE__)(name)
+#else
+#define ALLOCATION_SCOPE(name) ((void)0)
+#endif
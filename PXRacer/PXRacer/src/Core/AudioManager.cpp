@@ -1,5 +1,6 @@
 #include "AudioManager.h"
 #include "SettingsManager.h"
+#include "Profiler.h"
 #include <iostream>
 #include <algorithm>
 
@@ -18,6 +19,12 @@ AudioManager::AudioManager()
     , m_sfxMuted(false)
 {
     std::cout << "[AudioManager] Initialized" << std::endl;
+}
+
+// Registries are filled the first time a track or effect is requested
+void AudioManager::registerAssets() {
+    if (m_assetsRegistered) return;
+    m_assetsRegistered = true;
 
     // Register music tracks for different states
     // Menu items
@@ -44,6 +51,15 @@ AudioManager::AudioManager()
 
 // Play music track
 void AudioManager::playMusic(const std::string& trackId, bool loop) {
+    if (!m_enabled) return;
+
+    if (m_playbackDeferred) {
+        m_deferredTrackId = trackId;
+        m_deferredLoop = loop;
+        return;
+    }
+    registerAssets();
+
     // If already playing this track, do nothing
     if (m_currentTrackId == trackId && m_currentMusic && m_currentMusic->getStatus() == sf::SoundSource::Status::Playing) {
         return;
@@ -78,6 +94,7 @@ void AudioManager::playMusic(const std::string& trackId, bool loop) {
 
 // Stop music
 void AudioManager::stopMusic() {
+    m_deferredTrackId.clear();
     if (m_currentMusic && m_currentMusic->getStatus() != sf::SoundSource::Status::Stopped) {
         m_currentMusic->stop();
         std::cout << "[AudioManager] Music stopped" << std::endl;
@@ -160,6 +177,10 @@ void AudioManager::updateVolumesFromSettings() {
 }
 
 void AudioManager::playSfx(const std::string& sfxId) {
+    PROFILE_SCOPE("AudioManager::playSfx");
+    if (!m_enabled || m_playbackDeferred) return;
+    registerAssets();
+
     // Look up the SFX ID in the registry
     auto it = m_sfxRegistry.find(sfxId);
     if (it == m_sfxRegistry.end()) {
@@ -191,8 +212,26 @@ void AudioManager::playSfx(const std::string& sfxId) {
     );
 }
 
+void AudioManager::setEnabled(bool enabled) {
+    if (!enabled) {
+        stopMusic();
+        m_activeSfx.clear();
+    }
+    m_enabled = enabled;
+}
+
+void AudioManager::setPlaybackDeferred(bool deferred) {
+    m_playbackDeferred = deferred;
+    if (deferred || m_deferredTrackId.empty()) return;
+
+    const std::string trackId = m_deferredTrackId;
+    m_deferredTrackId.clear();
+    playMusic(trackId, m_deferredLoop);
+}
+
 // Helper to load music file
 bool AudioManager::loadMusicFile(const std::string& filepath) {
+    PROFILE_SCOPE("AudioManager::loadMusicFile");
     m_currentMusic = std::make_unique<sf::Music>();
 
     if (!m_currentMusic->openFromFile(filepath)) {
@@ -41,10 +41,27 @@ public:
     // Sound effect support (future)
     void playSfx(const std::string& sfxId);
 
+    // Headless runs switch audio off entirely (no device, no file access)
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    // Startup holds music back until the first frame is on screen: while
+    // deferred playMusic only remembers the last request, and releasing the
+    // deferral plays it (opening the audio device and the file then)
+    void setPlaybackDeferred(bool deferred);
+
 private:
     // Private constructor
     AudioManager();
 
+    // Fills the music and SFX registries on first use
+    void registerAssets();
+    bool m_assetsRegistered = false;
+
+    bool m_playbackDeferred = false;
+    std::string m_deferredTrackId;
+    bool m_deferredLoop = true;
+
     // Music tracks registry
     std::unordered_map<std::string, std::string> m_musicTracks;
 
@@ -58,6 +75,7 @@ private:
     float m_masterVolume;
     bool m_musicMuted;
     bool m_sfxMuted;
+    bool m_enabled = true;
 
     // Helper to load music file
     bool loadMusicFile(const std::string& filepath);
@@ -0,0 +1,437 @@
+#include "BenchmarkBaseline.h"
+#include "Core/Profiler.h"
+#include "Core/Random.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+namespace {
+    // Fixed, so the same two files always give the same intervals
+    constexpr std::uint64_t BOOTSTRAP_SEED = 0xB007;
+
+    // Just enough JSON for the files the benchmarks write
+    struct JsonValue {
+        enum class Type { Null, Bool, Number, String, Array, Object };
+        Type type = Type::Null;
+        bool boolean = false;
+        double number = 0.0;
+        std::string text;
+        std::vector<JsonValue> items;               // array elements or object values
+        std::vector<std::string> keys;              // object only, parallel to items
+
+        const JsonValue* find(const std::string& key) const {
+            if (type != Type::Object) return nullptr;
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                if (keys[i] == key) return &items[i];
+            }
+            return nullptr;
+        }
+        std::string getString(const std::string& key) const {
+            const JsonValue* value = find(key);
+            return value && value->type == Type::String ? value->text : std::string();
+        }
+    };
+
+    class JsonReader {
+    public:
+        explicit JsonReader(const std::string& text) : m_text(text) {}
+
+        bool parse(JsonValue& out) {
+            if (!parseValue(out)) return false;
+            skipSpace();
+            return m_pos == m_text.size();
+        }
+
+    private:
+        void skipSpace() {
+            while (m_pos < m_text.size() && std::strchr(" \t\r\n", m_text[m_pos])) m_pos++;
+        }
+
+        bool consume(char c) {
+            skipSpace();
+            if (m_pos < m_text.size() && m_text[m_pos] == c) {
+                m_pos++;
+                return true;
+            }
+            return false;
+        }
+
+        bool parseString(std::string& out) {
+            if (!consume('"')) return false;
+            while (m_pos < m_text.size()) {
+                char c = m_text[m_pos++];
+                if (c == '"') return true;
+                if (c == '\\' && m_pos < m_text.size()) {
+                    c = m_text[m_pos++];
+                    if (c == 'n') c = '\n';
+                    else if (c == 't') c = '\t';
+                    else if (c == 'u') { m_pos += 4; c = '?'; }     // never written by the benchmarks
+                }
+                out += c;
+            }
+            return false;
+        }
+
+        bool parseValue(JsonValue& out) {
+            skipSpace();
+            if (m_pos >= m_text.size()) return false;
+            const char c = m_text[m_pos];
+            if (c == '{') {
+                m_pos++;
+                out.type = JsonValue::Type::Object;
+                if (consume('}')) return true;
+                do {
+                    out.keys.emplace_back();
+                    out.items.emplace_back();
+                    if (!parseString(out.keys.back()) || !consume(':') || !parseValue(out.items.back())) return false;
+                } while (consume(','));
+                return consume('}');
+            }
+            if (c == '[') {
+                m_pos++;
+                out.type = JsonValue::Type::Array;
+                if (consume(']')) return true;
+                do {
+                    out.items.emplace_back();
+                    if (!parseValue(out.items.back())) return false;
+                } while (consume(','));
+                return consume(']');
+            }
+            if (c == '"') {
+                out.type = JsonValue::Type::String;
+                return parseString(out.text);
+            }
+            for (const char* word : { "true", "false", "null" }) {
+                if (m_text.compare(m_pos, std::strlen(word), word) == 0) {
+                    m_pos += std::strlen(word);
+                    out.type = word[0] == 'n' ? JsonValue::Type::Null : JsonValue::Type::Bool;
+                    out.boolean = word[0] == 't';
+                    return true;
+                }
+            }
+            char* end = nullptr;
+            out.number = std::strtod(m_text.c_str() + m_pos, &end);
+            if (end == m_text.c_str() + m_pos) return false;
+            out.type = JsonValue::Type::Number;
+            m_pos = static_cast<std::size_t>(end - m_text.c_str());
+            return true;
+        }
+
+        const std::string& m_text;
+        std::size_t m_pos = 0;
+    };
+
+    std::string trim(const std::string& text) {
+        const std::size_t first = text.find_first_not_of(" \t");
+        if (first == std::string::npos) return std::string();
+        return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+    }
+
+    std::string cpuName() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        // Brand string, CPUID leaves 0x80000002..4
+        unsigned int regs[12] = {};
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0x80000000);
+        if (static_cast<unsigned int>(info[0]) >= 0x80000004) {
+            for (int i = 0; i < 3; ++i) __cpuid(reinterpret_cast<int*>(regs + i * 4), 0x80000002 + i);
+        }
+#else
+        if (__get_cpuid_max(0x80000000, nullptr) >= 0x80000004) {
+            for (unsigned int i = 0; i < 3; ++i) {
+                __get_cpuid(0x80000002 + i, &regs[i * 4], &regs[i * 4 + 1], &regs[i * 4 + 2], &regs[i * 4 + 3]);
+            }
+        }
+#endif
+        char brand[sizeof(regs) + 1] = {};
+        std::memcpy(brand, regs, sizeof(regs));
+        if (brand[0]) return trim(brand);
+#elif defined(__APPLE__)
+        char brand[256] = {};
+        std::size_t size = sizeof(brand);
+        if (sysctlbyname("machdep.cpu.brand_string", brand, &size, nullptr, 0) == 0) return trim(brand);
+#endif
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        std::string line;
+        while (std::getline(cpuinfo, line)) {
+            if (line.compare(0, 10, "model name") == 0 || line.compare(0, 9, "Processor") == 0) {
+                const std::size_t colon = line.find(':');
+                if (colon != std::string::npos) return trim(line.substr(colon + 1));
+            }
+        }
+        return "unknown";
+    }
+
+    const char* metricName(BenchmarkMetric metric) {
+        switch (metric) {
+            case BenchmarkMetric::Mean:   return "mean";
+            case BenchmarkMetric::Median: return "median";
+            case BenchmarkMetric::P95:    return "p95";
+            case BenchmarkMetric::P99:    return "p99";
+        }
+        return "median";
+    }
+
+    // samples is reordered
+    double computeMetric(std::vector<double>& samples, BenchmarkMetric metric) {
+        if (samples.empty()) return 0.0;
+        if (metric == BenchmarkMetric::Mean) {
+            double sum = 0.0;
+            for (double sample : samples) sum += sample;
+            return sum / samples.size();
+        }
+        const double p = metric == BenchmarkMetric::Median ? 0.5 : metric == BenchmarkMetric::P95 ? 0.95 : 0.99;
+        const std::size_t index = static_cast<std::size_t>(std::lround(p * (samples.size() - 1)));
+        std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+        return samples[index];
+    }
+
+    struct Delta {
+        double baseline = 0.0;
+        double current = 0.0;
+        double delta = 0.0;     // current / baseline - 1
+        double low = 0.0;
+        double high = 0.0;
+        bool hasInterval = false;
+    };
+
+    // Percentile bootstrap: resample both sides, take the central CONFIDENCE of the ratios
+    Delta compareMetric(const std::vector<double>& baseline, const std::vector<double>& current, BenchmarkMetric metric) {
+        Delta result;
+        std::vector<double> scratch = baseline;
+        result.baseline = computeMetric(scratch, metric);
+        scratch = current;
+        result.current = computeMetric(scratch, metric);
+        if (result.baseline <= 0.0) return result;
+        result.delta = result.current / result.baseline - 1.0;
+        if (baseline.size() < 2 || current.size() < 2) return result;
+
+        RandomStream random(BOOTSTRAP_SEED);
+        std::vector<double> ratios;
+        ratios.reserve(BaselineComparison::BOOTSTRAP_RESAMPLES);
+        std::vector<double> resampledBaseline(baseline.size());
+        std::vector<double> resampledCurrent(current.size());
+        for (int i = 0; i < BaselineComparison::BOOTSTRAP_RESAMPLES; ++i) {
+            for (double& sample : resampledBaseline) sample = baseline[random() % baseline.size()];
+            for (double& sample : resampledCurrent) sample = current[random() % current.size()];
+            const double base = computeMetric(resampledBaseline, metric);
+            if (base > 0.0) ratios.push_back(computeMetric(resampledCurrent, metric) / base - 1.0);
+        }
+        if (ratios.empty()) return result;
+        std::sort(ratios.begin(), ratios.end());
+        const double tail = (1.0 - BaselineComparison::CONFIDENCE) / 2.0;
+        result.low = ratios[static_cast<std::size_t>(tail * (ratios.size() - 1))];
+        result.high = ratios[static_cast<std::size_t>((1.0 - tail) * (ratios.size() - 1))];
+        result.hasInterval = true;
+        return result;
+    }
+}
+
+MachineFingerprint MachineFingerprint::current() {
+    MachineFingerprint machine;
+    machine.cpu = cpuName();
+    machine.cores = std::thread::hardware_concurrency();
+#if defined(_WIN32)
+    machine.os = "windows";
+#elif defined(__APPLE__)
+    machine.os = "macos";
+#elif defined(__linux__)
+    machine.os = "linux";
+#else
+    machine.os = "unknown";
+#endif
+#if defined(__clang__)
+    machine.compiler = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    machine.compiler = std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+    machine.compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+    machine.compiler = "unknown";
+#endif
+    machine.compiler = trim(machine.compiler);
+#ifdef NDEBUG
+    machine.build = "release";
+#else
+    machine.build = "debug";
+#endif
+    machine.profiler = PXRACER_PROFILING != 0;
+    return machine;
+}
+
+std::string MachineFingerprint::toJson() const {
+    auto quoted = [](const std::string& text) {
+        std::string out = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out + "\"";
+    };
+    std::ostringstream out;
+    out << "{\"cpu\": " << quoted(cpu) << ", \"cores\": " << cores << ", \"os\": " << quoted(os)
+        << ", \"compiler\": " << quoted(compiler) << ", \"build\": " << quoted(build)
+        << ", \"profiler\": " << (profiler ? "true" : "false") << "}";
+    return out.str();
+}
+
+std::vector<std::string> MachineFingerprint::differences(const MachineFingerprint& other) const {
+    std::vector<std::string> out;
+    auto check = [&](const char* field, const std::string& mine, const std::string& theirs) {
+        if (mine != theirs) out.push_back(std::string(field) + ": " + theirs + " vs " + mine);
+    };
+    check("cpu", cpu, other.cpu);
+    check("cores", std::to_string(cores), std::to_string(other.cores));
+    check("os", os, other.os);
+    check("compiler", compiler, other.compiler);
+    check("build", build, other.build);
+    check("profiler", profiler ? "on" : "off", other.profiler ? "on" : "off");
+    return out;
+}
+
+bool RegressionThreshold::parse(const std::string& text, RegressionThreshold& out) {
+    const std::size_t first = text.find(':');
+    if (first == std::string::npos) return false;
+    const std::size_t second = text.find(':', first + 1);
+
+    const std::string metric = text.substr(0, first);
+    if (metric == "mean") out.metric = BenchmarkMetric::Mean;
+    else if (metric == "median" || metric == "p50") out.metric = BenchmarkMetric::Median;
+    else if (metric == "p95") out.metric = BenchmarkMetric::P95;
+    else if (metric == "p99") out.metric = BenchmarkMetric::P99;
+    else return false;
+
+    const std::string percent = text.substr(first + 1, second == std::string::npos ? std::string::npos : second - first - 1);
+    char* end = nullptr;
+    out.percent = std::strtod(percent.c_str(), &end);
+    if (percent.empty() || *end != '\0' || out.percent < 0.0) return false;
+    out.filter = second == std::string::npos ? std::string() : text.substr(second + 1);
+    return true;
+}
+
+bool BaselineComparison::load(const std::string& path, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+
+    JsonValue root;
+    if (!JsonReader(text).parse(root) || root.type != JsonValue::Type::Object) {
+        error = path + " is not valid JSON";
+        return false;
+    }
+    const JsonValue* benchmarks = root.find("benchmarks");
+    if (!benchmarks || benchmarks->type != JsonValue::Type::Array) {
+        error = path + " has no \"benchmarks\" array";
+        return false;
+    }
+
+    m_path = path;
+    m_baseline.clear();
+    for (const JsonValue& entry : benchmarks->items) {
+        BenchmarkSamples samples;
+        samples.name = entry.getString("name");
+        if (const JsonValue* values = entry.find("samples")) {
+            for (const JsonValue& value : values->items) samples.samples.push_back(value.number);
+        }
+        if (!samples.name.empty()) m_baseline.push_back(std::move(samples));
+    }
+
+    m_hasMachine = false;
+    if (const JsonValue* machine = root.find("machine")) {
+        m_hasMachine = true;
+        m_machine.cpu = machine->getString("cpu");
+        m_machine.os = machine->getString("os");
+        m_machine.compiler = machine->getString("compiler");
+        m_machine.build = machine->getString("build");
+        const JsonValue* cores = machine->find("cores");
+        m_machine.cores = cores ? static_cast<unsigned int>(cores->number) : 0;
+        const JsonValue* profiler = machine->find("profiler");
+        m_machine.profiler = profiler && profiler->boolean;
+    }
+    return true;
+}
+
+int BaselineComparison::compare(const std::vector<BenchmarkSamples>& current, std::FILE* out) const {
+    std::fprintf(out, "[BASELINE] Comparing against %s\n", m_path.c_str());
+
+    // Numbers from another machine or build are shown, but not trusted to fail a run
+    std::vector<std::string> differences;
+    if (m_hasMachine) {
+        differences = MachineFingerprint::current().differences(m_machine);
+    } else {
+        differences.push_back("baseline has no machine fingerprint");
+    }
+    const bool trusted = differences.empty() || m_trustBaseline;
+    for (const std::string& difference : differences) {
+        std::fprintf(out, "[BASELINE][WARNING] Different machine or build (baseline vs now) - %s\n", difference.c_str());
+    }
+    if (!trusted) {
+        std::fprintf(out, "[BASELINE][WARNING] Thresholds are reported but not enforced (--trust-baseline)\n");
+    }
+
+    std::fprintf(out, "%-48s %-6s %12s %12s %8s %20s\n", "benchmark", "metric", "baseline", "current", "delta", "95% CI");
+    int failures = 0;
+    int missing = 0;
+    for (const BenchmarkSamples& now : current) {
+        auto match = std::find_if(m_baseline.begin(), m_baseline.end(),
+                                  [&](const BenchmarkSamples& base) { return base.name == now.name; });
+        if (match == m_baseline.end()) {
+            missing++;
+            continue;
+        }
+
+        // The median always, plus whatever a threshold asks for on this benchmark
+        std::vector<BenchmarkMetric> metrics = { BenchmarkMetric::Median };
+        for (const RegressionThreshold& threshold : m_thresholds) {
+            if (!threshold.filter.empty() && now.name.find(threshold.filter) == std::string::npos) continue;
+            if (std::find(metrics.begin(), metrics.end(), threshold.metric) == metrics.end()) metrics.push_back(threshold.metric);
+        }
+
+        for (BenchmarkMetric metric : metrics) {
+            const Delta delta = compareMetric(match->samples, now.samples, metric);
+            char interval[32] = "n/a";
+            if (delta.hasInterval) {
+                std::snprintf(interval, sizeof(interval), "[%+6.1f%%, %+6.1f%%]", delta.low * 100.0, delta.high * 100.0);
+            }
+            std::fprintf(out, "%-48s %-6s %12.3f %12.3f %+7.1f%% %20s", now.name.c_str(), metricName(metric),
+                         delta.baseline, delta.current, delta.delta * 100.0, interval);
+
+            for (const RegressionThreshold& threshold : m_thresholds) {
+                if (threshold.metric != metric) continue;
+                if (!threshold.filter.empty() && now.name.find(threshold.filter) == std::string::npos) continue;
+                // Slower than allowed, and not explained by noise
+                const bool significant = !delta.hasInterval || delta.low > 0.0;
+                if (delta.delta * 100.0 > threshold.percent && significant) {
+                    std::fprintf(out, "  REGRESSION (> %.1f%%)%s", threshold.percent, trusted ? "" : " untrusted");
+                    if (trusted) failures++;
+                    break;
+                }
+            }
+            std::fprintf(out, "\n");
+        }
+    }
+
+    if (missing > 0) std::fprintf(out, "[BASELINE] %d benchmarks not in the baseline\n", missing);
+    if (failures > 0) std::fprintf(out, "[BASELINE] %d thresholds exceeded\n", failures);
+    std::fflush(out);
+    return failures;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Where a benchmark ran. Written into every benchmark JSON so a result used as
+// a baseline says which machine and build produced it.
+struct MachineFingerprint {
+    std::string cpu;
+    unsigned int cores = 0;             // hardware threads
+    std::string os;
+    std::string compiler;
+    std::string build;                  // "release" or "debug"
+    bool profiler = false;              // PROFILE_SCOPE compiled in
+
+    static MachineFingerprint current();
+
+    // One-line JSON object
+    std::string toJson() const;
+    // "cpu: A vs B" for every field that differs; empty if comparable
+    std::vector<std::string> differences(const MachineFingerprint& other) const;
+};
+
+// Samples of one benchmark: ns/op per repetition (PXRacerBench) or frame
+// times in ms (--benchmark-scene). Only ratios are compared, so the unit
+// just has to match the baseline's.
+struct BenchmarkSamples {
+    std::string name;
+    std::vector<double> samples;
+};
+
+enum class BenchmarkMetric {
+    Mean,
+    Median,
+    P95,
+    P99
+};
+
+// "metric:percent[:name filter]", e.g. p95:5:Road::render
+struct RegressionThreshold {
+    BenchmarkMetric metric = BenchmarkMetric::Median;
+    double percent = 0.0;               // allowed slowdown
+    std::string filter;                 // benchmarks whose name contains it, empty = all
+
+    static bool parse(const std::string& text, RegressionThreshold& out);
+};
+
+// Compares fresh results against a benchmark JSON file kept from an earlier
+// run. Every benchmark in both gets its median (and every thresholded metric)
+// as a relative delta with a bootstrap 95% confidence interval. A threshold
+// fails when the delta is above it and the interval excludes zero, so noise
+// alone doesn't fail a run. A baseline from a different machine or build is
+// flagged and its thresholds don't fail unless setTrustBaseline(true).
+class BaselineComparison {
+public:
+    static constexpr int BOOTSTRAP_RESAMPLES = 1000;
+    static constexpr double CONFIDENCE = 0.95;
+
+    // Reads the "machine" object and "benchmarks" name/samples of a JSON file
+    bool load(const std::string& path, std::string& error);
+
+    void addThreshold(const RegressionThreshold& threshold) { m_thresholds.push_back(threshold); }
+    void setTrustBaseline(bool trust) { m_trustBaseline = trust; }
+
+    // Prints the comparison table; returns the number of failed thresholds
+    int compare(const std::vector<BenchmarkSamples>& current, std::FILE* out) const;
+
+private:
+    std::string m_path;
+    MachineFingerprint m_machine;
+    bool m_hasMachine = false;
+    std::vector<BenchmarkSamples> m_baseline;
+    std::vector<RegressionThreshold> m_thresholds;
+    bool m_trustBaseline = false;
+};
@@ -12,6 +12,9 @@ namespace Config {
     // Game Loop
     constexpr float FIXED_TIMESTEP = 1.0f / 60.0f; // 60 FPS physics
     constexpr float MAX_DELTA_TIME = 0.25f; // Prevent spiral of death
+    constexpr unsigned int SIM_TICK_RATE = 60;      // Default simulation rate (Hz), independent of display
+    constexpr unsigned int MIN_SIM_TICK_RATE = 30;
+    constexpr unsigned int MAX_SIM_TICK_RATE = 240;
 
     // Isometric Settings
     constexpr float ISO_TILE_WIDTH = 64.0f;
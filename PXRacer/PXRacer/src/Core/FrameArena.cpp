@@ -0,0 +1,52 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+    std::size_t alignUp(std::uintptr_t address, std::size_t alignment) {
+        return static_cast<std::size_t>((address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1));
+    }
+}
+
+FrameArena& FrameArena::getInstance() {
+    thread_local FrameArena arena;
+    return arena;
+}
+
+FrameArena::FrameArena(std::size_t capacity)
+    : m_buffer(std::make_unique<unsigned char[]>(capacity))
+    , m_capacity(capacity)
+    , m_used(0)
+    , m_peak(0)
+    , m_overflowBytes(0)
+{
+}
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(m_buffer.get());
+    const std::size_t offset = alignUp(base + m_used, alignment) - static_cast<std::size_t>(base);
+    if (offset + bytes <= m_capacity) {
+        m_used = offset + bytes;
+        m_peak = std::max(m_peak, getUsedBytes());
+        return m_buffer.get() + offset;
+    }
+
+    // Out of room: borrow a block for this frame, reset() grows the buffer instead
+    const std::size_t blockSize = bytes + alignment;
+    m_overflow.push_back(std::make_unique<unsigned char[]>(blockSize));
+    m_overflowBytes += blockSize;
+    m_peak = std::max(m_peak, getUsedBytes());
+
+    const std::uintptr_t blockBase = reinterpret_cast<std::uintptr_t>(m_overflow.back().get());
+    return m_overflow.back().get() + (alignUp(blockBase, alignment) - static_cast<std::size_t>(blockBase));
+}
+
+void FrameArena::reset() {
+    if (!m_overflow.empty()) {
+        m_capacity = std::max(m_capacity * 2, m_used + m_overflowBytes);
+        m_buffer = std::make_unique<unsigned char[]>(m_capacity);
+        m_overflow.clear();
+        m_overflowBytes = 0;
+    }
+    m_used = 0;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// Bump allocator for data that only lives for one frame (render lists, curve
+// samples...). Exposed as a std::pmr::memory_resource, so any pmr container
+// can use it: std::pmr::vector<float> samples(&FrameArena::getInstance());
+// Deallocation is a no-op, reset() releases everything at once.
+//
+// One arena per thread; whoever renders resets its own at the end of the frame.
+// A frame that outgrows the buffer borrows extra blocks from the heap, and the
+// next reset() replaces them with one larger buffer, so a steady frame never allocates.
+class FrameArena : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 256 * 1024;
+
+    static FrameArena& getInstance();
+
+    explicit FrameArena(std::size_t capacity = DEFAULT_CAPACITY);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // End of frame: every allocation made since the last reset becomes invalid
+    void reset();
+
+    std::size_t getUsedBytes() const { return m_used + m_overflowBytes; }
+    std::size_t getCapacity() const { return m_capacity; }
+    std::size_t getPeakBytes() const { return m_peak; }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+private:
+    std::unique_ptr<unsigned char[]> m_buffer;
+    std::size_t m_capacity;
+    std::size_t m_used;
+    std::size_t m_peak;
+
+    std::vector<std::unique_ptr<unsigned char[]>> m_overflow;
+    std::size_t m_overflowBytes;
+};
+
+// Shorthand for the transient containers of a frame
+template<typename T>
+using FrameVector = std::pmr::vector<T>;
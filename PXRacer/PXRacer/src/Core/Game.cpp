@@ -4,62 +4,213 @@
 #include "States/MenuState.h"
 #include "Core/SettingsManager.h"
 #include "Core/AudioManager.h"
+#include "Core/JobSystem.h"
+#include "Core/TraceExporter.h"
+#include "Core/HitchDetector.h"
+#include "Core/FrameArena.h"
+#include "Core/AllocationCounter.h"
+#include "Core/Profiler.h"
+#include "Core/ResourceCache.h"
+#include "Core/StartupTimeline.h"
+#include "Rendering/RenderBackend.h"
+#include "UI/PerfOverlay.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
 #include <iostream>
 
+namespace {
+    // Frames a steady state gets to grow its buffers (glyphs, command arrays,
+    // arena) before it has to stop allocating
+    constexpr int STEADY_FRAME_WARMUP = 120;
+
+    constexpr std::size_t ALLOCATION_OVERLAY_ROWS = 12;
+    constexpr unsigned int ALLOCATION_OVERLAY_TEXT_SIZE = 10;
+}
+
 Game::Game()
-    : m_stateManager(std::make_unique<StateManager>(this)), m_accumulator(0.0f), m_isRunning(true)
+    : m_stateManager(std::make_unique<StateManager>(this)), m_pipelined(false), m_steadyFrames(0), m_simulateAllocations(0), m_renderAllocations(0), m_showAllocations(false), m_traceFrames(TraceExporter::DEFAULT_FRAMES), m_hitchBudgetMs(HitchDetector::DEFAULT_BUDGET_MS), m_perfOverlay(std::make_unique<PerfOverlay>()), m_showPerfOverlay(false), m_lastUpdateSeconds(0.0f), m_frameAllocationMark(0), m_lastFrameAllocations(0), m_accumulator(0.0f), m_interpolationAlpha(1.0f), m_isRunning(true)
 {
     // Load settings first
-    SettingsManager::getInstance().loadFromFile();
+    {
+        STARTUP_PHASE("Load settings");
+        SettingsManager::getInstance().loadFromFile();
+    }
 
-    // Initialize AudioManager and load volumes from settings
-    AudioManager::getInstance().updateVolumesFromSettings();
+    // Initialize AudioManager and load volumes from settings; the menu music
+    // waits for the first frame (see onFirstFrame)
+    {
+        STARTUP_PHASE("Audio manager");
+        AudioManager::getInstance().setPlaybackDeferred(true);
+        AudioManager::getInstance().updateVolumesFromSettings();
+    }
 
     // Create window with loaded settings
-    initializeWindow();
+    {
+        STARTUP_PHASE("Create window");
+        initializeWindow();
+        m_renderBackend = std::make_unique<SfmlRenderBackend>(m_window);
+    }
 
     // Push initial state using the deferred queue system for consistency
-    m_stateManager->pushState(std::make_unique<MenuState>(this));
-    m_stateManager->processStateChanges(); // Process immediately since we're not in a frame yet
+    {
+        STARTUP_PHASE("Menu state");
+        m_stateManager->pushState(std::make_unique<MenuState>(this));
+        m_stateManager->processStateChanges(); // Process immediately since we're not in a frame yet
+    }
 
     auto &settings = SettingsManager::getInstance();
     std::cout << " PixelRacer initialized" << std::endl;
     std::cout << " Window: " << settings.getWindowWidth() << "x" << settings.getWindowHeight() << std::endl;
     std::cout << " FPS Limit: " << Config::FPS_LIMIT << std::endl;
+    std::cout << " Simulation rate: " << settings.getSimTickRate() << " Hz" << std::endl;
 }
 
 Game::~Game()
 {
     std::cout << " PixelRacer shutting down..." << std::endl;
+
+    // States hold references into the cache
+    m_stateManager.reset();
+    ResourceCache::getInstance().clear();
 }
 
 void Game::run() {
     std::cout << "Starting game loop..." << std::endl;
 
+    auto& settings = SettingsManager::getInstance();
+    {
+        STARTUP_PHASE("Job system");
+        const JobSchedule schedule = settings.isSingleThreadedJobs() ? JobSchedule::SingleThreaded : JobSchedule::Parallel;
+        m_jobSystem = std::make_unique<JobSystem>(settings.getJobThreads(), schedule);
+    }
+    std::cout << "Job system: " << (m_jobSystem->isSingleThreaded() ? std::string("single-threaded")
+                                    : std::to_string(m_jobSystem->getWorkerCount()) + " workers") << std::endl;
+
+    m_pipelined = settings.isPipelinedSimulation();
+    if (m_pipelined) {
+        std::cout << "Pipelined simulation enabled" << std::endl;
+    }
+    TaskGroup simulation;
+    {
+        STARTUP_PHASE("Profiler and tooling");
+        PROFILE_THREAD("Main");
+        m_traceExporter = std::make_unique<TraceExporter>();
+        if (!m_hitchLogPath.empty()) {
+            m_hitchDetector = std::make_unique<HitchDetector>(m_hitchLogPath, m_hitchBudgetMs);
+        }
+    }
+
+    // Closed by onFirstFrame once the first frame is on screen
+    StartupTimeline::getInstance().beginPhase("First frame");
+
     while (m_isRunning && m_window.isOpen()) {
+        PROFILE_FRAME_BEGIN();
+        PROFILE_SCOPE("Game::frame");
+        if (m_hitchDetector) {
+            m_hitchDetector->beginFrame();
+        }
+
         // Process events
         processEvents();
 
-        // Fixed timestep update
-        float deltaTime = m_clock.restart().asSeconds();
+        // The previous frame is complete: feed its timings to the performance overlay
+        const float frameSeconds = m_clock.restart().asSeconds();
+        const std::uint64_t totalAllocations = AllocationCounter::getTotalAllocations();
+        m_lastFrameAllocations = totalAllocations - m_frameAllocationMark;
+        m_frameAllocationMark = totalAllocations;
+        m_perfOverlay->recordFrame(frameSeconds, m_lastUpdateSeconds);
+
+        // Fixed timestep update, clamped so a hitch can't queue up a spiral of catch-up ticks
+        float deltaTime = std::min(frameSeconds, Config::MAX_DELTA_TIME);
         m_accumulator += deltaTime;
 
-        const float fixedDeltaTime = 1.0f / Config::FPS_LIMIT;
+        const float fixedDeltaTime = 1.0f / SettingsManager::getInstance().getSimTickRate();
 
+        int ticks = 0;
         while (m_accumulator >= fixedDeltaTime) {
-            update(fixedDeltaTime);
             m_accumulator -= fixedDeltaTime;
+            ticks++;
+        }
+        const float alpha = m_accumulator / fixedDeltaTime;
+
+        m_stateManager->beginTicks();
+        auto simulate = [this, ticks, fixedDeltaTime]() {
+            PROFILE_SCOPE("Game::simulate");
+            const auto start = std::chrono::steady_clock::now();
+            // Counted on whichever thread runs the ticks (a worker when pipelined)
+            const std::uint64_t allocationsBefore = AllocationCounter::getThreadAllocations();
+            for (int i = 0; i < ticks; ++i) {
+                update(fixedDeltaTime);
+            }
+            m_stateManager->captureRenderState();
+            m_simulateAllocations = AllocationCounter::getThreadAllocations() - allocationsBefore;
+            m_lastUpdateSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        if (m_pipelined && m_stateManager->supportsPipelinedUpdate()) {
+            // Pipelined: this frame's ticks run on a worker while the snapshot
+            // published last frame is drawn (one frame of extra latency)
+            m_jobSystem->submit(simulation, simulate);
+            render();
+            m_jobSystem->wait(simulation);
+            m_stateManager->publishRenderState();
+            m_interpolationAlpha = alpha;
+        } else {
+            simulate();
+            m_stateManager->publishRenderState();
+
+            // Render between the previous and current tick
+            m_interpolationAlpha = alpha;
+            render();
         }
+        // Both halves of the frame are done (the simulate job has been joined)
+        checkSteadyFrameAllocations();
 
-        // Render
-        render();
+        if (!StartupTimeline::getInstance().hasFirstFrame()) {
+            onFirstFrame();
+        }
 
         // Process pending state changes AFTER frame completes
         // This ensures states are never deleted while their methods are executing
         m_stateManager->processStateChanges();
+        PROFILE_FRAME_END();
+        if (m_hitchDetector) {
+            m_hitchDetector->endFrame();
+        }
     }
 
     std::cout << "Game loop ended." << std::endl;
+
+    if (m_hitchDetector) {
+        m_hitchDetector->printSummary(std::cout);
+        m_hitchDetector.reset();
+    }
+
+    if (!m_traceOnExitPath.empty()) {
+        m_traceExporter->capture(m_traceFrames, m_traceOnExitPath);
+    }
+    m_traceExporter->flush();
+
+    auto& allocations = AllocationTracker::getInstance();
+    if (allocations.isEnabled()) {
+        allocations.setEnabled(false);
+        allocations.dump(std::cout);
+    }
+}
+
+void Game::onFirstFrame() {
+    StartupTimeline& startup = StartupTimeline::getInstance();
+    startup.markFirstFrame();
+    startup.print(std::cout);
+
+    // Deferred until now so opening the audio device isn't on the way to the first frame
+    AudioManager::getInstance().setPlaybackDeferred(false);
+
+    if (m_exitAfterFirstFrame) {
+        m_isRunning = false;
+    }
 }
 
 void Game::processEvents() {
@@ -68,6 +219,19 @@ void Game::processEvents() {
             m_isRunning = false;
             m_window.close();
         }
+
+        // F3 toggles the performance overlay, F9 the per-scope allocation report
+        // (only with --track-allocations); F10 saves the last frames as a Chrome trace
+        if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
+            if (keyPressed->code == sf::Keyboard::Key::F3) {
+                m_showPerfOverlay = !m_showPerfOverlay;
+            } else if (keyPressed->code == sf::Keyboard::Key::F9 && AllocationTracker::getInstance().isEnabled()) {
+                m_showAllocations = !m_showAllocations;
+            } else if (keyPressed->code == sf::Keyboard::Key::F10 && m_traceExporter) {
+                const std::string path = "trace_" + std::to_string(Profiler::getInstance().getFrameCount()) + ".json";
+                m_traceExporter->capture(m_traceFrames, path);
+            }
+        }
         
         // Pass events to state manager
         m_stateManager->handleInput(*event);
@@ -88,12 +252,108 @@ void Game::update(float deltaTime)
 
 void Game::render()
 {
+    PROFILE_SCOPE("Game::render");
+    const std::uint64_t allocationsBefore = AllocationCounter::getThreadAllocations();
+
     m_window.clear(Config::BACKGROUND_COLOR);
 
-    // Render current state
+    // Render current state (menus draw directly, gameplay states record commands)
+    m_renderCommands.begin(m_window.getSize());
     m_stateManager->render(m_window);
+    if (m_showAllocations) {
+        renderAllocationOverlay();
+    }
+    if (m_showPerfOverlay) {
+        PerfOverlayInfo info;
+        info.render = m_renderBackend->getStats();
+        info.allocations = m_lastFrameAllocations;
+        info.allocationsCounted = AllocationCounter::ENABLED;
+        info.trafficCars = m_stateManager->getActiveTrafficCars();
+        info.resolution = m_renderCommands.getSize();
+        m_perfOverlay->render(m_renderCommands, info);
+    }
+
+    m_renderCommands.sort();
+    m_renderBackend->execute(m_renderCommands);
 
     m_window.display();
+
+    // Everything the frame took from the arena is dead now
+    FrameArena::getInstance().reset();
+    AllocationTracker::getInstance().endFrame();
+
+    m_renderAllocations = AllocationCounter::getThreadAllocations() - allocationsBefore;
+    [[maybe_unused]] const RenderStats& stats = m_renderBackend->getStats();
+    PROFILE_COUNTER("Draw calls", stats.drawCalls);
+    PROFILE_COUNTER("Vertices", stats.vertices);
+    PROFILE_COUNTER("Render allocations", m_renderAllocations);
+}
+
+void Game::checkSteadyFrameAllocations()
+{
+    PROFILE_COUNTER("Simulation allocations", m_simulateAllocations);
+
+#if PXRACER_COUNT_ALLOCATIONS
+    if (!m_stateManager->isSteadyFrame() || m_showAllocations) {
+        m_steadyFrames = 0;
+        return;
+    }
+    const std::uint64_t allocations = m_simulateAllocations + m_renderAllocations;
+    if (++m_steadyFrames > STEADY_FRAME_WARMUP && allocations != 0) {
+        std::cout << "[Game] Steady frame made " << allocations << " heap allocations ("
+                  << m_simulateAllocations << " simulating, " << m_renderAllocations << " rendering)" << std::endl;
+        assert(allocations == 0 && "steady race frame allocated, see FrameArena");
+    }
+#endif
+}
+
+void Game::renderAllocationOverlay() {
+    PROFILE_SCOPE("Game::renderAllocationOverlay");
+
+    if (!m_allocationText) {
+        if (!m_debugFont.openFromFile("assets/fonts/PressStart2P-Regular.ttf")) {
+            std::cerr << "[Game] Failed to load debug overlay font" << std::endl;
+        }
+        m_allocationText = std::make_unique<sf::Text>(m_debugFont, "", ALLOCATION_OVERLAY_TEXT_SIZE);
+        m_allocationText->setFillColor(sf::Color(255, 255, 160));
+        m_allocationText->setLineSpacing(1.4f);
+        m_allocationText->setPosition(sf::Vector2f(10.0f, 10.0f));
+    }
+
+    // Columns: this frame's count and bytes, then the worst frame so far
+    const AllocationTracker& tracker = AllocationTracker::getInstance();
+    tracker.getScopes(m_allocationScopes);
+
+    const AllocationScopeStats& frame = tracker.getFrameTotals();
+    std::string report;
+    char line[128];
+    std::snprintf(line, sizeof(line), "ALLOCATIONS  frame %llu (%llu B)  peak %llu\n",
+                  static_cast<unsigned long long>(frame.frameCount),
+                  static_cast<unsigned long long>(frame.frameBytes),
+                  static_cast<unsigned long long>(frame.peakCount));
+    report += line;
+
+    const std::size_t rows = std::min(m_allocationScopes.size(), ALLOCATION_OVERLAY_ROWS);
+    for (std::size_t i = 0; i < rows; ++i) {
+        const AllocationScopeStats& scope = m_allocationScopes[i];
+        std::snprintf(line, sizeof(line), "%-32s %5llu %8llu B  peak %llu\n", scope.name,
+                      static_cast<unsigned long long>(scope.frameCount),
+                      static_cast<unsigned long long>(scope.frameBytes),
+                      static_cast<unsigned long long>(scope.peakCount));
+        report += line;
+    }
+    m_allocationText->setString(report);
+
+    const sf::FloatRect bounds = m_allocationText->getGlobalBounds();
+    m_renderCommands.setLayer(RenderLayer::Overlay);
+    m_renderCommands.fillRect(sf::Vector2f(0.0f, 0.0f),
+                              sf::Vector2f(bounds.position.x + bounds.size.x + 10.0f, bounds.position.y + bounds.size.y + 10.0f),
+                              sf::Color(0, 0, 0, 190));
+    m_renderCommands.draw(*m_allocationText);
+}
+
+const RenderStats& Game::getRenderStats() const {
+    return m_renderBackend->getStats();
 }
 
 void Game::initializeWindow() {
@@ -111,8 +371,8 @@ void Game::initializeWindow() {
         windowState
     );
 
-    // Apply window settings
-    m_window.setFramerateLimit(Config::FPS_LIMIT);
+    // Apply window settings (VSync paces frames at the display rate, the limit is a fallback)
+    m_window.setFramerateLimit(Config::VSYNC_ENABLED ? 0 : Config::FPS_LIMIT);
     m_window.setVerticalSyncEnabled(Config::VSYNC_ENABLED);
 }
 
@@ -142,7 +402,7 @@ void Game::recreateWindow() {
         );
 
         // Apply window settings
-        m_window.setFramerateLimit(Config::FPS_LIMIT);
+        m_window.setFramerateLimit(Config::VSYNC_ENABLED ? 0 : Config::FPS_LIMIT);
         m_window.setVerticalSyncEnabled(Config::VSYNC_ENABLED);
     } else {
         // Just resize for windowed mode (preserves game state)
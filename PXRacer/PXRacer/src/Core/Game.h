@@ -2,10 +2,19 @@
 #include <SFML/Graphics.hpp>
 #include <memory>
 #include <optional>
+#include <string>
 #include "Gameplay/GameModeConfig.h" 
+#include "Rendering/RenderCommandBuffer.h"
+#include "Core/AllocationTracker.h"
 
 // Forward declarations
 class StateManager;
+class JobSystem;
+class TraceExporter;
+class PerfOverlay;
+class HitchDetector;
+class RenderBackend;
+struct RenderStats;
 
 class Game {
 public:
@@ -22,6 +31,36 @@ public:
     // Game control
     void quit() { m_isRunning = false; }
 
+    // States record their draw calls here; played back once per frame after State::render
+    RenderCommandBuffer& getRenderCommands() { return m_renderCommands; }
+    const RenderStats& getRenderStats() const;
+
+    // Shared scheduler for parallel work; created when run() starts
+    JobSystem* getJobSystem() { return m_jobSystem.get(); }
+
+    // Chrome trace of the last frames: written to exitPath when the loop ends
+    // (if not empty); F10 captures the same number of frames on demand
+    void setTraceCapture(const std::string& exitPath, std::size_t frames) {
+        m_traceOnExitPath = exitPath;
+        m_traceFrames = frames;
+    }
+
+    // Frames slower than budgetMs are reported to logPath (see Core/HitchDetector);
+    // the worst offenders are printed when the loop ends
+    void setHitchDetection(const std::string& logPath, float budgetMs) {
+        m_hitchLogPath = logPath;
+        m_hitchBudgetMs = budgetMs;
+    }
+
+    // Frame times, draw calls and allocations on top of everything (F3)
+    void setPerfOverlayVisible(bool visible) { m_showPerfOverlay = visible; }
+
+    // Stops the loop after the first frame (--benchmark-startup)
+    void setExitAfterFirstFrame(bool exit) { m_exitAfterFirstFrame = exit; }
+
+    // How far (0..1) rendering is between the last two simulation ticks
+    float getInterpolationAlpha() const { return m_interpolationAlpha; }
+
     // Settings management
     void applySettings();
 
@@ -40,6 +79,11 @@ private:
     void processEvents();
     void update(float deltaTime);
     void render();
+    void renderAllocationOverlay();
+    // Debug builds: asserts that a steady race frame (ticks, snapshot and render) allocated nothing
+    void checkSteadyFrameAllocations();
+    // Closes the startup timeline (see Core/StartupTimeline)
+    void onFirstFrame();
     void initializeWindow();
     void recreateWindow();
 
@@ -47,12 +91,43 @@ private:
     sf::RenderWindow m_window;
     std::unique_ptr<StateManager> m_stateManager;
 
+    RenderCommandBuffer m_renderCommands;
+    std::unique_ptr<RenderBackend> m_renderBackend;
+
+    std::unique_ptr<JobSystem> m_jobSystem;
+    bool m_pipelined;
+    int m_steadyFrames;     // consecutive steady frames, see State::isSteadyFrame
+    std::uint64_t m_simulateAllocations;    // by the thread that ran this frame's ticks
+    std::uint64_t m_renderAllocations;      // by the main thread in render()
+
+    // Allocation report overlay (F9 with --track-allocations)
+    bool m_showAllocations;
+    sf::Font m_debugFont;
+    std::unique_ptr<sf::Text> m_allocationText;
+    std::vector<AllocationScopeStats> m_allocationScopes;
+
+    std::unique_ptr<TraceExporter> m_traceExporter;
+    std::string m_traceOnExitPath;
+    std::size_t m_traceFrames;
+
+    std::unique_ptr<HitchDetector> m_hitchDetector;
+    std::string m_hitchLogPath;
+    float m_hitchBudgetMs;
+
+    std::unique_ptr<PerfOverlay> m_perfOverlay;
+    bool m_showPerfOverlay;
+    float m_lastUpdateSeconds;              // simulation time of the last frame
+    std::uint64_t m_frameAllocationMark;    // AllocationCounter total at the last frame start
+    std::uint64_t m_lastFrameAllocations;
+
     // Timing
     sf::Clock m_clock;
     float m_accumulator;
+    float m_interpolationAlpha;
 
     // State
     bool m_isRunning;
+    bool m_exitAfterFirstFrame = false;
 
     std::optional<CampaignTrackData> m_currentCampaignTrack;
 };
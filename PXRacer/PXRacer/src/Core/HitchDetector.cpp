@@ -0,0 +1,318 @@
+#include "HitchDetector.h"
+#include "Core/AllocationCounter.h"
+#include "Core/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    // Main thread time not covered by any recorded scope
+    const char* const OUTSIDE_SCOPES = "(outside scopes)";
+
+    double toMs(std::uint64_t ns) {
+        return ns / 1000000.0;
+    }
+}
+
+HitchDetector::ConsoleTap::ConsoleTap(std::ostream& stream, HitchDetector& owner)
+    : m_stream(stream), m_target(stream.rdbuf()), m_owner(owner)
+{
+    m_stream.rdbuf(this);
+}
+
+HitchDetector::ConsoleTap::~ConsoleTap() {
+    m_stream.rdbuf(m_target);
+}
+
+HitchDetector::ConsoleTap::int_type HitchDetector::ConsoleTap::overflow(int_type ch) {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+    const char c = traits_type::to_char_type(ch);
+    m_owner.capture(&c, 1);
+    return m_target->sputc(c);
+}
+
+std::streamsize HitchDetector::ConsoleTap::xsputn(const char* text, std::streamsize count) {
+    m_owner.capture(text, static_cast<std::size_t>(count));
+    return m_target->sputn(text, count);
+}
+
+int HitchDetector::ConsoleTap::sync() {
+    return m_target->pubsync();
+}
+
+HitchDetector::HitchDetector(const std::string& logPath, float budgetMs)
+    : m_logPath(logPath)
+    , m_budgetNs(static_cast<std::uint64_t>(budgetMs * 1000000.0f))
+    , m_mainThread(Profiler::getInstance().getThreadIndex())
+    , m_console{}
+    , m_coutTap(std::cout, *this)
+    , m_cerrTap(std::cerr, *this)
+{
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(m_logPath, error);
+    m_logBytes = error ? 0 : size;
+
+    m_writer = std::thread([this]() { writerLoop(); });
+    Logger::getInstance().setListener(&HitchDetector::onLogLine, this);
+    std::cout << "[HITCH] Logging frames over " << budgetMs << " ms to " << m_logPath << std::endl;
+}
+
+HitchDetector::~HitchDetector() {
+    Logger::getInstance().setListener(nullptr, nullptr);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_wake.notify_all();
+    m_writer.join();
+}
+
+void HitchDetector::capture(const char* text, std::size_t count) {
+    std::lock_guard<std::mutex> lock(m_consoleMutex);
+    const std::size_t room = m_console.size() - m_consoleSize;
+    if (count > room) {
+        count = room;
+        m_consoleTruncated = true;
+    }
+    std::copy(text, text + count, m_console.begin() + m_consoleSize);
+    m_consoleSize += count;
+}
+
+// Log lines are captured when they are logged, not when the logger thread prints them
+void HitchDetector::onLogLine(void* detector, const char* line, std::size_t length) {
+    static_cast<HitchDetector*>(detector)->capture(line, length);
+}
+
+void HitchDetector::beginFrame() {
+    m_frameStart = Profiler::now();
+    m_allocationMark = AllocationCounter::getTotalAllocations();
+
+    std::lock_guard<std::mutex> lock(m_consoleMutex);
+    m_consoleSize = 0;
+    m_consoleTruncated = false;
+}
+
+bool HitchDetector::endFrame() {
+    const std::uint64_t frameEnd = Profiler::now();
+    const std::uint64_t frameNs = frameEnd - m_frameStart;
+    const std::uint64_t allocations = AllocationCounter::getTotalAllocations() - m_allocationMark;
+    if (frameNs <= m_budgetNs) {
+        m_frameIndex++;
+        return false;
+    }
+
+    m_hitchCount++;
+    m_worstFrameNs = std::max(m_worstFrameNs, frameNs);
+    collectScopes(frameEnd, frameNs);
+
+    // Blame the main thread scope that spent the most time itself
+    const ScopeTime* worst = nullptr;
+    for (const ScopeTime& scope : m_scopes) {
+        if (scope.thread == m_mainThread && (!worst || scope.selfNs > worst->selfNs)) worst = &scope;
+    }
+    if (worst) blame(*worst);
+
+    std::string report = formatReport(frameNs, allocations);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(report));
+    }
+    m_wake.notify_one();
+    m_frameIndex++;
+    return true;
+}
+
+void HitchDetector::collectScopes(std::uint64_t frameEnd, std::uint64_t frameNs) {
+    m_scopes.clear();
+    Profiler::getInstance().getEvents(m_frameStart, frameEnd, m_events);
+
+    // Parents before children on each thread so a stack can find every parent
+    std::sort(m_events.begin(), m_events.end(), [](const ProfileEvent& a, const ProfileEvent& b) {
+        if (a.thread != b.thread) return a.thread < b.thread;
+        if (a.start != b.start) return a.start < b.start;
+        return a.depth < b.depth;
+    });
+
+    m_childNs.assign(m_events.size(), 0);
+    std::vector<std::size_t> stack;
+    std::uint64_t mainTopLevelNs = 0;
+    for (std::size_t i = 0; i < m_events.size(); ++i) {
+        const ProfileEvent& event = m_events[i];
+        if (i > 0 && m_events[i - 1].thread != event.thread) stack.clear();
+        while (!stack.empty() && m_events[stack.back()].depth >= event.depth) stack.pop_back();
+
+        const std::uint64_t duration = event.end - event.start;
+        if (!stack.empty() && m_events[stack.back()].depth + 1 == event.depth) {
+            m_childNs[stack.back()] += duration;
+        } else if (stack.empty() && event.thread == m_mainThread) {
+            mainTopLevelNs += duration;
+        }
+        stack.push_back(i);
+    }
+
+    // Merge by thread and name; the stack pass is done so child times are final
+    for (std::size_t i = 0; i < m_events.size(); ++i) {
+        const ProfileEvent& event = m_events[i];
+        const std::uint64_t duration = event.end - event.start;
+        const std::uint64_t self = duration - std::min(duration, m_childNs[i]);
+        auto it = std::find_if(m_scopes.begin(), m_scopes.end(), [&](const ScopeTime& s) {
+            return s.thread == event.thread && s.name == event.name;
+        });
+        if (it == m_scopes.end()) {
+            m_scopes.push_back({ event.name, event.thread, event.depth, 1, duration, self });
+        } else {
+            it->calls++;
+            it->totalNs += duration;
+            it->selfNs += self;
+        }
+    }
+
+    if (frameNs > mainTopLevelNs) {
+        m_scopes.push_back({ OUTSIDE_SCOPES, m_mainThread, 0, 1, frameNs - mainTopLevelNs, frameNs - mainTopLevelNs });
+    }
+    std::sort(m_scopes.begin(), m_scopes.end(), [](const ScopeTime& a, const ScopeTime& b) {
+        if (a.thread != b.thread) return a.thread < b.thread;
+        return a.totalNs > b.totalNs;
+    });
+}
+
+void HitchDetector::blame(const ScopeTime& scope) {
+    auto it = std::find_if(m_offenders.begin(), m_offenders.end(), [&](const HitchOffender& o) {
+        return o.name == scope.name;
+    });
+    if (it == m_offenders.end()) {
+        m_offenders.push_back({ scope.name });
+        it = m_offenders.end() - 1;
+    }
+    it->hitches++;
+    it->totalSelfNs += scope.selfNs;
+    it->worstSelfNs = std::max(it->worstSelfNs, scope.selfNs);
+}
+
+std::string HitchDetector::formatReport(std::uint64_t frameNs, std::uint64_t allocations) {
+    std::ostringstream out;
+    char line[160];
+    std::snprintf(line, sizeof(line), "=== Hitch #%llu at frame %llu: %.2f ms (budget %.2f ms) ===\n",
+                  static_cast<unsigned long long>(m_hitchCount), static_cast<unsigned long long>(m_frameIndex),
+                  toMs(frameNs), toMs(m_budgetNs));
+    out << line;
+    if (AllocationCounter::ENABLED) {
+        out << "Allocations: " << allocations << "\n";
+    }
+
+    const std::vector<std::string> threadNames = Profiler::getInstance().getThreadNames();
+    std::uint32_t thread = UINT32_MAX;
+    std::size_t rows = 0;
+    for (const ScopeTime& scope : m_scopes) {
+        if (scope.thread != thread) {
+            thread = scope.thread;
+            rows = 0;
+            const std::string name = thread < threadNames.size() ? threadNames[thread] : "Thread " + std::to_string(thread);
+            out << "Scopes [" << name << "]  total ms / self ms / calls\n";
+        }
+        if (rows++ >= REPORT_SCOPES) continue;
+        std::snprintf(line, sizeof(line), "  %-44s %8.3f %8.3f %5u\n",
+                      scope.name, toMs(scope.totalNs), toMs(scope.selfNs), scope.calls);
+        out << line;
+    }
+
+    // Per-scope counts are those of the tracker's last frame (closed after render)
+    const AllocationTracker& tracker = AllocationTracker::getInstance();
+    if (tracker.isEnabled()) {
+        tracker.getScopes(m_allocationScopes);
+        out << "Allocations by scope  count / bytes\n";
+        for (const AllocationScopeStats& scope : m_allocationScopes) {
+            if (scope.frameCount == 0) break;
+            std::snprintf(line, sizeof(line), "  %-44s %8llu %10llu\n", scope.name,
+                          static_cast<unsigned long long>(scope.frameCount),
+                          static_cast<unsigned long long>(scope.frameBytes));
+            out << line;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_consoleMutex);
+    if (m_consoleSize > 0) {
+        out << "Console output:\n";
+        out.write(m_console.data(), static_cast<std::streamsize>(m_consoleSize));
+        if (m_console[m_consoleSize - 1] != '\n') out << "\n";
+        if (m_consoleTruncated) out << "  ... (truncated)\n";
+    }
+    out << "\n";
+    return out.str();
+}
+
+void HitchDetector::printSummary(std::ostream& out) {
+    std::sort(m_offenders.begin(), m_offenders.end(), [](const HitchOffender& a, const HitchOffender& b) {
+        if (a.hitches != b.hitches) return a.hitches > b.hitches;
+        return a.totalSelfNs > b.totalSelfNs;
+    });
+
+    std::ostringstream summary;
+    char line[160];
+    std::snprintf(line, sizeof(line), "[HITCH] %llu of %llu frames over %.2f ms (worst %.2f ms)\n",
+                  static_cast<unsigned long long>(m_hitchCount), static_cast<unsigned long long>(m_frameIndex),
+                  toMs(m_budgetNs), toMs(m_worstFrameNs));
+    summary << line;
+    if (!m_offenders.empty()) {
+        summary << "[HITCH] Worst offenders (hitches blamed / total self ms / worst self ms)\n";
+    }
+    for (std::size_t i = 0; i < m_offenders.size() && i < SUMMARY_ROWS; ++i) {
+        const HitchOffender& offender = m_offenders[i];
+        std::snprintf(line, sizeof(line), "[HITCH]   %-44s %5u %10.3f %8.3f\n", offender.name,
+                      offender.hitches, toMs(offender.totalSelfNs), toMs(offender.worstSelfNs));
+        summary << line;
+    }
+
+    const std::string text = summary.str();
+    out << text << std::flush;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back("=== Summary ===\n" + text + "\n");
+    }
+    m_wake.notify_one();
+}
+
+void HitchDetector::writerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this]() { return !m_running || !m_queue.empty(); });
+        if (m_queue.empty()) return;   // stopping, nothing left to write
+
+        std::string report = std::move(m_queue.front());
+        m_queue.pop_front();
+        lock.unlock();
+
+        append(report);
+
+        lock.lock();
+    }
+}
+
+void HitchDetector::append(const std::string& text) {
+    if (m_logBytes > 0 && m_logBytes + text.size() > MAX_LOG_BYTES) {
+        rotate();
+    }
+
+    std::ofstream out(m_logPath, std::ios::app);
+    out << text;
+    if (!out) {
+        // Not std::cerr: that is tapped and would land in the next report
+        std::fprintf(stderr, "[HITCH] Failed to write %s\n", m_logPath.c_str());
+        return;
+    }
+    m_logBytes += text.size();
+}
+
+void HitchDetector::rotate() {
+    namespace fs = std::filesystem;
+    std::error_code error;
+    fs::remove(m_logPath + "." + std::to_string(MAX_LOG_FILES - 1), error);
+    for (int i = MAX_LOG_FILES - 2; i >= 1; --i) {
+        fs::rename(m_logPath + "." + std::to_string(i), m_logPath + "." + std::to_string(i + 1), error);
+    }
+    fs::rename(m_logPath, m_logPath + ".1", error);
+    m_logBytes = 0;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Core/Profiler.h"
+
+// A scope name blamed for hitches, see HitchDetector::printSummary
+struct HitchOffender {
+    const char* name = nullptr;
+    std::uint32_t hitches = 0;          // hitch frames where it had the most self time
+    std::uint64_t totalSelfNs = 0;      // over all hitch frames
+    std::uint64_t worstSelfNs = 0;
+};
+
+// Frame watchdog (--hitch-log). Every frame longer than the budget is written
+// to a rotating log with its profiler scopes (all threads, inclusive and self
+// time), its allocation count and whatever was logged (Core/Logger) or printed
+// to std::cout/std::cerr during it. Each hitch is blamed on the main thread scope with the most self
+// time; the blamed scopes are ranked on exit. Files are written on the
+// detector's own thread.
+class HitchDetector {
+public:
+    static constexpr float DEFAULT_BUDGET_MS = 25.0f;              // 1.5 frames at 60 Hz
+    static constexpr std::uintmax_t MAX_LOG_BYTES = 1 << 20;       // then log -> log.1 -> ...
+    static constexpr int MAX_LOG_FILES = 4;                        // log plus 3 older ones
+    static constexpr std::size_t CONSOLE_CAPTURE_BYTES = 4096;     // console output kept per frame
+    static constexpr std::size_t REPORT_SCOPES = 24;               // scopes per thread in a report
+    static constexpr std::size_t SUMMARY_ROWS = 10;
+
+    // Main thread; taps std::cout, std::cerr and the Logger until destroyed
+    HitchDetector(const std::string& logPath, float budgetMs);
+    ~HitchDetector();     // finishes pending writes
+
+    HitchDetector(const HitchDetector&) = delete;
+    HitchDetector& operator=(const HitchDetector&) = delete;
+
+    void beginFrame();
+    // Returns true if the frame went over budget
+    bool endFrame();
+
+    std::uint64_t getHitchCount() const { return m_hitchCount; }
+
+    // Worst offenders first; also appended to the log
+    void printSummary(std::ostream& out);
+
+private:
+    // Forwards to the original stream buffer and keeps a copy for the frame
+    class ConsoleTap : public std::streambuf {
+    public:
+        ConsoleTap(std::ostream& stream, HitchDetector& owner);
+        ~ConsoleTap() override;
+
+    protected:
+        int_type overflow(int_type ch) override;
+        std::streamsize xsputn(const char* text, std::streamsize count) override;
+        int sync() override;
+
+    private:
+        std::ostream& m_stream;
+        std::streambuf* m_target;
+        HitchDetector& m_owner;
+    };
+
+    struct ScopeTime {
+        const char* name;
+        std::uint32_t thread;
+        std::uint32_t depth;
+        std::uint32_t calls;
+        std::uint64_t totalNs;
+        std::uint64_t selfNs;
+    };
+
+    void capture(const char* text, std::size_t count);
+    static void onLogLine(void* detector, const char* line, std::size_t length);
+    void collectScopes(std::uint64_t frameEnd, std::uint64_t frameNs);
+    std::string formatReport(std::uint64_t frameNs, std::uint64_t allocations);
+    void blame(const ScopeTime& scope);
+
+    void writerLoop();
+    void append(const std::string& text);     // writer thread
+    void rotate();
+
+    std::string m_logPath;
+    std::uint64_t m_budgetNs;
+    std::uint32_t m_mainThread;
+
+    std::uint64_t m_frameStart = 0;
+    std::uint64_t m_allocationMark = 0;
+    std::uint64_t m_frameIndex = 0;
+    std::uint64_t m_hitchCount = 0;
+    std::uint64_t m_worstFrameNs = 0;
+
+    // Console output of the current frame (any thread)
+    std::mutex m_consoleMutex;
+    std::array<char, CONSOLE_CAPTURE_BYTES> m_console;
+    std::size_t m_consoleSize = 0;
+    bool m_consoleTruncated = false;
+
+    // Scratch for the report of a hitch frame
+    std::vector<ProfileEvent> m_events;
+    std::vector<ScopeTime> m_scopes;
+    std::vector<std::uint64_t> m_childNs;
+    std::vector<AllocationScopeStats> m_allocationScopes;
+    std::vector<HitchOffender> m_offenders;
+
+    std::thread m_writer;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<std::string> m_queue;
+    std::uintmax_t m_logBytes = 0;        // writer thread
+    bool m_running = true;
+
+    // Declared last: the taps must go before anything they write into
+    ConsoleTap m_coutTap;
+    ConsoleTap m_cerrTap;
+};
@@ -0,0 +1,276 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+
+namespace {
+    // Which pool (if any) the current thread works for, and its queue index
+    struct WorkerIdentity {
+        const JobSystem* owner = nullptr;
+        unsigned index = 0;
+    };
+    thread_local WorkerIdentity t_worker;
+
+    constexpr unsigned NO_QUEUE = ~0u;
+    constexpr std::size_t CHUNKS_PER_WORKER = 4;
+}
+
+void* ScratchArena::allocate(std::size_t size, std::size_t alignment) {
+    while (true) {
+        if (m_top.block < m_blocks.size()) {
+            Block& block = m_blocks[m_top.block];
+            const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.data.get());
+            const std::uintptr_t aligned = (base + m_top.offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+            const std::size_t offset = static_cast<std::size_t>(aligned - base);
+            if (offset + size <= block.size) {
+                m_top.offset = offset + size;
+                return block.data.get() + offset;
+            }
+            // Doesn't fit: move on, the rest of this block is wasted until the next rewind
+            m_top.block++;
+            m_top.offset = 0;
+            continue;
+        }
+
+        const std::size_t blockSize = std::max(BLOCK_SIZE, size + alignment);
+        m_blocks.push_back({ std::make_unique<unsigned char[]>(blockSize), blockSize });
+    }
+}
+
+std::size_t ScratchArena::getCapacity() const {
+    std::size_t total = 0;
+    for (const auto& block : m_blocks) total += block.size;
+    return total;
+}
+
+JobSystem::JobSystem(unsigned workerCount, JobSchedule schedule)
+    : m_schedule(schedule)
+{
+    if (workerCount == 0) workerCount = getDefaultWorkerCount();
+    if (schedule == JobSchedule::SingleThreaded) workerCount = 0;
+
+    // Single threaded still needs one queue, drained by whoever waits
+    const unsigned queueCount = std::max(workerCount, 1u);
+    m_queues.reserve(queueCount);
+    for (unsigned i = 0; i < queueCount; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    for (unsigned i = 0; i <= workerCount; ++i) {
+        m_scratch.push_back(std::make_unique<ScratchArena>());
+    }
+
+    m_workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running = false;
+    }
+    m_workAvailable.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+unsigned JobSystem::getDefaultWorkerCount() {
+    unsigned count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+void JobSystem::submit(Job job) {
+    push(std::move(job), nullptr);
+}
+
+void JobSystem::submit(TaskGroup& group, Job job) {
+    group.m_pending.fetch_add(1);
+    push(std::move(job), &group);
+}
+
+void JobSystem::push(Job job, TaskGroup* group) {
+    unsigned index;
+    if (t_worker.owner == this) {
+        index = t_worker.index;
+    } else {
+        index = m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    }
+
+    m_pendingJobs.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->jobs.emplace_back(std::move(job), group);
+    }
+
+    // Taking the sleep mutex orders the push before any sleeper re-checks its predicate
+    { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+    m_workAvailable.notify_one();
+    m_allDone.notify_all();
+}
+
+void JobSystem::continueWith(TaskGroup& group, Job continuation) {
+    {
+        std::lock_guard<std::mutex> lock(group.m_mutex);
+        if (group.m_pending.load() > 0) {
+            group.m_continuations.push_back(std::move(continuation));
+            return;
+        }
+    }
+    submit(std::move(continuation));
+}
+
+void JobSystem::wait() {
+    unsigned index = (t_worker.owner == this) ? t_worker.index : NO_QUEUE;
+
+    while (m_pendingJobs.load() > 0) {
+        if (tryRunOne(index)) continue;
+
+        // Nothing to grab: the remaining jobs are running elsewhere
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_allDone.wait(lock, [this]() { return m_pendingJobs.load() == 0 || hasQueuedJobs(); });
+    }
+}
+
+void JobSystem::wait(TaskGroup& group) {
+    unsigned index = (t_worker.owner == this) ? t_worker.index : NO_QUEUE;
+
+    while (group.m_pending.load() > 0) {
+        if (tryRunOne(index)) continue;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_allDone.wait(lock, [this, &group]() { return group.m_pending.load() == 0 || hasQueuedJobs(); });
+    }
+
+    // The last job may still hold the group's mutex; the group can only go away after it lets go
+    std::lock_guard<std::mutex> lock(group.m_mutex);
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t grainSize, const RangeJob& body) {
+    if (count == 0) return;
+    grainSize = std::max<std::size_t>(grainSize, 1);
+
+    const std::size_t maxChunks = std::max<std::size_t>(getWorkerCount(), 1) * CHUNKS_PER_WORKER;
+    const std::size_t chunks = std::min((count + grainSize - 1) / grainSize, maxChunks);
+    if (chunks <= 1) {
+        body(0, count);
+        return;
+    }
+
+    const std::size_t chunkSize = (count + chunks - 1) / chunks;
+    TaskGroup group;
+    for (std::size_t begin = 0; begin < count; begin += chunkSize) {
+        const std::size_t end = std::min(count, begin + chunkSize);
+        submit(group, [&body, begin, end]() { body(begin, end); });
+    }
+    wait(group);
+}
+
+ScratchArena& JobSystem::getScratch() {
+    if (t_worker.owner == this) return *m_scratch[t_worker.index];
+    return *m_scratch.back();
+}
+
+bool JobSystem::hasQueuedJobs() {
+    for (auto& queue : m_queues) {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (!queue->jobs.empty()) return true;
+    }
+    return false;
+}
+
+void JobSystem::workerLoop(unsigned index) {
+    t_worker.owner = this;
+    t_worker.index = index;
+    PROFILE_THREAD("Worker " + std::to_string(index));
+
+    while (true) {
+        if (tryRunOne(index)) continue;
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_workAvailable.wait(lock, [this]() { return !m_running || hasQueuedJobs(); });
+        if (!m_running) return;
+    }
+}
+
+bool JobSystem::popJob(unsigned index, std::pair<Job, TaskGroup*>& out) {
+    WorkerQueue& queue = *m_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) return false;
+    out = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::stealJob(unsigned thief, std::pair<Job, TaskGroup*>& out) {
+    const unsigned count = static_cast<unsigned>(m_queues.size());
+    const unsigned start = (thief == NO_QUEUE) ? 0 : thief + 1;
+
+    for (unsigned i = 0; i < count; ++i) {
+        unsigned victim = (start + i) % count;
+        if (victim == thief) continue;
+
+        WorkerQueue& queue = *m_queues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) continue;
+        out = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::tryRunOne(unsigned index) {
+    std::pair<Job, TaskGroup*> job;
+    bool found = (index != NO_QUEUE && popJob(index, job)) || stealJob(index, job);
+    if (!found) return false;
+
+    // Scratch is stack-like: a job that waits may run others on top of its own allocations
+    ScratchArena& scratch = getScratch();
+    const ScratchArena::Marker marker = scratch.getMarker();
+
+    try {
+        job.first();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[JobSystem] Job failed: " << e.what() << std::endl;
+    }
+    catch (...) {
+        std::cerr << "[JobSystem] Job failed with unknown exception" << std::endl;
+    }
+    scratch.rewind(marker);
+
+    // Group (and its continuations) first, so wait() never sees zero pending jobs in between
+    if (job.second) finishGroupJob(*job.second);
+
+    if (m_pendingJobs.fetch_sub(1) == 1) {
+        notifyProgress();
+    }
+    return true;
+}
+
+void JobSystem::finishGroupJob(TaskGroup& group) {
+    std::vector<Job> continuations;
+    bool done;
+    {
+        std::lock_guard<std::mutex> lock(group.m_mutex);
+        done = group.m_pending.fetch_sub(1) == 1;
+        if (done) continuations.swap(group.m_continuations);
+    }
+    // The group may be destroyed from here on
+
+    for (auto& continuation : continuations) {
+        submit(std::move(continuation));
+    }
+    if (done) notifyProgress();
+}
+
+void JobSystem::notifyProgress() {
+    { std::lock_guard<std::mutex> lock(m_sleepMutex); }
+    m_allDone.notify_all();
+}
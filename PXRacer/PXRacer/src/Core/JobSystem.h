@@ -0,0 +1,135 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum class JobSchedule {
+    Parallel,       // worker threads with work stealing
+    SingleThreaded  // no threads: jobs run in submission order on whoever waits (deterministic debugging)
+};
+
+// Counts the jobs submitted through it. wait(group) returns once they are all
+// done; continuations registered with continueWith() are submitted at that point.
+class TaskGroup {
+public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    bool isDone() const { return m_pending.load() == 0; }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<unsigned> m_pending{ 0 };
+    std::mutex m_mutex;
+    std::vector<std::function<void()>> m_continuations;
+};
+
+// Bump allocator, one per worker. Whatever a job allocates is released when
+// the job returns, so jobs can grab temporary arrays without touching the heap.
+class ScratchArena {
+public:
+    static constexpr std::size_t BLOCK_SIZE = 256 * 1024;
+
+    struct Marker {
+        std::size_t block = 0;
+        std::size_t offset = 0;
+    };
+
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    template<typename T>
+    T* allocateArray(std::size_t count) {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    Marker getMarker() const { return m_top; }
+    void rewind(Marker marker) { m_top = marker; }
+    std::size_t getCapacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        std::size_t size;
+    };
+
+    std::vector<Block> m_blocks;
+    Marker m_top;
+};
+
+// Work-stealing thread pool shared by every subsystem (Game owns one).
+// Every worker owns a deque: it pushes/pops its own jobs at the back (LIFO,
+// cache friendly) and, when empty, steals from the front of the others (FIFO,
+// takes the oldest and usually biggest piece of work).
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+    using RangeJob = std::function<void(std::size_t begin, std::size_t end)>;
+
+    // workerCount 0 = one worker per hardware thread (ignored when single threaded)
+    explicit JobSystem(unsigned workerCount = 0, JobSchedule schedule = JobSchedule::Parallel);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Safe from any thread. Jobs submitted from a worker go to its own queue.
+    void submit(Job job);
+    void submit(TaskGroup& group, Job job);
+
+    // Runs continuation as a new job once every job of group has finished
+    // (right away if the group is already done)
+    void continueWith(TaskGroup& group, Job continuation);
+
+    // Blocks until every submitted job has finished; the caller helps out meanwhile
+    void wait();
+    // Blocks until the group is done, running queued jobs meanwhile
+    void wait(TaskGroup& group);
+
+    // Splits [0, count) into chunks of at least grainSize items and calls
+    // body(begin, end) for each, in parallel. Returns when all chunks are done.
+    void parallelFor(std::size_t count, std::size_t grainSize, const RangeJob& body);
+
+    // Scratch memory of the calling worker, or of the owning thread outside jobs.
+    // Only the thread that created the pool may use it from outside a job.
+    ScratchArena& getScratch();
+
+    unsigned getWorkerCount() const { return static_cast<unsigned>(m_workers.size()); }
+    bool isSingleThreaded() const { return m_schedule == JobSchedule::SingleThreaded; }
+    static unsigned getDefaultWorkerCount();
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::pair<Job, TaskGroup*>> jobs;
+    };
+
+    void push(Job job, TaskGroup* group);
+    void workerLoop(unsigned index);
+    bool popJob(unsigned index, std::pair<Job, TaskGroup*>& out);
+    bool stealJob(unsigned thief, std::pair<Job, TaskGroup*>& out);
+    bool tryRunOne(unsigned index);
+    void finishGroupJob(TaskGroup& group);
+    bool hasQueuedJobs();
+    void notifyProgress();
+
+    JobSchedule m_schedule;
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::vector<std::unique_ptr<ScratchArena>> m_scratch;   // one per worker + the owning thread
+
+    std::atomic<unsigned> m_pendingJobs{ 0 };
+    std::atomic<unsigned> m_nextQueue{ 0 };
+    std::atomic<bool> m_running{ true };
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_allDone;
+};
@@ -0,0 +1,176 @@
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+
+namespace {
+    // Indexed by LogCategory / LogLevel
+    const char* const CATEGORY_TAGS[] = { "[GAME]", "[STATE]", "[RACE]", "[ROAD]", "[AUDIO]", "[SETTINGS]" };
+    const char* const LEVEL_TAGS[] = { "[DEBUG]", "", "[WARNING]", "[ERROR]" };
+
+    std::uint64_t currentSecond() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+}
+
+Logger& Logger::getInstance() {
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger()
+    : m_slots(std::make_unique<Slot[]>(RING_SIZE))
+    , m_rateLimits(std::make_unique<RateLimit[]>(RATE_LIMIT_SITES))
+    , m_output(stdout)
+{
+    for (std::size_t i = 0; i < RING_SIZE; ++i) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_writer = std::thread([this]() { writerLoop(); });
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_running.store(false, std::memory_order_release);
+    }
+    m_wake.notify_one();
+    m_writer.join();
+}
+
+void Logger::setListener(Listener listener, void* user) {
+    m_listenerUser.store(user, std::memory_order_relaxed);
+    m_listener.store(listener, std::memory_order_release);
+}
+
+bool Logger::isEnabled(LogLevel level) const {
+    if (level < m_level.load(std::memory_order_relaxed)) return false;
+    return m_output.load(std::memory_order_relaxed) || m_listener.load(std::memory_order_relaxed);
+}
+
+bool Logger::allow(const char* site, std::uint32_t& suppressed) {
+    constexpr std::size_t PROBES = 8;
+    const std::size_t hash = static_cast<std::size_t>((reinterpret_cast<std::uintptr_t>(site) >> 3) * 0x9E3779B97F4A7C15ull >> 32);
+
+    for (std::size_t probe = 0; probe < PROBES; ++probe) {
+        RateLimit& limit = m_rateLimits[(hash + probe) & (RATE_LIMIT_SITES - 1)];
+        const char* owner = limit.site.load(std::memory_order_acquire);
+        if (!owner && limit.site.compare_exchange_strong(owner, site, std::memory_order_acq_rel)) {
+            owner = site;
+        }
+        if (owner != site) continue;
+
+        // Approximate under contention, which is fine for a log throttle
+        const std::uint64_t second = currentSecond();
+        std::uint64_t previous = limit.second.load(std::memory_order_relaxed);
+        if (previous != second && limit.second.compare_exchange_strong(previous, second, std::memory_order_relaxed)) {
+            limit.count.store(0, std::memory_order_relaxed);
+        }
+        if (limit.count.fetch_add(1, std::memory_order_relaxed) >= RATE_LIMIT_PER_SECOND) {
+            limit.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        suppressed = limit.suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+    return true;    // table full: this site is not throttled
+}
+
+void Logger::write(LogLevel level, LogCategory category, const char* format, ...) {
+    std::uint32_t suppressed = 0;
+    if (!allow(format, suppressed)) return;
+
+    // Claim a slot (bounded MPMC queue; the writer thread is the only consumer)
+    std::uint64_t position = m_head.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true) {
+        slot = &m_slots[position & (RING_SIZE - 1)];
+        const std::uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const std::int64_t lag = static_cast<std::int64_t>(sequence - position);
+        if (lag == 0) {
+            if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        } else if (lag < 0) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            position = m_head.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Room is kept for the newline and the terminator
+    constexpr int LIMIT = static_cast<int>(LINE_BYTES) - 2;
+    int length = std::snprintf(slot->text, LINE_BYTES, "%s%s ",
+                               CATEGORY_TAGS[static_cast<int>(category)], LEVEL_TAGS[static_cast<int>(level)]);
+    va_list args;
+    va_start(args, format);
+    const int written = std::vsnprintf(slot->text + length, LINE_BYTES - length, format, args);
+    va_end(args);
+    length = std::min(length + std::max(written, 0), LIMIT);
+    if (suppressed > 0 && length < LIMIT) {
+        const int note = std::snprintf(slot->text + length, LINE_BYTES - length, " (+%u suppressed)", suppressed);
+        length = std::min(length + std::max(note, 0), LIMIT);
+    }
+    slot->text[length++] = '\n';
+    slot->text[length] = '\0';
+    slot->length = static_cast<std::uint32_t>(length);
+
+    if (Listener listener = m_listener.load(std::memory_order_acquire)) {
+        listener(m_listenerUser.load(std::memory_order_relaxed), slot->text, slot->length);
+    }
+    // seq_cst pairs with writerLoop: either the writer sees this slot before
+    // it sleeps, or we see it idle and wake it
+    slot->sequence.store(position + 1, std::memory_order_seq_cst);
+    if (m_writerIdle.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_wake.notify_one();
+    }
+}
+
+bool Logger::drain(std::FILE* output) {
+    std::uint64_t next = m_written.load(std::memory_order_relaxed);
+    bool any = false;
+    while (true) {
+        Slot& slot = m_slots[next & (RING_SIZE - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != next + 1) break;
+
+        if (output) std::fwrite(slot.text, 1, slot.length, output);
+        slot.sequence.store(next + RING_SIZE, std::memory_order_release);
+        next++;
+        m_written.store(next, std::memory_order_release);
+        any = true;
+    }
+
+    const std::uint64_t dropped = m_dropped.exchange(0, std::memory_order_relaxed);
+    if (output && dropped > 0) {
+        std::fprintf(output, "[LOG][WARNING] %llu lines dropped (ring full)\n", static_cast<unsigned long long>(dropped));
+    }
+    if (output && (any || dropped > 0)) std::fflush(output);
+    return any;
+}
+
+bool Logger::hasPending() const {
+    const std::uint64_t next = m_written.load(std::memory_order_relaxed);
+    return m_slots[next & (RING_SIZE - 1)].sequence.load(std::memory_order_seq_cst) == next + 1;
+}
+
+void Logger::writerLoop() {
+    while (true) {
+        const bool running = m_running.load(std::memory_order_acquire);
+        const bool any = drain(m_output.load(std::memory_order_relaxed));
+        if (!running && !any) return;   // stopping and the ring is empty
+        if (any) continue;
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_writerIdle.store(true, std::memory_order_seq_cst);
+        m_wake.wait(lock, [this]() { return hasPending() || !m_running.load(std::memory_order_acquire); });
+        m_writerIdle.store(false, std::memory_order_relaxed);
+    }
+}
+
+void Logger::flush() {
+    const std::uint64_t target = m_head.load(std::memory_order_acquire);
+    while (m_written.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+enum class LogLevel : std::uint8_t {
+    Debug = 0,
+    Info = 1,
+    Warning = 2,
+    Error = 3
+};
+
+enum class LogCategory : std::uint8_t {
+    Game,
+    State,
+    Race,
+    Road,
+    Audio,
+    Settings,
+    Count
+};
+
+// Levels below PXRACER_LOG_LEVEL are compiled out (the arguments are not even
+// evaluated). Release builds drop Debug by default; CMake option PXRACER_LOG_LEVEL.
+#ifndef PXRACER_LOG_LEVEL
+#ifdef NDEBUG
+#define PXRACER_LOG_LEVEL 1
+#else
+#define PXRACER_LOG_LEVEL 0
+#endif
+#endif
+
+// Asynchronous logger. A LOG_* call formats the line straight into a slot of a
+// lock-free ring (printf-style, no allocation) and returns; a background
+// thread writes the slots out and flushes, and sleeps while the ring is empty. If the ring is full the message is
+// dropped and counted rather than blocking the game. Every call site may log
+// RATE_LIMIT_PER_SECOND lines per second, the rest are counted and reported
+// with the next line that gets through.
+class Logger {
+public:
+    static constexpr std::size_t RING_SIZE = 1024;          // power of two
+    static constexpr std::size_t LINE_BYTES = 256;          // longer lines are cut
+    static constexpr std::uint32_t RATE_LIMIT_PER_SECOND = 20;
+    static constexpr std::size_t RATE_LIMIT_SITES = 256;    // power of two
+
+    // Called on the logging thread with each accepted line (Core/HitchDetector)
+    using Listener = void (*)(void* user, const char* line, std::size_t length);
+
+    static Logger& getInstance();
+    ~Logger();    // writes whatever is still queued
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // Runtime filter on top of PXRACER_LOG_LEVEL
+    void setLevel(LogLevel level) { m_level.store(level, std::memory_order_relaxed); }
+    // Where lines go (stdout by default); nullptr discards them
+    void setOutput(std::FILE* output) { m_output.store(output, std::memory_order_relaxed); }
+    void setListener(Listener listener, void* user);
+
+    bool isEnabled(LogLevel level) const;
+
+    // format must be a string literal: it identifies the call site for rate limiting
+#if defined(__GNUC__)
+    __attribute__((format(printf, 4, 5)))
+#endif
+    void write(LogLevel level, LogCategory category, const char* format, ...);
+
+    // Blocks until every line logged so far has been written
+    void flush();
+
+private:
+    Logger();
+
+    struct Slot {
+        std::atomic<std::uint64_t> sequence;
+        std::uint32_t length;
+        char text[LINE_BYTES];
+    };
+
+    struct RateLimit {
+        std::atomic<const char*> site{ nullptr };
+        std::atomic<std::uint64_t> second{ 0 };
+        std::atomic<std::uint32_t> count{ 0 };
+        std::atomic<std::uint32_t> suppressed{ 0 };
+    };
+
+    // Returns false if the call site used up this second; otherwise how many
+    // lines it had suppressed since the last one that got through
+    bool allow(const char* site, std::uint32_t& suppressed);
+    void writerLoop();
+    bool drain(std::FILE* output);
+    bool hasPending() const;    // writer thread only
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<std::uint64_t> m_head{ 0 };         // next slot to claim
+    std::atomic<std::uint64_t> m_written{ 0 };      // slots consumed by the writer
+    std::atomic<std::uint64_t> m_dropped{ 0 };
+    std::unique_ptr<RateLimit[]> m_rateLimits;
+
+    std::atomic<LogLevel> m_level{ LogLevel::Debug };
+    std::atomic<std::FILE*> m_output;
+    std::atomic<Listener> m_listener{ nullptr };
+    std::atomic<void*> m_listenerUser{ nullptr };
+
+    std::atomic<bool> m_running{ true };
+    std::atomic<bool> m_writerIdle{ false };    // write() only takes m_wakeMutex while set
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    std::thread m_writer;
+};
+
+#define PXRACER_LOG_WRITE(level, category, ...) \
+    do { \
+        if (Logger::getInstance().isEnabled(level)) Logger::getInstance().write(level, category, __VA_ARGS__); \
+    } while (0)
+
+#if PXRACER_LOG_LEVEL <= 0
+#define LOG_DEBUG(category, ...) PXRACER_LOG_WRITE(LogLevel::Debug, category, __VA_ARGS__)
+#else
+#define LOG_DEBUG(category, ...) ((void)0)
+#endif
+#if PXRACER_LOG_LEVEL <= 1
+#define LOG_INFO(category, ...) PXRACER_LOG_WRITE(LogLevel::Info, category, __VA_ARGS__)
+#else
+#define LOG_INFO(category, ...) ((void)0)
+#endif
+#if PXRACER_LOG_LEVEL <= 2
+#define LOG_WARNING(category, ...) PXRACER_LOG_WRITE(LogLevel::Warning, category, __VA_ARGS__)
+#else
+#define LOG_WARNING(category, ...) ((void)0)
+#endif
+#define LOG_ERROR(category, ...) PXRACER_LOG_WRITE(LogLevel::Error, category, __VA_ARGS__)
@@ -0,0 +1,181 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    const std::chrono::steady_clock::time_point g_epoch = std::chrono::steady_clock::now();
+
+    thread_local std::uint32_t t_depth = 0;
+    thread_local void* t_buffer = nullptr;
+}
+
+Profiler& Profiler::getInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler()
+    : m_frames{}
+    , m_counters(std::make_unique<ProfileCounter[]>(COUNTER_HISTORY))
+{
+}
+
+std::uint64_t Profiler::now() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - g_epoch).count());
+}
+
+Profiler::ThreadBuffer& Profiler::getThreadBuffer() {
+    if (t_buffer) return *static_cast<ThreadBuffer*>(t_buffer);
+
+    // First scope on this thread: the only allocation the profiler makes
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->events = std::make_unique<EventSlot[]>(EVENTS_PER_THREAD);
+
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    buffer->index = static_cast<std::uint32_t>(m_threads.size());
+    buffer->name = "Thread " + std::to_string(buffer->index);
+    t_buffer = buffer.get();
+    m_threads.push_back(std::move(buffer));
+    return *m_threads.back();
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    buffer.name = name;
+}
+
+void Profiler::record(const char* name, std::uint64_t start, std::uint64_t end, std::uint32_t depth) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    const std::uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    EventSlot& slot = buffer.events[index & (EVENTS_PER_THREAD - 1)];
+
+    // Mark the slot busy before touching the payload (pairs with readEvent)
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    slot.depth.store(depth, std::memory_order_relaxed);
+    slot.sequence.store(index + 1, std::memory_order_release);
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+bool Profiler::readEvent(const ThreadBuffer& buffer, std::uint64_t index, ProfileEvent& out) {
+    const EventSlot& slot = buffer.events[index & (EVENTS_PER_THREAD - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != index + 1) return false;
+
+    out.name = slot.name.load(std::memory_order_relaxed);
+    out.start = slot.start.load(std::memory_order_relaxed);
+    out.end = slot.end.load(std::memory_order_relaxed);
+    out.depth = slot.depth.load(std::memory_order_relaxed);
+    out.thread = buffer.index;
+
+    // Still the same event after the copy, i.e. the owner did not lap us
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == index + 1;
+}
+
+void Profiler::recordCounter(const char* name, double value) {
+    m_counters[m_counterCount & (COUNTER_HISTORY - 1)] = { name, now(), value };
+    m_counterCount++;
+}
+
+void Profiler::beginFrame() {
+    m_frameStart = now();
+}
+
+void Profiler::endFrame() {
+    m_frames[m_frameCount % FRAME_HISTORY] = { m_frameCount, m_frameStart, now() };
+    m_frameCount++;
+}
+
+void Profiler::getFrames(std::size_t count, std::vector<ProfileFrame>& out) const {
+    out.clear();
+    const std::uint64_t available = std::min<std::uint64_t>(m_frameCount, FRAME_HISTORY);
+    const std::uint64_t take = std::min<std::uint64_t>(available, count);
+    for (std::uint64_t i = m_frameCount - take; i < m_frameCount; ++i) {
+        out.push_back(m_frames[i % FRAME_HISTORY]);
+    }
+}
+
+void Profiler::getEvents(std::uint64_t start, std::uint64_t end, std::vector<ProfileEvent>& out) const {
+    out.clear();
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    for (const auto& buffer : m_threads) {
+        const std::uint64_t written = buffer->written.load(std::memory_order_acquire);
+        const std::uint64_t first = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+
+        // The owner may keep writing while we copy; readEvent skips every slot it laps
+        ProfileEvent event;
+        for (std::uint64_t i = first; i < written; ++i) {
+            if (!readEvent(*buffer, i, event)) continue;
+            if (event.end > start && event.start < end) out.push_back(event);
+        }
+    }
+}
+
+void Profiler::getCounters(std::uint64_t start, std::uint64_t end, std::vector<ProfileCounter>& out) const {
+    out.clear();
+    const std::uint64_t first = m_counterCount > COUNTER_HISTORY ? m_counterCount - COUNTER_HISTORY : 0;
+    for (std::uint64_t i = first; i < m_counterCount; ++i) {
+        const ProfileCounter& counter = m_counters[i & (COUNTER_HISTORY - 1)];
+        if (counter.time >= start && counter.time < end) out.push_back(counter);
+    }
+}
+
+void Profiler::getLastFrameScopes(std::vector<ProfileScopeStats>& out) const {
+    out.clear();
+    if (m_frameCount == 0 || !t_buffer) return;
+
+    const ProfileFrame& frame = m_frames[(m_frameCount - 1) % FRAME_HISTORY];
+    const ThreadBuffer& buffer = *static_cast<const ThreadBuffer*>(t_buffer);
+    const std::uint64_t written = buffer.written.load(std::memory_order_relaxed);
+    const std::uint64_t first = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+
+    // Scopes are recorded as they close (children first), walk back to the frame start
+    ProfileEvent event;
+    for (std::uint64_t i = written; i > first; --i) {
+        if (!readEvent(buffer, i - 1, event)) break;
+        if (event.end <= frame.start) break;
+        if (event.start >= frame.end) continue;
+
+        auto it = std::find_if(out.begin(), out.end(), [&](const ProfileScopeStats& s) { return s.name == event.name; });
+        if (it == out.end()) {
+            out.push_back({ event.name, event.depth, 1, event.end - event.start });
+        } else {
+            it->calls++;
+            it->totalNs += event.end - event.start;
+        }
+    }
+    std::sort(out.begin(), out.end(), [](const ProfileScopeStats& a, const ProfileScopeStats& b) {
+        return a.totalNs > b.totalNs;
+    });
+}
+
+std::vector<std::string> Profiler::getThreadNames() const {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    std::vector<std::string> names;
+    for (const auto& buffer : m_threads) names.push_back(buffer->name);
+    return names;
+}
+
+ProfileScope::ProfileScope(const char* name)
+    : m_name(name)
+    , m_depth(t_depth++)
+{
+#if PXRACER_COUNT_ALLOCATIONS
+    AllocationTracker::pushScope(name);
+#endif
+    m_start = Profiler::now();
+}
+
+ProfileScope::~ProfileScope() {
+    const std::uint64_t end = Profiler::now();
+    --t_depth;
+    Profiler::getInstance().record(m_name, m_start, end, m_depth);
+#if PXRACER_COUNT_ALLOCATIONS
+    AllocationTracker::popScope();
+#endif
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Core/AllocationTracker.h"
+
+// PXRACER_PROFILING=0 (CMake option PXRACER_PROFILER=OFF) compiles every
+// PROFILE_SCOPE out; the scopes still feed the allocation tracker.
+#ifndef PXRACER_PROFILING
+#define PXRACER_PROFILING 1
+#endif
+
+// One closed scope. Times are nanoseconds since the profiler started.
+struct ProfileEvent {
+    const char* name;
+    std::uint64_t start;
+    std::uint64_t end;
+    std::uint32_t depth;      // nesting level on its thread, 0 = outermost
+    std::uint32_t thread;     // index into Profiler::getThreadNames()
+};
+
+// A sampled value (draw calls, allocations, ...) at a point in time
+struct ProfileCounter {
+    const char* name;
+    std::uint64_t time;
+    double value;
+};
+
+struct ProfileFrame {
+    std::uint64_t index;
+    std::uint64_t start;
+    std::uint64_t end;
+};
+
+// Time spent in one scope name during a frame (main thread)
+struct ProfileScopeStats {
+    const char* name;
+    std::uint32_t depth;
+    std::uint32_t calls;
+    std::uint64_t totalNs;
+};
+
+// Scoped timer backend. Every thread writes the scopes it closes into its own
+// ring buffer (no locks, no allocation after the first scope on a thread), so
+// old data is overwritten rather than ever blocking the game. The main thread
+// brackets each frame with beginFrame/endFrame; readers pick events by time.
+// Each slot is a seqlock, so getEvents may run while other threads record: a
+// slot that was overwritten or is being written during the copy is skipped.
+class Profiler {
+public:
+    static constexpr std::size_t EVENTS_PER_THREAD = 1 << 15;   // power of two
+    static constexpr std::size_t FRAME_HISTORY = 1024;
+    static constexpr std::size_t COUNTER_HISTORY = 1 << 14;    // power of two
+
+    static Profiler& getInstance();
+
+    static std::uint64_t now();
+
+    // Label shown for the calling thread in captures ("Main", "Worker 2", ...)
+    void setThreadName(const std::string& name);
+    // Index of the calling thread in getThreadNames() / ProfileEvent::thread
+    std::uint32_t getThreadIndex() { return getThreadBuffer().index; }
+
+    void beginFrame();
+    void endFrame();
+
+    void record(const char* name, std::uint64_t start, std::uint64_t end, std::uint32_t depth);
+    // Main thread only; name must be a string literal
+    void recordCounter(const char* name, double value);
+
+    // Frames still in the history, oldest first (at most count)
+    void getFrames(std::size_t count, std::vector<ProfileFrame>& out) const;
+    std::uint64_t getFrameCount() const { return m_frameCount; }
+    // Events of every thread that overlap [start, end), oldest first per thread.
+    // Safe against concurrent record(); events lost to the ring are left out
+    void getEvents(std::uint64_t start, std::uint64_t end, std::vector<ProfileEvent>& out) const;
+    void getCounters(std::uint64_t start, std::uint64_t end, std::vector<ProfileCounter>& out) const;
+    // Main thread scopes of the last finished frame, slowest first
+    void getLastFrameScopes(std::vector<ProfileScopeStats>& out) const;
+    std::vector<std::string> getThreadNames() const;
+
+private:
+    Profiler();
+
+    // Seqlock slot: sequence is index + 1 once the event is complete, 0 while
+    // the owner rewrites it. Fields are relaxed atomics so a torn read is not UB.
+    struct EventSlot {
+        std::atomic<std::uint64_t> sequence{ 0 };
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<std::uint64_t> start{ 0 };
+        std::atomic<std::uint64_t> end{ 0 };
+        std::atomic<std::uint32_t> depth{ 0 };
+    };
+
+    struct ThreadBuffer {
+        std::unique_ptr<EventSlot[]> events;
+        std::atomic<std::uint64_t> written{ 0 };
+        std::uint32_t index = 0;
+        std::string name;
+    };
+
+    ThreadBuffer& getThreadBuffer();
+    // Copies event number index of buffer; false if that slot no longer holds it
+    static bool readEvent(const ThreadBuffer& buffer, std::uint64_t index, ProfileEvent& out);
+
+    mutable std::mutex m_threadsMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+
+    ProfileFrame m_frames[FRAME_HISTORY];
+    std::unique_ptr<ProfileCounter[]> m_counters;
+    std::uint64_t m_counterCount = 0;
+    std::uint64_t m_frameCount = 0;
+    std::uint64_t m_frameStart = 0;
+};
+
+// Times the enclosing block; also the allocation scope of the block
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_name;
+    std::uint64_t m_start;
+    std::uint32_t m_depth;
+};
+
+#if PXRACER_PROFILING
+#define PXRACER_PROFILE_JOIN2(a, b) a##b
+#define PXRACER_PROFILE_JOIN(a, b) PXRACER_PROFILE_JOIN2(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PXRACER_PROFILE_JOIN(profileScope_, __LINE__)(name)
+#define PROFILE_THREAD(name) Profiler::getInstance().setThreadName(name)
+#define PROFILE_FRAME_BEGIN() Profiler::getInstance().beginFrame()
+#define PROFILE_FRAME_END() Profiler::getInstance().endFrame()
+#define PROFILE_COUNTER(name, value) Profiler::getInstance().recordCounter(name, static_cast<double>(value))
+#else
+#define PROFILE_SCOPE(name) ALLOCATION_SCOPE(name)
+#define PROFILE_THREAD(name) ((void)0)
+#define PROFILE_FRAME_BEGIN() ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#define PROFILE_COUNTER(name, value) ((void)0)
+#endif
@@ -0,0 +1,31 @@
+#include "Random.h"
+#include <random>
+
+int RandomStream::rangeInt(int lo, int hi) {
+    if (hi <= lo) return lo;
+
+    // Multiply-shift maps 32 random bits onto the range without modulo bias worth caring about
+    std::uint64_t span = static_cast<std::uint64_t>(static_cast<std::int64_t>(hi) - lo) + 1;
+    std::uint64_t bits = (*this)() >> 32;
+    return lo + static_cast<int>((bits * span) >> 32);
+}
+
+RandomService& RandomService::getInstance() {
+    static RandomService instance;
+    return instance;
+}
+
+RandomStream RandomService::stream(std::string_view name, std::uint64_t index) const {
+    std::uint64_t key = mix64(m_seed ^ hashName(name));
+    if (index != 0) {
+        key = mix64(key + index * RandomConfig::GOLDEN_GAMMA);
+    }
+    return RandomStream(key);
+}
+
+std::uint64_t RandomService::makeEntropySeed() {
+    std::random_device device;
+    std::uint64_t high = device();
+    std::uint64_t low = device();
+    return (high << 32) ^ low;
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace RandomConfig {
+    // Weyl sequence increment used by SplitMix64
+    constexpr std::uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ull;
+
+    // Seed used when nothing else was requested (tools override it)
+    constexpr std::uint64_t DEFAULT_SEED = 0x5049584C52414345ull; // "PIXLRACE"
+}
+
+// SplitMix64 finalizer - a strong 64-bit mixing function.
+// Also used directly as a stateless hash: mix64(seed ^ index) etc.
+constexpr std::uint64_t mix64(std::uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Counter-based random stream (SplitMix64).
+// The whole state is a key and a counter, so constructing one is two stores
+// and value N of a stream can be computed directly with at(N).
+// Satisfies UniformRandomBitGenerator, but prefer the helpers below: they give
+// identical results on every compiler/standard library, std distributions don't.
+class RandomStream {
+public:
+    using result_type = std::uint64_t;
+
+    constexpr RandomStream() = default;
+    constexpr explicit RandomStream(std::uint64_t key, std::uint64_t counter = 0)
+        : m_key(key), m_counter(counter) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() { return at(m_counter++); }
+
+    // Random access into the stream - does not advance the counter
+    constexpr result_type at(std::uint64_t index) const {
+        return mix64(m_key + (index + 1) * RandomConfig::GOLDEN_GAMMA);
+    }
+
+    // Uniform float in [0, 1)
+    float nextFloat() { return static_cast<float>((*this)() >> 40) * (1.0f / 16777216.0f); }
+
+    // Uniform float in [lo, hi)
+    float range(float lo, float hi) { return lo + (hi - lo) * nextFloat(); }
+
+    // Uniform int in [lo, hi] (inclusive, like std::uniform_int_distribution)
+    int rangeInt(int lo, int hi);
+
+    // True with probability p
+    bool chance(float p) { return nextFloat() < p; }
+
+    // Independent child stream, e.g. one per traffic car or per lap
+    RandomStream fork(std::uint64_t salt) const { return RandomStream(mix64(m_key ^ mix64(salt))); }
+
+    std::uint64_t getKey() const { return m_key; }
+    std::uint64_t getCounter() const { return m_counter; }
+
+private:
+    std::uint64_t m_key = 0;
+    std::uint64_t m_counter = 0;
+};
+
+// Central RNG service.
+// Every gameplay system asks for a named stream; the stream depends only on
+// the session seed and the name, so a whole run is reproducible from one
+// 64-bit seed and adding a new consumer does not shift anybody else's numbers.
+class RandomService {
+public:
+    RandomService() = default;
+    explicit RandomService(std::uint64_t seed) : m_seed(seed) {}
+
+    // Process-wide service used by the game (seeded from main)
+    static RandomService& getInstance();
+
+    void setSeed(std::uint64_t seed) { m_seed = seed; m_sessionCounter = 0; m_attractCounter = 0; }
+    std::uint64_t getSeed() const { return m_seed; }
+
+    // Seed for the next race session; the sequence only depends on the master seed
+    std::uint64_t nextSessionSeed() { return stream("session").at(m_sessionCounter++); }
+
+    // Seed for the next attract-mode demo, from its own sequence so idling on
+    // the attract screen does not shift the seeds of later play sessions
+    std::uint64_t nextAttractSeed() { return stream("attract").at(m_attractCounter++); }
+
+    // Named stream, optionally split further by index (lap, car, session...)
+    RandomStream stream(std::string_view name, std::uint64_t index = 0) const;
+
+    // FNV-1a, stable across platforms (std::hash is not)
+    static constexpr std::uint64_t hashName(std::string_view name) {
+        std::uint64_t hash = 0xCBF29CE484222325ull;
+        for (char c : name) {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+    // Fresh seed from std::random_device (for normal play sessions)
+    static std::uint64_t makeEntropySeed();
+
+private:
+    std::uint64_t m_seed = RandomConfig::DEFAULT_SEED;
+    std::uint64_t m_sessionCounter = 0;
+    std::uint64_t m_attractCounter = 0;
+};
@@ -0,0 +1,38 @@
+#include "ResourceCache.h"
+#include "Core/Profiler.h"
+#include <iostream>
+
+ResourceCache& ResourceCache::getInstance() {
+    static ResourceCache instance;
+    return instance;
+}
+
+const sf::Font& ResourceCache::getFont(const std::string& path) {
+    auto it = m_fonts.find(path);
+    if (it != m_fonts.end()) return *it->second;
+
+    PROFILE_SCOPE("ResourceCache::loadFont");
+    auto font = std::make_unique<sf::Font>();
+    if (!font->openFromFile(path)) {
+        std::cerr << "[ResourceCache] Failed to load font: " << path << std::endl;
+    }
+    return *m_fonts.emplace(path, std::move(font)).first->second;
+}
+
+const sf::Texture* ResourceCache::getTexture(const std::string& path) {
+    auto it = m_textures.find(path);
+    if (it != m_textures.end()) return it->second.get();
+
+    PROFILE_SCOPE("ResourceCache::loadTexture");
+    auto texture = std::make_unique<sf::Texture>();
+    if (!texture->loadFromFile(path)) {
+        std::cerr << "[ResourceCache] Failed to load texture: " << path << std::endl;
+        texture.reset();
+    }
+    return m_textures.emplace(path, std::move(texture)).first->second.get();
+}
+
+void ResourceCache::clear() {
+    m_fonts.clear();
+    m_textures.clear();
+}
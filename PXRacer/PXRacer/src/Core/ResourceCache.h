@@ -0,0 +1,31 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Fonts and textures shared by every state. A file is loaded the first time
+// it is asked for and kept until clear(), so moving between menus doesn't
+// reopen the same font and background each time, and states that are never
+// shown never load anything. Main thread only.
+class ResourceCache {
+public:
+    static ResourceCache& getInstance();
+
+    ResourceCache(const ResourceCache&) = delete;
+    ResourceCache& operator=(const ResourceCache&) = delete;
+
+    // A font that can't be opened is reported once and stays empty (text draws nothing)
+    const sf::Font& getFont(const std::string& path);
+    // nullptr if the texture can't be loaded (reported once)
+    const sf::Texture* getTexture(const std::string& path);
+
+    // Releases everything; call while the window (GL context) still exists
+    void clear();
+
+private:
+    ResourceCache() = default;
+
+    std::unordered_map<std::string, std::unique_ptr<sf::Font>> m_fonts;
+    std::unordered_map<std::string, std::unique_ptr<sf::Texture>> m_textures;    // null = failed
+};
@@ -0,0 +1,284 @@
+#include "SceneBenchmark.h"
+#include "Core/AudioManager.h"
+#include "Core/BenchmarkBaseline.h"
+#include "Core/Constants.h"
+#include "Core/FrameArena.h"
+#include "Core/Logger.h"
+#include "Core/SettingsManager.h"
+#include "Gameplay/Autopilot.h"
+#include "Gameplay/GameplayManager.h"
+#include "Gameplay/TrackDefinition.h"
+#include "Rendering/RenderBackend.h"
+#include "Rendering/RenderCommandBuffer.h"
+#include "UI/GameHUD.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <streambuf>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // Ticks simulated (not rendered) to get through the start lights
+    constexpr int MAX_COUNTDOWN_TICKS = 60 * 60;
+
+    // Track building and session setup are chatty on std::cout; the table goes to stdout directly
+    class NullStreamBuf : public std::streambuf {
+    protected:
+        int overflow(int c) override { return traits_type::not_eof(c); }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    struct Scene {
+        std::string name;
+        const TrackDefinition* track = nullptr;     // null for endless
+        EndlessDifficultyLevel difficulty = EndlessDifficultyLevel::Medium;
+    };
+
+    // The window or the off-screen texture frames are drawn into
+    struct SceneTarget {
+        sf::RenderWindow* window = nullptr;
+        OffscreenRenderBackend* offscreen = nullptr;
+        RenderBackend* backend = nullptr;
+
+        void clear() {
+            if (window) window->clear(Config::BACKGROUND_COLOR);
+            else offscreen->clear(Config::BACKGROUND_COLOR);
+        }
+        void present() {
+            if (window) window->display();
+            else offscreen->display();
+        }
+        // Keeps the window responsive; false once it was closed
+        bool pollEvents() {
+            if (!window) return true;
+            while (const std::optional<sf::Event> event = window->pollEvent()) {
+                if (event->is<sf::Event::Closed>()) return false;
+            }
+            return true;
+        }
+    };
+
+    std::vector<Scene> collectScenes(const std::vector<TrackDefinition>& tracks) {
+        std::vector<Scene> scenes;
+        for (const TrackDefinition& track : tracks) {
+            scenes.push_back({ track.id, &track, EndlessDifficultyLevel::Medium });
+        }
+        scenes.push_back({ "endless_easy", nullptr, EndlessDifficultyLevel::Easy });
+        scenes.push_back({ "endless_medium", nullptr, EndlessDifficultyLevel::Medium });
+        scenes.push_back({ "endless_hard", nullptr, EndlessDifficultyLevel::Hard });
+        return scenes;
+    }
+
+    std::unique_ptr<GameplayManager> createGameplay(const Scene& scene, std::uint64_t seed) {
+        if (!scene.track) {
+            return std::make_unique<GameplayManager>(GameMode::Endless, scene.difficulty, seed);
+        }
+        auto gameplay = std::make_unique<GameplayManager>(GameMode::Campaign, scene.track, seed);
+        CampaignTrackData campaignTrack;
+        campaignTrack.trackId = scene.track->id;
+        campaignTrack.name = scene.track->name;
+        campaignTrack.requiredLaps = scene.track->recommendedLaps;
+        gameplay->setCampaignTrack(campaignTrack);
+        return gameplay;
+    }
+
+    double percentile(const std::vector<double>& sorted, double p) {
+        if (sorted.empty()) return 0.0;
+        return sorted[static_cast<std::size_t>(std::lround(p * (sorted.size() - 1)))];
+    }
+
+    void summarize(SceneBenchmarkResult& result) {
+        if (result.frameMs.empty()) return;
+        std::vector<double> sorted = result.frameMs;
+        std::sort(sorted.begin(), sorted.end());
+        double sum = 0.0;
+        for (double ms : sorted) sum += ms;
+        result.meanMs = sum / sorted.size();
+        result.p50Ms = percentile(sorted, 0.50);
+        result.p95Ms = percentile(sorted, 0.95);
+        result.p99Ms = percentile(sorted, 0.99);
+        result.maxMs = sorted.back();
+    }
+
+    std::optional<SceneBenchmarkResult> runScene(const Scene& scene, sf::Vector2u size, SceneTarget& target,
+                                                 const SceneBenchmarkOptions& options) {
+        SceneBenchmarkResult result;
+        result.scene = scene.name;
+        result.resolution = size;
+        result.frameMs.reserve(options.frames);
+
+        std::unique_ptr<GameplayManager> gameplay = createGameplay(scene, options.seed);
+        // The HUD lays itself out for the window size in SettingsManager
+        GameHUD hud;
+        const Autopilot bot;
+        const float dt = 1.0f / static_cast<float>(Config::SIM_TICK_RATE);
+
+        auto tick = [&]() {
+            gameplay->setInput(bot.computeInput(gameplay->getRoad(), gameplay->getPlayer()));
+            gameplay->update(dt);
+        };
+        for (int i = 0; i < MAX_COUNTDOWN_TICKS && gameplay->isCountingDown(); ++i) tick();
+
+        RenderCommandBuffer commands;
+        GameplayRenderState state;
+        std::uint64_t drawCalls = 0;
+        const int totalFrames = options.warmupFrames + options.frames;
+
+        for (int frame = 0; frame < totalFrames; ++frame) {
+            if (!target.pollEvents()) return std::nullopt;
+            if (gameplay->isRaceFinished() || gameplay->isGameOver()) {
+                result.endedEarly = true;
+                break;
+            }
+
+            const auto start = Clock::now();
+            tick();
+            gameplay->captureRenderState(state);
+            state.elapsed = dt;
+            hud.update(state.hud, dt);
+
+            target.clear();
+            commands.begin(size);
+            gameplay->render(commands, state);
+            hud.render(commands, state.hud);
+            commands.sort();
+            target.backend->execute(commands);
+            target.present();
+            FrameArena::getInstance().reset();
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+            if (frame >= options.warmupFrames) {
+                result.frameMs.push_back(ms);
+                drawCalls += target.backend->getStats().drawCalls;
+            }
+        }
+
+        summarize(result);
+        if (!result.frameMs.empty()) result.drawCallsPerFrame = static_cast<double>(drawCalls) / result.frameMs.size();
+        return result;
+    }
+}
+
+SceneBenchmark::SceneBenchmark(const SceneBenchmarkOptions& options)
+    : m_options(options)
+{
+    if (m_options.resolutions.empty()) {
+        for (int i = 0; i < static_cast<int>(SettingsManager::AVAILABLE_RESOLUTIONS.size()); ++i) {
+            m_options.resolutions.push_back(i);
+        }
+    }
+}
+
+bool SceneBenchmark::run() {
+    // Start lights and engine sounds would only add noise
+    AudioManager::getInstance().setEnabled(false);
+
+    const std::vector<TrackDefinition> tracks = TrackLibrary::getAllTracks();
+    std::vector<Scene> scenes;
+    for (Scene& scene : collectScenes(tracks)) {
+        if (m_options.filter.empty() || scene.name.find(m_options.filter) != std::string::npos) {
+            scenes.push_back(std::move(scene));
+        }
+    }
+
+    auto& settings = SettingsManager::getInstance();
+    const int previousResolution = settings.getCurrentResolutionIndex();
+    NullStreamBuf null;
+    std::streambuf* previousCout = std::cout.rdbuf(&null);
+    Logger::getInstance().setOutput(nullptr);
+
+    std::printf("%-22s %-10s %7s %8s %8s %8s %8s %8s %7s\n",
+                "scene", "resolution", "frames", "mean ms", "p50 ms", "p95 ms", "p99 ms", "max ms", "draws");
+    bool ok = true;
+    for (int index : m_options.resolutions) {
+        const SettingsManager::Resolution& resolution = SettingsManager::AVAILABLE_RESOLUTIONS[index];
+        const sf::Vector2u size(resolution.width, resolution.height);
+        settings.setResolution(index);
+
+        sf::RenderWindow window;
+        std::unique_ptr<RenderBackend> backend;
+        OffscreenRenderBackend* offscreen = nullptr;
+        if (m_options.offscreen) {
+            auto texture = std::make_unique<OffscreenRenderBackend>();
+            if (!texture->create(size)) {
+                std::cerr << "[BENCH] Failed to create a " << resolution.name << " render texture" << std::endl;
+                ok = false;
+                break;
+            }
+            offscreen = texture.get();
+            backend = std::move(texture);
+        } else {
+            window.create(sf::VideoMode(size), Config::WINDOW_TITLE, sf::State::Windowed);
+            window.setFramerateLimit(0);
+            window.setVerticalSyncEnabled(false);
+            backend = std::make_unique<SfmlRenderBackend>(window);
+        }
+        SceneTarget target{ m_options.offscreen ? nullptr : &window, offscreen, backend.get() };
+
+        for (const Scene& scene : scenes) {
+            std::optional<SceneBenchmarkResult> result = runScene(scene, size, target, m_options);
+            if (!result) {
+                std::cerr << "[BENCH] Window closed, scene benchmark aborted" << std::endl;
+                ok = false;
+                break;
+            }
+            char label[32];
+            std::snprintf(label, sizeof(label), "%ux%u", size.x, size.y);
+            std::printf("%-22s %-10s %7zu %8.3f %8.3f %8.3f %8.3f %8.3f %7.1f%s\n",
+                        result->scene.c_str(), label, result->frameMs.size(), result->meanMs, result->p50Ms,
+                        result->p95Ms, result->p99Ms, result->maxMs, result->drawCallsPerFrame,
+                        result->endedEarly ? "  (ended early)" : "");
+            std::fflush(stdout);
+            m_results.push_back(std::move(*result));
+        }
+        if (!ok) break;
+    }
+
+    settings.setResolution(previousResolution);
+    Logger::getInstance().flush();
+    Logger::getInstance().setOutput(stdout);
+    std::cout.rdbuf(previousCout);
+    AudioManager::getInstance().setEnabled(true);
+    return ok;
+}
+
+bool SceneBenchmark::writeJson(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    char number[64];
+    out << "{\n  \"machine\": " << MachineFingerprint::current().toJson();
+    out << ",\n  \"target\": \"" << (m_options.offscreen ? "offscreen" : "window") << "\"";
+    out << ",\n  \"seed\": " << m_options.seed;
+    out << ",\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < m_results.size(); ++i) {
+        const SceneBenchmarkResult& result = m_results[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": \"" << result.getName() << "\"";
+        out << ", \"scene\": \"" << result.scene << "\"";
+        out << ", \"width\": " << result.resolution.x << ", \"height\": " << result.resolution.y;
+        out << ", \"frames\": " << result.frameMs.size();
+        out << ", \"ended_early\": " << (result.endedEarly ? "true" : "false");
+        const double stats[] = { result.meanMs, result.p50Ms, result.p95Ms, result.p99Ms, result.maxMs };
+        const char* const names[] = { "mean_ms", "p50_ms", "p95_ms", "p99_ms", "max_ms" };
+        for (int s = 0; s < 5; ++s) {
+            std::snprintf(number, sizeof(number), "%.4f", stats[s]);
+            out << ", \"" << names[s] << "\": " << number;
+        }
+        std::snprintf(number, sizeof(number), "%.2f", result.drawCallsPerFrame);
+        out << ", \"draw_calls_per_frame\": " << number;
+        out << ", \"samples\": [";
+        for (std::size_t f = 0; f < result.frameMs.size(); ++f) {
+            std::snprintf(number, sizeof(number), "%.4f", result.frameMs[f]);
+            out << (f ? ", " : "") << number;
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Core/Random.h"
+
+struct SceneBenchmarkOptions {
+    int warmupFrames = 120;             // rendered but not measured (textures, glyphs, driver caches)
+    int frames = 600;                   // measured frames per scene and resolution
+    bool offscreen = false;             // render into a texture instead of a window (headless, software GL)
+    std::vector<int> resolutions;       // SettingsManager::AVAILABLE_RESOLUTIONS indices, empty = all
+    std::string filter;                 // only scenes whose name contains it
+    std::uint64_t seed = RandomConfig::DEFAULT_SEED;
+};
+
+struct SceneBenchmarkResult {
+    std::string scene;                  // track id, or endless_<difficulty>
+    sf::Vector2u resolution;
+    std::vector<double> frameMs;        // every measured frame in order (the JSON "samples")
+    double meanMs = 0.0;
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+    double drawCallsPerFrame = 0.0;
+    bool endedEarly = false;            // race finished or car destroyed before all frames ran
+
+    // "monaco_gp/1920x1080", the key used for baselines
+    std::string getName() const {
+        return scene + "/" + std::to_string(resolution.x) + "x" + std::to_string(resolution.y);
+    }
+};
+
+// --benchmark-scene: renders real frames of every TrackLibrary track and of
+// endless at each difficulty, at each supported resolution. The car is driven
+// by the autopilot one fixed tick per frame from a fixed seed, so every run
+// follows the same path through the same traffic whatever the frame rate.
+// VSync and the frame limit are off; a frame is timed from the tick to the
+// end of display(). The countdown is simulated without rendering.
+class SceneBenchmark {
+public:
+    explicit SceneBenchmark(const SceneBenchmarkOptions& options);
+
+    // Returns false if a render target could not be created or the window was closed
+    bool run();
+
+    const std::vector<SceneBenchmarkResult>& getResults() const { return m_results; }
+    bool writeJson(const std::string& path) const;
+
+private:
+    SceneBenchmarkOptions m_options;
+    std::vector<SceneBenchmarkResult> m_results;
+};
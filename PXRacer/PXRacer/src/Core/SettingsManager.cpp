@@ -1,4 +1,5 @@
 #include "SettingsManager.h"
+#include "Constants.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -30,6 +31,10 @@ SettingsManager::SettingsManager()
     , m_sfxVolume(50.0f)
     , m_musicMuted(false)
     , m_sfxMuted(false)
+    , m_simTickRate(Config::SIM_TICK_RATE)
+    , m_pipelinedSimulation(false)
+    , m_jobThreads(0)
+    , m_singleThreadedJobs(false)
 {
     std::cout << "[SettingsManager] Initialized with defaults" << std::endl;
 }
@@ -72,6 +77,10 @@ void SettingsManager::saveToFile(const std::string& filename) {
     file << "sfxVolume=" << m_sfxVolume << "\n";
     file << "musicMuted=" << (m_musicMuted ? "1" : "0") << "\n";
     file << "sfxMuted=" << (m_sfxMuted ? "1" : "0") << "\n";
+    file << "simTickRate=" << m_simTickRate << "\n";
+    file << "pipelinedSimulation=" << (m_pipelinedSimulation ? "1" : "0") << "\n";
+    file << "jobThreads=" << m_jobThreads << "\n";
+    file << "singleThreadedJobs=" << (m_singleThreadedJobs ? "1" : "0") << "\n";
 
     file.close();
     std::cout << "[SettingsManager] Settings saved to " << filename << std::endl;
@@ -126,6 +135,19 @@ void SettingsManager::loadFromFile(const std::string& filename) {
         else if (key == "sfxMuted") {
             m_sfxMuted = (value == "1");
         }
+        else if (key == "simTickRate") {
+            m_simTickRate = std::clamp(static_cast<unsigned int>(std::stoul(value)),
+                                       Config::MIN_SIM_TICK_RATE, Config::MAX_SIM_TICK_RATE);
+        }
+        else if (key == "pipelinedSimulation") {
+            m_pipelinedSimulation = (value == "1");
+        }
+        else if (key == "jobThreads") {
+            m_jobThreads = static_cast<unsigned int>(std::stoul(value));
+        }
+        else if (key == "singleThreadedJobs") {
+            m_singleThreadedJobs = (value == "1");
+        }
     }
 
     file.close();
@@ -162,3 +184,27 @@ void SettingsManager::setSfxMuted(bool muted) {
     m_sfxMuted = muted;
     std::cout << "[SettingsManager] SFX muted: " << (muted ? "ON" : "OFF") << std::endl;
 }
+
+// Set simulation tick rate (Hz)
+void SettingsManager::setSimTickRate(unsigned int hz) {
+    m_simTickRate = std::clamp(hz, Config::MIN_SIM_TICK_RATE, Config::MAX_SIM_TICK_RATE);
+    std::cout << "[SettingsManager] Simulation rate set to " << m_simTickRate << " Hz" << std::endl;
+}
+
+// Run gameplay ticks on a worker thread while the main thread renders
+void SettingsManager::setPipelinedSimulation(bool enabled) {
+    m_pipelinedSimulation = enabled;
+    std::cout << "[SettingsManager] Pipelined simulation: " << (enabled ? "ON" : "OFF") << std::endl;
+}
+
+// Worker threads of the shared job system
+void SettingsManager::setJobThreads(unsigned int threads) {
+    m_jobThreads = threads;
+    std::cout << "[SettingsManager] Job threads: " << (threads ? std::to_string(threads) : "auto") << std::endl;
+}
+
+// Run every job on the main thread in submission order (deterministic debugging)
+void SettingsManager::setSingleThreadedJobs(bool enabled) {
+    m_singleThreadedJobs = enabled;
+    std::cout << "[SettingsManager] Single-threaded jobs: " << (enabled ? "ON" : "OFF") << std::endl;
+}
@@ -29,6 +29,10 @@ public:
     float getSfxVolume() const { return m_sfxVolume; }
     bool isMusicMuted() const { return m_musicMuted; }
     bool isSfxMuted() const { return m_sfxMuted; }
+    unsigned int getSimTickRate() const { return m_simTickRate; }
+    bool isPipelinedSimulation() const { return m_pipelinedSimulation; }
+    unsigned int getJobThreads() const { return m_jobThreads; }
+    bool isSingleThreadedJobs() const { return m_singleThreadedJobs; }
 
     // Setters
     void setResolution(int index);
@@ -38,6 +42,10 @@ public:
     void setMasterVolume(float volume);
     void setMusicMuted(bool muted);
     void setSfxMuted(bool muted);
+    void setSimTickRate(unsigned int hz);   // clamped to Config::MIN/MAX_SIM_TICK_RATE
+    void setPipelinedSimulation(bool enabled);
+    void setJobThreads(unsigned int threads);   // 0 = one per hardware thread
+    void setSingleThreadedJobs(bool enabled);
 
     // Persistence (simple text file format)
     void loadFromFile(const std::string& filename = "settings.txt");
@@ -63,4 +71,10 @@ private:
     float m_masterVolume;
     bool m_musicMuted;
     bool m_sfxMuted;
+
+    // Simulation settings
+    unsigned int m_simTickRate;
+    bool m_pipelinedSimulation;
+    unsigned int m_jobThreads;
+    bool m_singleThreadedJobs;
 };
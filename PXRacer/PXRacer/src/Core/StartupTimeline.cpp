@@ -0,0 +1,67 @@
+#include "StartupTimeline.h"
+#include "Core/BenchmarkBaseline.h"
+#include <cstdio>
+#include <fstream>
+#include <ostream>
+
+StartupTimeline& StartupTimeline::getInstance() {
+    static StartupTimeline instance;
+    return instance;
+}
+
+void StartupTimeline::begin() {
+    if (m_started) return;
+    m_start = Clock::now();
+    m_started = true;
+}
+
+double StartupTimeline::elapsedMs() const {
+    return std::chrono::duration<double, std::milli>(Clock::now() - m_start).count();
+}
+
+void StartupTimeline::beginPhase(const char* name) {
+    if (hasFirstFrame()) return;
+    begin();
+    m_open.push_back(m_phases.size());
+    m_phases.push_back({ name, static_cast<int>(m_open.size()) - 1, elapsedMs(), 0.0 });
+}
+
+void StartupTimeline::endPhase() {
+    if (m_open.empty()) return;
+    StartupPhase& phase = m_phases[m_open.back()];
+    phase.durationMs = elapsedMs() - phase.startMs;
+    m_open.pop_back();
+}
+
+void StartupTimeline::markFirstFrame() {
+    if (hasFirstFrame() || !m_started) return;
+    while (!m_open.empty()) endPhase();
+    m_firstFrameMs = elapsedMs();
+}
+
+void StartupTimeline::print(std::ostream& out) const {
+    char line[128];
+    for (const StartupPhase& phase : m_phases) {
+        std::snprintf(line, sizeof(line), "[STARTUP] %*s%-*s %8.1f ms  (at %.1f ms)",
+                      phase.depth * 2, "", 28 - phase.depth * 2, phase.name, phase.durationMs, phase.startMs);
+        out << line << '\n';
+    }
+    std::snprintf(line, sizeof(line), "[STARTUP] Time to first frame: %.1f ms", m_firstFrameMs);
+    out << line << std::endl;
+}
+
+bool StartupTimeline::writeJson(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) return false;
+
+    char number[64];
+    out << "{\n  \"machine\": " << MachineFingerprint::current().toJson() << ",\n  \"benchmarks\": [";
+    std::snprintf(number, sizeof(number), "%.3f", m_firstFrameMs);
+    out << "\n    {\"name\": \"startup/time_to_first_frame\", \"samples\": [" << number << "]}";
+    for (const StartupPhase& phase : m_phases) {
+        std::snprintf(number, sizeof(number), "%.3f", phase.durationMs);
+        out << ",\n    {\"name\": \"startup/" << phase.name << "\", \"samples\": [" << number << "]}";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+struct StartupPhase {
+    const char* name;
+    int depth;              // nesting, for the printout
+    double startMs;         // since StartupTimeline::begin
+    double durationMs;
+};
+
+// Launch-to-first-frame timeline. Startup code wraps each phase in
+// STARTUP_PHASE("..."); Game closes the timeline when the first frame has
+// been displayed and prints it with the time to first frame. Main thread only.
+class StartupTimeline {
+public:
+    static StartupTimeline& getInstance();
+
+    // Time zero, first thing in main (otherwise the first phase starts the clock)
+    void begin();
+
+    void beginPhase(const char* name);
+    void endPhase();
+
+    // Closes the timeline; only the first call counts
+    void markFirstFrame();
+    bool hasFirstFrame() const { return m_firstFrameMs >= 0.0; }
+    double getTimeToFirstFrameMs() const { return m_firstFrameMs; }
+    const std::vector<StartupPhase>& getPhases() const { return m_phases; }
+
+    void print(std::ostream& out) const;
+    // Benchmark JSON (see Core/BenchmarkBaseline): one sample per phase and
+    // startup/time_to_first_frame
+    bool writeJson(const std::string& path) const;
+
+private:
+    StartupTimeline() = default;
+    double elapsedMs() const;
+
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point m_start;
+    bool m_started = false;
+    std::vector<StartupPhase> m_phases;     // in start order
+    std::vector<std::size_t> m_open;        // indices of the phases not ended yet
+    double m_firstFrameMs = -1.0;
+};
+
+class StartupPhaseScope {
+public:
+    explicit StartupPhaseScope(const char* name) { StartupTimeline::getInstance().beginPhase(name); }
+    ~StartupPhaseScope() { StartupTimeline::getInstance().endPhase(); }
+
+    StartupPhaseScope(const StartupPhaseScope&) = delete;
+    StartupPhaseScope& operator=(const StartupPhaseScope&) = delete;
+};
+
+#define PXRACER_STARTUP_JOIN2(a, b) a##b
+#define PXRACER_STARTUP_JOIN(a, b) PXRACER_STARTUP_JOIN2(a, b)
+#define STARTUP_PHASE(name) StartupPhaseScope PXRACER_STARTUP_JOIN(startupPhase_, __LINE__)(name)
@@ -0,0 +1,141 @@
+#include "TraceExporter.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    constexpr int TRACE_PID = 1;
+
+    std::string jsonEscape(const std::string& text) {
+        std::string out;
+        out.reserve(text.size());
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+    // Trace timestamps are microseconds
+    void writeMicros(std::ostream& out, std::uint64_t ns) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.3f", ns / 1000.0);
+        out << buffer;
+    }
+
+    void writeThreadName(std::ostream& out, std::size_t tid, const std::string& name) {
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << TRACE_PID << ",\"tid\":" << tid
+            << ",\"args\":{\"name\":\"" << jsonEscape(name) << "\"}}";
+    }
+}
+
+TraceExporter::TraceExporter() {
+    // Started here rather than in the initializer list: the loop uses members declared after m_writer
+    m_writer = std::thread([this]() { writerLoop(); });
+}
+
+TraceExporter::~TraceExporter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_wake.notify_all();
+    m_writer.join();
+}
+
+bool TraceExporter::capture(std::size_t frameCount, const std::string& path) {
+    Capture capture;
+    capture.path = path;
+
+    const Profiler& profiler = Profiler::getInstance();
+    profiler.getFrames(frameCount, capture.frames);
+    if (capture.frames.empty()) {
+        std::cout << "[TRACE] No profiled frames to capture" << std::endl;
+        return false;
+    }
+
+    const std::uint64_t start = capture.frames.front().start;
+    const std::uint64_t end = capture.frames.back().end;
+    profiler.getEvents(start, end, capture.events);
+    profiler.getCounters(start, end, capture.counters);
+    capture.threadNames = profiler.getThreadNames();
+
+    std::cout << "[TRACE] Capturing " << capture.frames.size() << " frames ("
+              << capture.events.size() << " scopes) to " << path << std::endl;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(capture));
+    }
+    m_wake.notify_one();
+    return true;
+}
+
+void TraceExporter::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return m_queue.empty() && !m_writing; });
+}
+
+void TraceExporter::writerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wake.wait(lock, [this]() { return !m_running || !m_queue.empty(); });
+        if (m_queue.empty()) return;   // stopping, nothing left to write
+
+        Capture capture = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_writing = true;
+        lock.unlock();
+
+        if (write(capture)) {
+            std::cout << "[TRACE] Wrote " << capture.path << std::endl;
+        } else {
+            std::cerr << "[TRACE] Failed to write " << capture.path << std::endl;
+        }
+
+        lock.lock();
+        m_writing = false;
+        m_idle.notify_all();
+    }
+}
+
+bool TraceExporter::write(const Capture& capture) {
+    std::ofstream out(capture.path);
+    if (!out) return false;
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (std::size_t tid = 0; tid < capture.threadNames.size(); ++tid) {
+        writeThreadName(out, tid, capture.threadNames[tid]);
+        out << ",\n";
+    }
+
+    // Frames get their own track above the threads
+    const std::size_t frameTid = capture.threadNames.size();
+    writeThreadName(out, frameTid, "Frames");
+    for (const ProfileFrame& frame : capture.frames) {
+        out << ",\n{\"name\":\"Frame " << frame.index << "\",\"ph\":\"X\",\"pid\":" << TRACE_PID
+            << ",\"tid\":" << frameTid << ",\"ts\":";
+        writeMicros(out, frame.start);
+        out << ",\"dur\":";
+        writeMicros(out, frame.end - frame.start);
+        out << "}";
+    }
+
+    for (const ProfileEvent& event : capture.events) {
+        out << ",\n{\"name\":\"" << jsonEscape(event.name) << "\",\"ph\":\"X\",\"pid\":" << TRACE_PID
+            << ",\"tid\":" << event.thread << ",\"ts\":";
+        writeMicros(out, event.start);
+        out << ",\"dur\":";
+        writeMicros(out, event.end - event.start);
+        out << ",\"args\":{\"depth\":" << event.depth << "}}";
+    }
+
+    for (const ProfileCounter& counter : capture.counters) {
+        out << ",\n{\"name\":\"" << jsonEscape(counter.name) << "\",\"ph\":\"C\",\"pid\":" << TRACE_PID
+            << ",\"ts\":";
+        writeMicros(out, counter.time);
+        out << ",\"args\":{\"value\":" << counter.value << "}}";
+    }
+
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
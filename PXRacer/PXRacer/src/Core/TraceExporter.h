@@ -0,0 +1,51 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Core/Profiler.h"
+
+// Writes captured profiler frames as Chrome trace-event JSON (chrome://tracing,
+// ui.perfetto.dev). capture() only copies the profiler history, which is cheap;
+// formatting and file I/O happen on the exporter's own thread so a capture
+// taken mid-race doesn't hitch the frame it is trying to show.
+class TraceExporter {
+public:
+    static constexpr std::size_t DEFAULT_FRAMES = 300;
+
+    TraceExporter();
+    ~TraceExporter();     // finishes pending writes
+
+    TraceExporter(const TraceExporter&) = delete;
+    TraceExporter& operator=(const TraceExporter&) = delete;
+
+    // Queues the last frameCount frames (scopes of every thread plus counters)
+    // to be written to path. Main thread. Returns false if nothing was captured.
+    bool capture(std::size_t frameCount, const std::string& path);
+
+    // Blocks until every queued capture is on disk
+    void flush();
+
+private:
+    struct Capture {
+        std::string path;
+        std::vector<ProfileFrame> frames;
+        std::vector<ProfileEvent> events;
+        std::vector<ProfileCounter> counters;
+        std::vector<std::string> threadNames;
+    };
+
+    void writerLoop();
+    static bool write(const Capture& capture);
+
+    std::thread m_writer;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::deque<Capture> m_queue;
+    bool m_writing = false;
+    bool m_running = true;
+};
@@ -0,0 +1,56 @@
+#include "Autopilot.h"
+#include "Road.h"
+#include <algorithm>
+#include <cmath>
+
+Autopilot::Autopilot(float targetX, float aggression)
+    : m_targetX(0.0f)
+    , m_aggression(0.5f)
+{
+    setTargetX(targetX);
+    setAggression(aggression);
+}
+
+void Autopilot::setTargetX(float targetX) {
+    m_targetX = std::clamp(targetX, -AutopilotConfig::MAX_TARGET_X, AutopilotConfig::MAX_TARGET_X);
+}
+
+void Autopilot::setAggression(float aggression) {
+    m_aggression = std::clamp(aggression, 0.0f, 1.0f);
+}
+
+InputSnapshot Autopilot::computeInput(const Road& road, const Player& player) const {
+    return computeInput(road, player.getZ(), player.getX(), player.getSpeed());
+}
+
+InputSnapshot Autopilot::computeInput(const Road& road, float z, float x, float speed) const {
+    using namespace AutopilotConfig;
+
+    InputSnapshot input;
+    const float speedRatio = speed / PlayerConfig::MAX_SPEED;
+
+    // Steering: close the lateral error at a fixed rate and cancel the sideways
+    // push the curve under the car will apply this tick (feed-forward)
+    const float nearCurve = road.getCurveAhead(z, NEAR_LOOKAHEAD) / NEAR_LOOKAHEAD;
+    const float drift = nearCurve * speedRatio * CURVE_DRIFT;
+    const float wantedVelocity = (m_targetX - x) * STEER_RESPONSE - drift;
+    const float steer = std::clamp(wantedVelocity / PlayerConfig::STEER_SPEED, -1.0f, 1.0f);
+    input.steer = std::abs(steer) > STEER_DEADZONE ? steer : 0.0f;
+
+    // Speed: the sharper of the corner entry and the next corner sets the target
+    const float entryCurve = std::abs(road.getCurveAhead(z, CORNER_LOOKAHEAD)) / CORNER_LOOKAHEAD;
+    const float farCurve = std::abs(road.getCurveAhead(z, FAR_LOOKAHEAD)) / FAR_LOOKAHEAD;
+    const float severity = std::min(1.0f, std::max(entryCurve, farCurve) / CORNER_REFERENCE_CURVE);
+
+    const float slowdown = CORNER_SLOWDOWN * (1.0f - 0.5f * m_aggression);
+    const float targetSpeed = PlayerConfig::MAX_SPEED * (1.0f - slowdown * severity);
+
+    if (speed > targetSpeed + BRAKE_MARGIN) {
+        input.brake = std::clamp((speed - targetSpeed) / (BRAKE_MARGIN * 2.0f), 0.0f, 1.0f);
+    } else if (speed < targetSpeed) {
+        input.throttle = std::clamp((targetSpeed - speed) / BRAKE_MARGIN, 0.25f, 1.0f);
+    }
+    // Between target and margin: coast
+
+    return input;
+}
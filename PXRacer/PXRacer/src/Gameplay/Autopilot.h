@@ -0,0 +1,40 @@
+#pragma once
+#include "Player.h"
+
+class Road;
+
+namespace AutopilotConfig {
+    constexpr int NEAR_LOOKAHEAD = 3;              // segments averaged to cancel curve drift
+    constexpr int CORNER_LOOKAHEAD = 10;           // corner entry (~1 s at top speed)
+    constexpr int FAR_LOOKAHEAD = 25;              // next corner, early enough to brake
+    constexpr float CURVE_DRIFT = 45.0f;           // matches Player::applyPhysics
+    constexpr float STEER_RESPONSE = 6.0f;         // 1/s, how fast lateral error is closed
+    constexpr float STEER_DEADZONE = 0.02f;        // ignore tiny corrections (no jitter)
+
+    constexpr float CORNER_REFERENCE_CURVE = 3.0f; // average curve considered a hard corner
+    constexpr float CORNER_SLOWDOWN = 0.35f;       // speed fraction dropped for a hard corner
+    constexpr float BRAKE_MARGIN = 6.0f;           // brake only when this far above target
+
+    constexpr float MAX_TARGET_X = 600.0f;         // keep a car width away from the grass
+}
+
+// Bot driver: turns the road ahead into an InputSnapshot.
+// Stateless and allocation free, so one instance can drive any number of cars
+// (headless sim, render benchmarks, attract mode).
+class Autopilot {
+public:
+    // targetX: preferred lateral position, aggression: 0..1 scales corner speed
+    explicit Autopilot(float targetX = 0.0f, float aggression = 0.5f);
+
+    InputSnapshot computeInput(const Road& road, float z, float x, float speed) const;
+    InputSnapshot computeInput(const Road& road, const Player& player) const;
+
+    void setTargetX(float targetX);
+    float getTargetX() const { return m_targetX; }
+    void setAggression(float aggression);
+    float getAggression() const { return m_aggression; }
+
+private:
+    float m_targetX;
+    float m_aggression;
+};
@@ -1,4 +1,5 @@
 ﻿#include "CurveProcessor.h"
+#include "Core/Profiler.h"
 #include <algorithm>
 #include <cmath>
 
@@ -6,9 +7,11 @@ CurveProcessor::CurveData CurveProcessor::processSegmentCurves(
     const std::vector<float>& segmentCurves,
     int baseSegmentIndex,
     int drawDistance,
-    float cameraPosition
+    float cameraPosition,
+    std::pmr::memory_resource* memory
 ) {
-    CurveData result;
+    PROFILE_SCOPE("CurveProcessor::processSegmentCurves");
+    CurveData result(memory);
     
     const int totalSamples = drawDistance * SAMPLES_PER_SEGMENT;
     result.accumulatedCurves.resize(totalSamples + 1, 0.0f);
@@ -16,13 +19,6 @@ CurveProcessor::CurveData CurveProcessor::processSegmentCurves(
     
     const int trackLength = static_cast<int>(segmentCurves.size());
     
-    // Wrap-around smoothing for seamless looping!
-    // Calculate accumulated curve absolute from track start
-    float baseAccumulation = 0.0f;
-    for (int i = 0; i < baseSegmentIndex % trackLength; ++i) {
-        baseAccumulation += segmentCurves[i];
-    }
-    
     // Accumulate with wrap-around for seamless looping
     float runningCurve = 0.0f;
     for (int n = 0; n <= totalSamples; ++n) {
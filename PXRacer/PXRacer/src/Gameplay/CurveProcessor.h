@@ -1,21 +1,29 @@
 ﻿#pragma once
+#include <memory_resource>
 #include <vector>
 
 // CurveProcessor - Responsible for curve mathematics and accumulation
 class CurveProcessor {
 public:
     struct CurveData {
-        std::vector<float> accumulatedCurves;  // Accumulated high-res curves
-        float cameraOffset;                     // Offset for camera centering
-        int baseSamples;                        // Number of samples
+        std::pmr::vector<float> accumulatedCurves;  // Accumulated high-res curves
+        float cameraOffset;                          // Offset for camera centering
+        int baseSamples;                             // Number of samples
+
+        explicit CurveData(std::pmr::memory_resource* memory)
+            : accumulatedCurves(memory), cameraOffset(0.0f), baseSamples(0) {}
     };
 
-    // Calculates accumulated curves with Catmull-Rom interpolation
+    // Calculates accumulated curves with Catmull-Rom interpolation.
+    // segmentCurves is a window of the road (the whole road when it is short
+    // enough); indices wrap around it. The samples are allocated from memory
+    // (the frame arena when rendering).
     static CurveData processSegmentCurves(
         const std::vector<float>& segmentCurves,
         int baseSegmentIndex,
         int drawDistance,
-        float cameraPosition
+        float cameraPosition,
+        std::pmr::memory_resource* memory = std::pmr::get_default_resource()
     );
 
     
@@ -52,6 +52,7 @@
             int lapsWithoutDamage = 0;
             int repairPickupsCollected = 0;
             float highscoreKm = 0.0f;
+            float damageTaken = 0.0f;       // total pothole damage, before repairs
             
             void reset() {
                 totalDistance = 0.0f;
@@ -64,6 +65,7 @@
                 lapsWithoutDamage = 0;
                 repairPickupsCollected = 0;
                 highscoreKm = 0.0f;
+                damageTaken = 0.0f;
             }
         };
 
@@ -257,8 +259,9 @@
         // Campaign data manager
         class CampaignDataManager {
         public:
-            static std::vector<CampaignTrackData> getTracks() {
-                return {
+            // Built on first use
+            static const std::vector<CampaignTrackData>& getTracks() {
+                static const std::vector<CampaignTrackData> tracks = {
                     // Easy tracks (1 task required)
                     createTrack(1, "countryside", "COUNTRYSIDE", 
                         "A scenic route through rolling hills",
@@ -334,6 +337,7 @@
                             CampaignTask(3, CampaignTaskType::NoDamage, 0.0f, "Finish without taking damage")
                         })
                 };
+                return tracks;
             }
             
             static std::string getTaskProgress(const CampaignTask& task, const CampaignProgress& progress) {
@@ -1,5 +1,9 @@
 ﻿#include "GameplayManager.h"
 #include "TrackBuilder.h"
+#include "Rendering/RenderCommandBuffer.h"
+#include "Core/Constants.h"
+#include "Core/Profiler.h"
+#include "Core/Logger.h"
 #include <iostream>
 #include <cmath>
 
@@ -14,9 +18,16 @@ constexpr float BOOST_DURATION = 2.0f;
 constexpr float PERFECT_BOOST = 2.0f;
 constexpr float GOOD_BOOST = 1.5f;
 constexpr float JUMP_START_PENALTY = 3.0f;
+constexpr float MAX_BOOSTED_SPEED = PlayerConfig::MAX_SPEED * 1.1f;
 
-GameplayManager::GameplayManager(GameMode mode, const TrackDefinition* track)
+// The road render snapshot starts one segment behind the older of the two
+// poses it is drawn between (Road::captureRenderState)
+static_assert(MAX_BOOSTED_SPEED / Config::MIN_SIM_TICK_RATE < RoadConfig::SEGMENT_LENGTH,
+              "the camera must move less than a segment per tick");
+
+GameplayManager::GameplayManager(GameMode mode, const TrackDefinition* track, std::uint64_t seed)
     : m_mode(mode)
+    , m_random(seed)
     , m_raceStarted(false)
     , m_countdownPhase(CountdownPhase::Ready)
     , m_countdownTimer(0.0f)
@@ -35,6 +46,8 @@ GameplayManager::GameplayManager(GameMode mode, const TrackDefinition* track)
 {
     m_boostResult = {false, false, false, false, 1.0f};
     m_difficultySettings = EndlessDifficultySettings::getSettings(m_endlessDifficulty);
+    m_road.setRandomStream(m_random.stream("road"));
+    std::cout << "[RACE] Session seed: " << seed << std::endl;
     
     if (track) {
         std::cout << "[RACE] Building track: " << track->name << std::endl;
@@ -53,8 +66,9 @@ GameplayManager::GameplayManager(GameMode mode, const TrackDefinition* track)
 }
 
 // Constructor for Endless with difficulty
-GameplayManager::GameplayManager(GameMode mode, EndlessDifficultyLevel difficulty)
+GameplayManager::GameplayManager(GameMode mode, EndlessDifficultyLevel difficulty, std::uint64_t seed)
     : m_mode(mode)
+    , m_random(seed)
     , m_raceStarted(false)
     , m_countdownPhase(CountdownPhase::Ready)
     , m_countdownTimer(0.0f)
@@ -73,8 +87,10 @@ GameplayManager::GameplayManager(GameMode mode, EndlessDifficultyLevel difficult
 {
     m_boostResult = {false, false, false, false, 1.0f};
     m_difficultySettings = EndlessDifficultySettings::getSettings(difficulty);
+    m_road.setRandomStream(m_random.stream("road"));
+    std::cout << "[ENDLESS] Session seed: " << seed << std::endl;
     
-    initializeEndless(difficulty);
+    initializeEndless();
     m_trackName = "Endless - " + m_difficultySettings.name;
     
     m_countdownTimer = 1.0f;
@@ -86,7 +102,7 @@ GameplayManager::GameplayManager(GameMode mode, EndlessDifficultyLevel difficult
 void GameplayManager::initializeForMode() {
     switch (m_mode) {
         case GameMode::Endless:
-            m_road.generateWithDifficulty(500, m_endlessDifficulty);
+            m_road.generateStreaming(EndlessDifficultySettings::getSettings(m_endlessDifficulty));
             break;
         case GameMode::Campaign:
             m_road.generate(200);
@@ -95,14 +111,17 @@ void GameplayManager::initializeForMode() {
             m_road.generate(300);
             break;
     }
-    m_traffic.init(m_road.getLength());
+    m_traffic.init(m_road.getLength(), m_random.stream("traffic"));
 }
 
-// Initialize Endless mode with specific difficulty
-void GameplayManager::initializeEndless(EndlessDifficultyLevel difficulty) {
-    m_road.generateWithDifficulty(500, difficulty);
-    m_traffic.init(m_road.getLength());
+// Initialize Endless mode from m_difficultySettings
+void GameplayManager::initializeEndless() {
+    m_road.generateStreaming(m_difficultySettings);
+    m_traffic.init(m_road.getLength(), m_random.stream("traffic"));
     m_stats = EndlessStats{};  // Reset stats
+    m_originDistance = 0.0;
+    m_drivenDistance = 0.0;
+    m_lastCheckpointDistance = 0.0;
     m_lapStartDamage = 0.0f;
     m_lapHadDamage = false;
 }
@@ -110,7 +129,7 @@ void GameplayManager::initializeEndless(EndlessDifficultyLevel difficulty) {
 void GameplayManager::loadTrack(const TrackDefinition& track) {
     TrackBuilder::buildTrack(m_road, track);
     std::cout << "[TRACK] " << track.name << " loaded (" << track.lengthKm << " km)" << std::endl;
-    m_traffic.init(m_road.getLength());
+    m_traffic.init(m_road.getLength(), m_random.stream("traffic"));
 }
 
 void GameplayManager::updateCountdown(float deltaTime) {
@@ -163,10 +182,9 @@ void GameplayManager::updateCountdown(float deltaTime) {
             }
             break;
         case CountdownPhase::Go:
-            static bool goSoundPlayed = false;
-            if (!goSoundPlayed) {
+            if (!m_goSoundPlayed) {
                 AudioManager::getInstance().playSfx("countdown_go");
-                goSoundPlayed = true;
+                m_goSoundPlayed = true;
             }
 
             m_boostWindowTimer -= deltaTime;
@@ -217,7 +235,29 @@ void GameplayManager::handleStartInput(bool clutchPressed) {
 void GameplayManager::applyStartBoost() {
 }
 
+void GameplayManager::setDifficultySettings(const EndlessDifficultySettings& settings) {
+    if (m_mode != GameMode::Endless || m_raceStarted) return;
+
+    m_difficultySettings = settings;
+
+    // Fresh streams so the result matches a session created with these settings
+    m_road.setRandomStream(m_random.stream("road"));
+    initializeEndless();
+}
+
+void GameplayManager::setInput(const InputSnapshot& input) {
+    m_player.setInput(input);
+    if (input.clutch) {
+        handleStartInput(true);
+    }
+}
+
 void GameplayManager::update(float deltaTime) {
+    PROFILE_SCOPE("GameplayManager::update");
+    // Keep last tick's positions for render interpolation
+    m_player.savePreviousState();
+    m_traffic.savePreviousState();
+
     if (!m_raceStarted || m_countdownPhase == CountdownPhase::Go) {
         updateCountdown(deltaTime);
     }
@@ -242,8 +282,7 @@ void GameplayManager::update(float deltaTime) {
     m_currentLapTime += deltaTime;
     
     WheelSurfaces wheelSurfaces = getWheelSurfaces();
-    const RoadSegment* segment = m_road.getSegmentAt(m_player.getZ());
-    float roadCurve = segment ? segment->curve : 0.0f;
+    float roadCurve = m_road.getCurveAt(m_player.getZ());
     m_player.update(deltaTime, wheelSurfaces, roadCurve);
 
     m_traffic.update(deltaTime, m_road.getLength(), m_player.getZ(), m_player.getSpeed());
@@ -265,7 +304,7 @@ void GameplayManager::update(float deltaTime) {
     if (m_currentBoostMultiplier > 1.0f && m_activeBoostTimer > 0.0f) {
         float currentSpeed = m_player.getSpeed();
         float boostedSpeed = currentSpeed + (PlayerConfig::ACCELERATION * (m_currentBoostMultiplier - 1.0f) * deltaTime);
-        m_player.setSpeed(std::min(boostedSpeed, PlayerConfig::MAX_SPEED * 1.1f));
+        m_player.setSpeed(std::min(boostedSpeed, MAX_BOOSTED_SPEED));
     }
     
     // Add call to handleTrackLooping() to detect finish line crossing
@@ -293,8 +332,9 @@ void GameplayManager::checkPotholeCollisions() {
         m_road.checkPotholeCollision(rrX, rrZ, damage)) {
         
         m_player.addDamage(damage);
+        m_stats.damageTaken += damage;
         m_lapHadDamage = true;  // Track damage for bonus
-        std::cout << "[POTHOLE] Hit! Damage: " << damage << std::endl;
+        LOG_DEBUG(LogCategory::Race, "Pothole hit! Damage: %g", damage);
     }
 }
 
@@ -303,12 +343,12 @@ void GameplayManager::checkRepairPickups() {
     float healAmount = 0.0f;
     
     if (m_road.checkRepairPickupCollision(m_player.getX(), m_player.getZ(), healAmount)) {
-        float oldDamage = m_player.getTotalDamage();
+        [[maybe_unused]] float oldDamage = m_player.getTotalDamage();
         m_player.repair(healAmount);
         m_stats.repairPickupsCollected++;
         
-        std::cout << "[REPAIR] Collected! Healed " << healAmount 
-                  << " DMG (" << oldDamage << " -> " << m_player.getTotalDamage() << ")" << std::endl;
+        LOG_DEBUG(LogCategory::Race, "Repair collected! Healed %g DMG (%g -> %g)",
+                  healAmount, oldDamage, m_player.getTotalDamage());
     }
 }
 
@@ -332,14 +372,12 @@ void GameplayManager::handleTrackLooping() {
             // Track perfect laps
             if (m_campaignProgress.currentLapPerfect) {
                 m_campaignProgress.perfectLapsCount++;
-                std::cout << "[CAMPAIGN] Perfect lap! Total: " 
-                          << m_campaignProgress.perfectLapsCount << std::endl;
+                LOG_INFO(LogCategory::Race, "Campaign: perfect lap! Total: %d", m_campaignProgress.perfectLapsCount);
             }
             m_campaignProgress.currentLapPerfect = true;  // Reset for next lap
             
-            std::cout << "[CAMPAIGN] Lap " << m_campaignProgress.currentLap 
-                      << "/" << m_campaignProgress.totalLaps 
-                      << " | Time: " << m_currentLapTime << "s" << std::endl;
+            LOG_INFO(LogCategory::Race, "Campaign: lap %d/%d | Time: %gs",
+                     m_campaignProgress.currentLap, m_campaignProgress.totalLaps, m_currentLapTime);
                       
             // Check if race finished
             checkCampaignObjective();
@@ -360,7 +398,7 @@ void GameplayManager::handleTrackLooping() {
             if (isNewBestLap && m_lapCount > 0) {
                 float bestLapBonus = 100.0f * m_difficultySettings.bonusMultiplier;
                 m_stats.currentScore += bestLapBonus;
-                std::cout << "[NEW BEST LAP] Bonus! +" << bestLapBonus << " points!" << std::endl;
+                LOG_INFO(LogCategory::Race, "New best lap bonus! +%g points!", bestLapBonus);
             }
             
             // Check for bonus lap without damage
@@ -368,7 +406,7 @@ void GameplayManager::handleTrackLooping() {
                 m_stats.lapsWithoutDamage++;
                 float bonus = EndlessConfigValues::NO_DAMAGE_LAP_BONUS * m_difficultySettings.bonusMultiplier;
                 m_stats.currentScore += bonus;
-                std::cout << "[LAP BONUS] No damage! +" << bonus << " points!" << std::endl;
+                LOG_INFO(LogCategory::Race, "Lap bonus: no damage! +%g points!", bonus);
             }
         }
         
@@ -378,12 +416,15 @@ void GameplayManager::handleTrackLooping() {
         m_currentLapTime = 0.0f;
         m_lapCount++;
         
-        float overflow = playerZ - roadLength;
-        m_player.setZ(overflow);
+        shiftWorldOrigin(-roadLength);
         
         // Only for Endless mode - regenerate obstacles
         if (m_mode == GameMode::Endless) {
-            m_road.resetPotholes();
+            // A streamed road is already new ahead; its hazards go with the recycled segments
+            if (!m_road.isStreaming()) {
+                m_road.setLap(m_lapCount);
+                m_road.resetPotholes();
+            }
             m_road.regeneratePickupsForDamage(m_player.getTotalDamage());
         }
         
@@ -391,15 +432,24 @@ void GameplayManager::handleTrackLooping() {
         m_lapStartDamage = m_player.getTotalDamage();
         m_lapHadDamage = false;
         
-        std::cout << "[LAP " << m_lapCount << "] Time: " << m_lastLapTime 
-                  << "s, Score: " << m_stats.currentScore << std::endl;
+        LOG_INFO(LogCategory::Race, "Lap %d time: %gs, Score: %g", m_lapCount, m_lastLapTime, m_stats.currentScore);
                   
     } else if (playerZ < 0.0f) {
-        float underflow = playerZ + roadLength;
-        m_player.setZ(underflow);
+        shiftWorldOrigin(roadLength);
     }
 }
 
+// Floating origin: world Z is kept within a lap of zero, where a float still
+// resolves small fractions of a unit, however far the run goes. Everything
+// holding a world Z moves here; distances since the start are doubles
+// measured from m_originDistance and stay put.
+void GameplayManager::shiftWorldOrigin(float offset) {
+    m_player.rebaseZ(offset);
+    m_originDistance -= offset;
+    // Traffic wraps into [0, trackLength) by itself and road segments and
+    // hazards are indexed modulo the lap, so a whole-lap shift leaves them as is
+}
+
 void GameplayManager::calculateLapScore() {
     float baseScore = 100.0f;
     float multiplier = 1.0f;
@@ -414,9 +464,9 @@ void GameplayManager::calculateLapScore() {
             multiplier = 1.0f + (delta * 0.5f);
             multiplier = std::min(multiplier, 5.0f);  // Cap at 5x
             
-            std::cout << "[LAP SCORE] " << delta << "s faster! Multiplier: " << multiplier << "x" << std::endl;
+            LOG_INFO(LogCategory::Race, "Lap score: %gs faster! Multiplier: %gx", delta, multiplier);
         } else {
-            std::cout << "[LAP SCORE] " << (-delta) << "s slower. Base score only." << std::endl;
+            LOG_INFO(LogCategory::Race, "Lap score: %gs slower. Base score only.", -delta);
         }
     }
     
@@ -425,7 +475,7 @@ void GameplayManager::calculateLapScore() {
     
     m_lapScoreMultiplier = multiplier;
     
-    std::cout << "[LAP SCORE] +" << finalScore << " points" << std::endl;
+    LOG_INFO(LogCategory::Race, "Lap score: +%g points", finalScore);
 }
 
 WheelSurfaces GameplayManager::getWheelSurfaces() const {
@@ -442,8 +492,7 @@ WheelSurfaces GameplayManager::getWheelSurfaces() const {
 }
 
 SurfaceType GameplayManager::getSurfaceTypeAt(float x, float z) const {
-    const RoadSegment* segment = m_road.getSegmentAt(z);
-    if (!segment) return SurfaceType::OffTrack;
+    if (m_road.getSegmentIndex(z) < 0) return SurfaceType::OffTrack;
     
     const float roadHalfWidth = RoadConfig::ROAD_WIDTH * 0.5f;
     
@@ -478,7 +527,8 @@ void GameplayManager::updateEndlessScoring(float deltaTime) {
     float speed = m_player.getSpeed();
     float speedKmh = speed * MS_TO_KMH;
     
-    m_stats.totalDistance += speed * deltaTime;
+    m_drivenDistance += speed * deltaTime;
+    m_stats.totalDistance = static_cast<float>(m_drivenDistance);
     m_stats.topSpeed = std::max(m_stats.topSpeed, speedKmh);
     
     // Calculate average speed
@@ -487,31 +537,32 @@ void GameplayManager::updateEndlessScoring(float deltaTime) {
     }
     
     // Update highscore (in km traveled)
-    float currentKm = getDistanceKm() + (m_lapCount * m_road.getLength() / 1000.0f);
+    float currentKm = static_cast<float>(getRunDistance() * UNITS_PER_METER / 1000.0);
     if (currentKm > m_stats.highscoreKm) {
         m_stats.highscoreKm = currentKm;
     }
 }
 
 void GameplayManager::updateDifficultyProgression() {
-    float distanceKm = getDistanceKm();
+    // Whole run, not just this lap - the road ahead ramps up with it
+    double distanceKm = getRunDistance() * UNITS_PER_METER / 1000.0;
     
-    int newLevel = 1 + static_cast<int>(distanceKm / 10.0f);
+    int newLevel = 1 + static_cast<int>(distanceKm / 10.0);
     newLevel = std::min(newLevel, 10);
     
     if (newLevel != m_difficulty.level) {
         m_difficulty.level = newLevel;
+        m_difficulty.curveMultiplier = 1.0f + 0.05f * (newLevel - 1);
+        m_road.setStreamDifficulty(m_difficulty);
     }
 }
 
 void GameplayManager::checkCheckpoints() {
-    float playerZ = m_player.getZ();
-    float roadLength = m_road.getLength();
-    float effectiveDistance = playerZ + (m_lapCount * roadLength);
+    const double runDistance = getRunDistance();
     
-    if (effectiveDistance - m_lastCheckpointZ >= m_checkpointInterval) {
+    if (runDistance - m_lastCheckpointDistance >= m_checkpointInterval) {
         m_stats.checkpointsReached++;
-        m_lastCheckpointZ = effectiveDistance;
+        m_lastCheckpointDistance = runDistance;
         
         float bonus = 1000.0f * m_difficulty.level * m_difficultySettings.bonusMultiplier;
         m_stats.currentScore += bonus;
@@ -519,10 +570,10 @@ void GameplayManager::checkCheckpoints() {
 }
 
 void GameplayManager::evaluateCornerPerformance() {
-    const RoadSegment* segment = m_road.getSegmentAt(m_player.getZ());
-    if (!segment) return;
+    const int segment = m_road.getSegmentIndex(m_player.getZ());
+    if (segment < 0) return;
     
-    bool isInCurve = std::abs(segment->curve) > 0.1f;
+    bool isInCurve = std::abs(m_road.getSegmentCurve(segment)) > 0.1f;
     
     if (isInCurve && !m_inCorner) {
         m_inCorner = true;
@@ -541,14 +592,43 @@ void GameplayManager::evaluateCornerPerformance() {
     }
 }
         
-void GameplayManager::render(sf::RenderWindow& window) {
-    m_road.render(window, m_player.getZ());
+void GameplayManager::captureRenderState(GameplayRenderState& out) const {
+    out.player = m_player.getPose();
+    m_road.captureRenderState(std::min(out.player.previousZ, out.player.z), out.road);
+    out.traffic.assign(m_traffic.getCars().begin(), m_traffic.getCars().end());
+    out.trackLength = m_road.getLength();
+
+    HudState& hud = out.hud;
+    hud.mode = m_mode;
+    hud.countdownPhase = m_countdownPhase;
+    hud.boostResult = m_boostResult;
+    hud.speedKmh = getPlayerSpeedKmh();
+    hud.damage = m_player.getTotalDamage();
+    hud.currentLapTime = m_currentLapTime;
+    hud.bestLapTime = m_bestLapTime;
+    hud.lastLapTime = m_lastLapTime;
+    hud.lapCount = m_lapCount;
+    hud.stats = m_stats;
+    hud.campaignProgress = m_campaignProgress;
+    hud.campaignTrack = m_campaignTrack;
+    hud.gameOver = isGameOver();
+    hud.raceFinished = m_raceFinished;
+    hud.objectiveCompleted = m_objectiveCompleted;
+}
+
+void GameplayManager::render(RenderCommandBuffer& commands, const GameplayRenderState& state, float alpha) {
+    PROFILE_SCOPE("GameplayManager::render");
+    // Camera follows the player, interpolated between the last two ticks
+    const float cameraZ = state.player.interpolatedZ(alpha);
+    const float cameraX = state.player.interpolatedX(alpha);
+
+    m_road.render(commands, cameraZ, state.road);
 
    
-    m_traffic.render(window, m_player.getZ(), m_player.getX());
-    const float playerScreenX = window.getSize().x * 0.5f + (m_player.getX() / RoadConfig::ROAD_WIDTH) * window.getSize().x * 0.5f;
-    const float playerScreenY = window.getSize().y * 0.85f;
-    m_player.render(window, playerScreenX, playerScreenY, 1.0f);
+    m_traffic.render(commands, state.traffic, state.trackLength, cameraZ, cameraX, alpha);
+    const float playerScreenX = commands.getSize().x * 0.5f + (cameraX / RoadConfig::ROAD_WIDTH) * commands.getSize().x * 0.5f;
+    const float playerScreenY = commands.getSize().y * 0.85f;
+    m_player.render(commands, state.player, playerScreenX, playerScreenY, 1.0f);
 }
 
 float GameplayManager::getPlayerSpeed() const {
@@ -559,6 +639,10 @@ float GameplayManager::getDistance() const {
     return m_player.getZ();
 }
 
+double GameplayManager::getRunDistance() const {
+    return m_originDistance + m_player.getZ();
+}
+
 GameMode GameplayManager::getGameMode() const {
     return m_mode;
 }
@@ -567,6 +651,7 @@ GameMode GameplayManager::getGameMode() const {
 
 void GameplayManager::setCampaignTrack(const CampaignTrack& track) {
     m_campaignTrack = track;
+    m_road.setPalette(RoadPalette::getPalette(track.trackId));
     m_campaignProgress.reset();
     m_campaignProgress.totalLaps = track.requiredLaps;
     m_objectiveCompleted = false;
@@ -596,16 +681,14 @@ void GameplayManager::updateCampaignProgress(float deltaTime) {
     
     // Track spinouts
     if (m_player.isSpinning()) {
-        static bool wasSpinning = false;
-        if (!wasSpinning) {
+        if (!m_wasSpinning) {
             m_campaignProgress.spinoutCount++;
             m_campaignProgress.currentLapPerfect = false;
-            std::cout << "[CAMPAIGN] Spinout! Count: " << m_campaignProgress.spinoutCount << std::endl;
+            LOG_DEBUG(LogCategory::Race, "Campaign: spinout! Count: %d", m_campaignProgress.spinoutCount);
         }
-        wasSpinning = true;
+        m_wasSpinning = true;
     } else {
-        static bool wasSpinning = false;
-        wasSpinning = false;
+        m_wasSpinning = false;
     }
     
     // Track off-track
@@ -616,16 +699,14 @@ void GameplayManager::updateCampaignProgress(float deltaTime) {
                              surfaces.rearRight == SurfaceType::OffTrack);
     
     if (anyWheelOffTrack) {
-        static bool wasOffTrack = false;
-        if (!wasOffTrack) {
+        if (!m_wasOffTrack) {
             m_campaignProgress.offTrackCount++;
             m_campaignProgress.currentLapPerfect = false;
-            std::cout << "[CAMPAIGN] Off track! Count: " << m_campaignProgress.offTrackCount << std::endl;
+            LOG_DEBUG(LogCategory::Race, "Campaign: off track! Count: %d", m_campaignProgress.offTrackCount);
         }
-        wasOffTrack = true;
+        m_wasOffTrack = true;
     } else {
-        static bool wasOffTrack = false;
-        wasOffTrack = false;
+        m_wasOffTrack = false;
     }
     
     // Check objective in real-time
@@ -638,7 +719,7 @@ void GameplayManager::checkCampaignObjective() {
     if (selectedTask && m_campaignProgress.checkTask(*selectedTask)) {
         if (!m_objectiveCompleted) {
             m_objectiveCompleted = true;
-            std::cout << "[CAMPAIGN] TASK COMPLETED!" << std::endl;
+            LOG_INFO(LogCategory::Race, "Campaign: TASK COMPLETED!");
         }
     }
     
@@ -646,7 +727,7 @@ void GameplayManager::checkCampaignObjective() {
     if (m_campaignProgress.currentLap >= m_campaignProgress.totalLaps) {
         if (!m_raceFinished) {
             m_raceFinished = true;
-            std::cout << "[CAMPAIGN] RACE FINISHED!" << std::endl;
+            LOG_INFO(LogCategory::Race, "Campaign: RACE FINISHED!");
         }
     }
 }
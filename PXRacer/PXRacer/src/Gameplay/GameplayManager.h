@@ -4,6 +4,7 @@
 #include "GameModeConfig.h"
 #include "TrackDefinition.h"
 #include "TrafficSystem.h"
+#include "../Core/Random.h"
 #include "../Core/AudioManager.h"
 
 enum class CountdownPhase {
@@ -25,13 +26,58 @@ struct StartBoostResult {
     float boostMultiplier;
 };
 
+// Everything GameHUD shows, copied out of the simulation once per frame
+struct HudState {
+    GameMode mode = GameMode::Endless;
+    CountdownPhase countdownPhase = CountdownPhase::Ready;
+    StartBoostResult boostResult{};
+    float speedKmh = 0.0f;
+    float damage = 0.0f;
+    float currentLapTime = 0.0f;
+    float bestLapTime = 0.0f;
+    float lastLapTime = 0.0f;
+    int lapCount = 0;
+    EndlessStats stats;
+    CampaignProgress campaignProgress;
+    CampaignTrack campaignTrack;
+    bool gameOver = false;
+    bool raceFinished = false;
+    bool objectiveCompleted = false;
+};
+
+// Immutable copy of one simulation tick for drawing. States keep two of these
+// so the next tick can be simulated (possibly on another thread, see Game::run)
+// while the previous one is rendered.
+struct GameplayRenderState {
+    PlayerPose player;
+    RoadRenderState road;
+    std::vector<TrafficCar> traffic;
+    float trackLength = 0.0f;
+    HudState hud;
+    float elapsed = 0.0f;   // simulated time since the previous capture (HUD animations)
+};
+
 class GameplayManager {
 public:
-    GameplayManager(GameMode mode, const TrackDefinition* track = nullptr);
-    GameplayManager(GameMode mode, EndlessDifficultyLevel difficulty);
+    // seed drives every random stream of the session (defaults to the next global session seed)
+    GameplayManager(GameMode mode, const TrackDefinition* track = nullptr,
+                    std::uint64_t seed = RandomService::getInstance().nextSessionSeed());
+    GameplayManager(GameMode mode, EndlessDifficultyLevel difficulty,
+                    std::uint64_t seed = RandomService::getInstance().nextSessionSeed());
     
     void update(float deltaTime);
-    void render(sf::RenderWindow& window);
+    // Copies what render() needs; containers in out are reused between frames
+    void captureRenderState(GameplayRenderState& out) const;
+    // Only reads gameplay data through state, safe while update() runs on another thread
+    void render(RenderCommandBuffer& commands, const GameplayRenderState& state, float alpha = 1.0f);
+
+    // Driver input for the next update() (keyboard, replay or bot)
+    void setInput(const InputSnapshot& input);
+
+    // Endless only, before the race starts: regenerate the session with tuned settings
+    // (used by the batch simulator to explore potholeChance/bonusMultiplier etc.)
+    void setDifficultySettings(const EndlessDifficultySettings& settings);
+    const EndlessDifficultySettings& getDifficultySettings() const { return m_difficultySettings; }
     
     // Countdown system
     void handleStartInput(bool clutchPressed);
@@ -47,8 +93,9 @@ public:
     // Getters
     float getPlayerSpeed() const;
     float getPlayerSpeedKmh() const;
-    float getDistance() const;
+    float getDistance() const;          // world Z, within the current lap
     float getDistanceKm() const;
+    double getRunDistance() const;      // along the road since the start
     const EndlessStats& getStats() const;
     int getCurrentLevel() const;
     GameMode getGameMode() const;
@@ -58,9 +105,11 @@ public:
     float getBestLapTime() const { return m_bestLapTime; }
     float getLastLapTime() const { return m_lastLapTime; }
     float getLastLapMultiplier() const { return m_lapScoreMultiplier; }
+    std::uint64_t getSeed() const { return m_random.getSeed(); }
     float getPreviousLapTime() const { return m_previousLapTime; }
     
     const Player& getPlayer() const { return m_player; }
+    const Road& getRoad() const { return m_road; }
     
     // Endless mode getters
     EndlessDifficultyLevel getEndlessDifficulty() const { return m_endlessDifficulty; }
@@ -77,7 +126,7 @@ public:
 
 private:
     void initializeForMode();
-    void initializeEndless(EndlessDifficultyLevel difficulty);
+    void initializeEndless();
     void loadTrack(const TrackDefinition& track);
     void handleTrackLooping();
     
@@ -87,6 +136,7 @@ private:
     void updateEndlessScoring(float deltaTime);
     void updateDifficultyProgression();
     void checkCheckpoints();
+    void shiftWorldOrigin(float offset);
     void evaluateCornerPerformance();
     void checkPotholeCollisions();
     void checkRepairPickups();
@@ -103,6 +153,7 @@ private:
     SurfaceType getSurfaceTypeAt(float x, float z) const;
     
     GameMode m_mode;
+    RandomService m_random;
     Player m_player;
     Road m_road;
 
@@ -123,6 +174,7 @@ private:
     bool m_clutchHeld;
     float m_boostWindowTimer;
     bool m_boostWindowPassed;
+    bool m_goSoundPlayed = false;
     float m_activeBoostTimer;
     float m_currentBoostMultiplier;
     
@@ -135,10 +187,15 @@ private:
     EndlessStats m_stats;
     EndlessDifficulty m_difficulty;
     
-    float m_lastCheckpointZ = 0.0f;
+    // Run distance of world Z = 0, moved by shiftWorldOrigin
+    double m_originDistance = 0.0;
+    double m_drivenDistance = 0.0;      // integrated speed, for the stats
+    double m_lastCheckpointDistance = 0.0;
     float m_checkpointInterval = 5000.0f;
     
     bool m_inCorner = false;
+    bool m_wasSpinning = false;
+    bool m_wasOffTrack = false;
     float m_cornerEntrySpeed = 0.0f;
     
     int m_lapCount = 0;
@@ -1,11 +1,13 @@
 ﻿#include "ObstacleSystem.h"
 #include "Player.h"
+#include "Core/FrameArena.h"
+#include "Core/Profiler.h"
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <iostream>
 
-ObstacleEffect Obstacle::calculateEffect(float impactSpeed, std::mt19937& rng) const {
+ObstacleEffect Obstacle::calculateEffect(float impactSpeed, RandomStream& rng) const {
     ObstacleEffect effect;
     
     switch (type) {
@@ -16,8 +18,7 @@ ObstacleEffect Obstacle::calculateEffect(float impactSpeed, std::mt19937& rng) c
             effect.effectDuration = 0.5f;
             
             float flatChance = ObstacleConfig::POTHOLE_FLAT_CHANCE * (0.5f + speedFactor * 0.5f);
-            std::uniform_real_distribution<float> dist(0.0f, 1.0f);
-            if (dist(rng) < flatChance) {
+            if (rng.chance(flatChance)) {
                 effect.causedFlatTire = true;
                 effect.effectDuration = ObstacleConfig::FLAT_TIRE_DURATION;
             }
@@ -50,12 +51,18 @@ ObstacleEffect Obstacle::calculateEffect(float impactSpeed, std::mt19937& rng) c
 }
 
 ObstacleSystem::ObstacleSystem() 
-    : m_rng(std::random_device{}())
+    : m_rng(RandomService::getInstance().stream("obstacles"))
+{
+}
+
+ObstacleSystem::ObstacleSystem(const RandomStream& rng)
+    : m_rng(rng)
 {
 }
 
 void ObstacleSystem::update(float deltaTime, float playerZ, float playerX, 
                             float playerSpeed, float carWidth, float carHeight) {
+    PROFILE_SCOPE("ObstacleSystem::update");
     if (m_spawnEnabled) {
         m_spawnCooldown -= deltaTime;
         if (m_spawnCooldown <= 0.0f) {
@@ -73,7 +80,8 @@ void ObstacleSystem::render(sf::RenderWindow& window, float cameraZ, float camer
     const float windowHeight = static_cast<float>(window.getSize().y);
     
     // Sort: far to near (for correct drawing order)
-    std::vector<Obstacle*> sortedObs;
+    FrameVector<Obstacle*> sortedObs(&FrameArena::getInstance());
+    sortedObs.reserve(m_obstacles.size());
     for (auto& obs : m_obstacles) {
         if (obs.isActive) {
             sortedObs.push_back(&obs);
@@ -188,10 +196,9 @@ void ObstacleSystem::trySpawnObstacle(float playerZ) {
     }
     
     // Spawn chance based on difficulty
-    std::uniform_real_distribution<float> chanceDist(0.0f, 1.0f);
     float spawnChance = 0.5f + m_difficulty * 0.35f;  // 50-85%
     
-    if (chanceDist(m_rng) > spawnChance) {
+    if (m_rng.nextFloat() > spawnChance) {
         m_spawnCooldown = 0.15f;
         return;
     }
@@ -244,8 +251,7 @@ Obstacle ObstacleSystem::createObstacle(ObstacleType type, float z, float x) {
 }
 
 ObstacleType ObstacleSystem::getRandomType() {
-    std::uniform_int_distribution<int> dist(0, 100);
-    int roll = dist(m_rng);
+    int roll = m_rng.rangeInt(0, 100);
     
     if (roll < 30) return ObstacleType::Pothole;
     else if (roll < 55) return ObstacleType::OilSlick;
@@ -255,8 +261,7 @@ ObstacleType ObstacleSystem::getRandomType() {
 
 float ObstacleSystem::getRandomLateralPosition() {
     // Spawn on road, in the center zone to be hit
-    std::uniform_real_distribution<float> dist(-500.0f, 500.0f);
-    return dist(m_rng);
+    return m_rng.range(-500.0f, 500.0f);
 }
 
 void ObstacleSystem::checkCollisions(float playerZ, float playerX, float playerSpeed,
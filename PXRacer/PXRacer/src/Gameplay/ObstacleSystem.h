@@ -1,9 +1,9 @@
 ﻿#pragma once
 #include <SFML/Graphics.hpp>
 #include <vector>
-#include <random>
 #include <functional>
 #include "Road.h"  // For RoadConfig
+#include "Core/Random.h"
 
 namespace ObstacleConfig {
     // Spawn Settings
@@ -73,12 +73,13 @@ struct Obstacle {
     float getFront() const { return worldZ + height / 2.0f; }
     float getBack() const { return worldZ - height / 2.0f; }
     
-    ObstacleEffect calculateEffect(float impactSpeed, std::mt19937& rng) const;
+    ObstacleEffect calculateEffect(float impactSpeed, RandomStream& rng) const;
 };
 
 class ObstacleSystem {
 public:
     ObstacleSystem();
+    explicit ObstacleSystem(const RandomStream& rng);
     
     void update(float deltaTime, float playerZ, float playerX, float playerSpeed,
                 float carWidth, float carHeight);
@@ -97,7 +98,7 @@ public:
 
 private:
     std::vector<Obstacle> m_obstacles;
-    std::mt19937 m_rng;
+    RandomStream m_rng;
     
     bool m_spawnEnabled = true;
     float m_difficulty = 0.5f;
@@ -1,5 +1,6 @@
 ﻿#include "Player.h"
-#include <SFML/Window/Keyboard.hpp>
+#include "Rendering/RenderCommandBuffer.h"
+#include "Core/Profiler.h"
 #include <algorithm>
 #include <cmath>
 #include <filesystem>
@@ -9,10 +10,11 @@ Player::Player()
     , m_steeringVisualState(0), m_isSpinning(false), m_spinTimer(0.0f)
     , m_offRoadTimer(0.0f), m_wobbleOffset(0.0f), m_wobbleTimer(0.0f), m_totalDamage(0.0f)
 {
-    loadTextures();
 }
 
+// Called lazily from render() so headless simulation never touches the GPU
 void Player::loadTextures() {
+    m_texturesRequested = true;
     namespace fs = std::filesystem;
     std::string path = "assets/textures/";
     auto tryLoad = [&](sf::Texture& tex, const std::string& name) {
@@ -35,6 +37,7 @@ void Player::getWheelPositions(float& flX, float& flZ, float& frX, float& frZ,
 }
 
 void Player::update(float deltaTime, const WheelSurfaces& wheelSurfaces, float roadCurve) {
+    PROFILE_SCOPE("Player::update");
     if (isDestroyed()) {
         m_speed *= 0.95f;
         m_rotation += 180.0f * deltaTime;
@@ -46,44 +49,59 @@ void Player::update(float deltaTime, const WheelSurfaces& wheelSurfaces, float r
 }
 
 void Player::handleInput(float deltaTime, float gripMultiplier) {
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::W) || sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::Up))
-        m_speed += PlayerConfig::ACCELERATION * deltaTime * gripMultiplier;
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::S) || sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::Down))
-        m_speed -= PlayerConfig::BRAKING * deltaTime;
+    if (m_input.throttle > 0.0f)
+        m_speed += PlayerConfig::ACCELERATION * deltaTime * gripMultiplier * m_input.throttle;
+    else if (m_input.brake > 0.0f)
+        m_speed -= PlayerConfig::BRAKING * deltaTime * m_input.brake;
     else
         m_speed = std::max(0.0f, m_speed - PlayerConfig::DECELERATION * deltaTime);
 
     m_speed = std::min(m_speed, PlayerConfig::MAX_SPEED);
     float steerPower = PlayerConfig::STEER_SPEED * gripMultiplier;
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::A) || sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::Left)) {
-        m_positionX -= steerPower * deltaTime; m_steeringVisualState = -1;
+    if (m_input.steer < 0.0f) {
+        m_positionX += steerPower * deltaTime * m_input.steer; m_steeringVisualState = -1;
     }
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::D) || sf::Keyboard::isKeyPressed(sf::Keyboard::Scan::Right)) {
-        m_positionX += steerPower * deltaTime; m_steeringVisualState = 1;
+    else if (m_input.steer > 0.0f) {
+        m_positionX += steerPower * deltaTime * m_input.steer; m_steeringVisualState = 1;
     }
     else {
         m_steeringVisualState = 0;
     }
 }
 
-void Player::render(sf::RenderWindow& window, float screenX, float screenY, float scale) {
+PlayerPose Player::getPose() const {
+    PlayerPose pose;
+    pose.z = m_positionZ;
+    pose.x = m_positionX;
+    pose.previousZ = m_previousZ;
+    pose.previousX = m_previousX;
+    pose.rotation = m_rotation;
+    pose.wobbleOffset = m_wobbleOffset;
+    pose.steeringVisualState = m_steeringVisualState;
+    return pose;
+}
+
+void Player::render(RenderCommandBuffer& commands, const PlayerPose& pose, float screenX, float screenY, float scale) {
+    if (!m_texturesRequested) loadTextures();
+
     // MODIFICARE: Factor 1.3f pentru lățime (corecție aspect ratio)
     float drawW = PlayerConfig::CAR_WIDTH * scale * 1.3f;
     float drawH = PlayerConfig::CAR_HEIGHT * scale;
 
     if (m_texturesLoaded) {
         sf::Texture* tex = &m_textureStraight;
-        if (m_steeringVisualState == -1) tex = &m_textureLeft;
-        else if (m_steeringVisualState == 1) tex = &m_textureRight;
+        if (pose.steeringVisualState == -1) tex = &m_textureLeft;
+        else if (pose.steeringVisualState == 1) tex = &m_textureRight;
 
         sf::Sprite spr(*tex);
         sf::Vector2u size = tex->getSize();
         spr.setOrigin(sf::Vector2f(static_cast<float>(size.x) / 2.0f, static_cast<float>(size.y)));
         spr.setScale(sf::Vector2f(drawW / size.x, drawH / size.y));
-        spr.setPosition(sf::Vector2f(screenX + m_wobbleOffset, screenY));
-        spr.setRotation(sf::degrees(m_rotation));
-        window.draw(spr);
+        spr.setPosition(sf::Vector2f(screenX + pose.wobbleOffset, screenY));
+        spr.setRotation(sf::degrees(pose.rotation));
+        commands.setLayer(RenderLayer::Player);
+        commands.draw(spr);
     }
 }
 
@@ -117,4 +135,4 @@ void Player::handleSpinOut(float dt) {
 
 void Player::addDamage(float d) { m_totalDamage = std::min(m_totalDamage + d, PlayerConfig::MAX_DAMAGE); }
 void Player::repair(float a) { m_totalDamage = std::max(0.0f, m_totalDamage - a); }
-void Player::resetPosition() { m_positionX = 0.0f; m_speed = 0.0f; m_rotation = 0.0f; m_isSpinning = false; }
\ No newline at end of file
+void Player::resetPosition() { m_positionX = 0.0f; m_previousX = 0.0f; m_speed = 0.0f; m_rotation = 0.0f; m_isSpinning = false; }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <vector>
 #include <string>
 
+class RenderCommandBuffer;
+
 namespace PlayerConfig {
     constexpr float MAX_SPEED = 90.0f;
     constexpr float ACCELERATION = 30.0f;
@@ -43,12 +45,38 @@ struct WheelSurfaces {
     }
 };
 
+// One tick of driver input. Filled from the keyboard by PlayState, or by
+// a replay/bot in headless runs, so Player never polls devices itself.
+struct InputSnapshot {
+    float throttle = 0.0f;   // 0..1
+    float brake = 0.0f;      // 0..1
+    float steer = 0.0f;      // -1 (left) .. 1 (right)
+    bool clutch = false;     // start boost (held through the countdown)
+};
+
+// What rendering needs from the player, copied once per frame so the
+// simulation can keep running while the copy is drawn
+struct PlayerPose {
+    float z = 0.0f;
+    float x = 0.0f;
+    float previousZ = 0.0f;
+    float previousX = 0.0f;
+    float rotation = 0.0f;
+    float wobbleOffset = 0.0f;
+    int steeringVisualState = 0;
+
+    float interpolatedZ(float alpha) const { return previousZ + (z - previousZ) * alpha; }
+    float interpolatedX(float alpha) const { return previousX + (x - previousX) * alpha; }
+};
+
 class Player {
 public:
     Player();
     void update(float deltaTime, const WheelSurfaces& wheelSurfaces, float roadCurve = 0.0f);
-    void render(sf::RenderWindow& window, float screenX, float screenY, float scale);
+    void render(RenderCommandBuffer& commands, const PlayerPose& pose, float screenX, float screenY, float scale);
     void loadTextures();
+    void setInput(const InputSnapshot& input) { m_input = input; }
+    const InputSnapshot& getInput() const { return m_input; }
 
     // Getters necesari pentru GameplayManager și HUD
     float getZ() const { return m_positionZ; }
@@ -62,6 +90,12 @@ public:
     void getWheelPositions(float& flX, float& flZ, float& frX, float& frZ,
         float& rlX, float& rlZ, float& rrX, float& rrZ) const;
 
+    // Render interpolation: position at the start of the current tick
+    void savePreviousState() { m_previousZ = m_positionZ; m_previousX = m_positionX; }
+    PlayerPose getPose() const;
+    // Moves current and previous Z together (lap wrap) so interpolation doesn't sweep the whole track
+    void rebaseZ(float offset) { m_positionZ += offset; m_previousZ += offset; }
+
     void setZ(float z) { m_positionZ = z; }
     void setX(float x) { m_positionX = x; }
     void setSpeed(float speed) { m_speed = speed; }
@@ -73,6 +107,8 @@ public:
 private:
     float m_positionZ;
     float m_positionX;
+    float m_previousZ = 0.0f;
+    float m_previousX = 0.0f;
     float m_speed;
     float m_rotation;
     int m_steeringVisualState;
@@ -81,6 +117,9 @@ private:
     sf::Texture m_textureLeft;
     sf::Texture m_textureRight;
     bool m_texturesLoaded = false;
+    bool m_texturesRequested = false;
+
+    InputSnapshot m_input;
 
     bool m_isSpinning;
     float m_spinTimer;
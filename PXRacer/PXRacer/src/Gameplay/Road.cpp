@@ -1,24 +1,208 @@
 ﻿#include "Road.h"
-#include "Core/SettingsManager.h"
 #include "CurveProcessor.h"
 #include "Core/Constants.h"
+#include "Core/FrameArena.h"
+#include "Core/Profiler.h"
+#include "Rendering/RenderCommandBuffer.h"
 #include <cmath>
 #include <iostream>
-#include <random>
 #include <algorithm>
 
-RoadSegment::RoadSegment()
-    : worldZ(0.0f), curve(0.0f), worldY(0.0f), roadColor(sf::Color(100, 100, 100)), grassColor(sf::Color(16, 200, 16)), rumbleColor(sf::Color::White), laneColor(sf::Color::White), screenX(0.0f), screenY(0.0f), screenW(0.0f), scale(0.0f)
+namespace
 {
-    pothole.exists = false;
-    pothole.wasHit = false;
-    repairPickup.exists = false;
-    repairPickup.collected = false;
+    const RoadPalette DEFAULT_PALETTE = {
+        sf::Color(135, 206, 250),
+        {sf::Color(107, 107, 107), sf::Color(105, 105, 105)},
+        {sf::Color(16, 200, 16), sf::Color(0, 154, 0)},
+        {sf::Color::Red, sf::Color::White},
+        sf::Color::White};
+
+    const RoadPalette DESERT_PALETTE = {
+        sf::Color(250, 214, 150),
+        {sf::Color(150, 132, 110), sf::Color(144, 126, 104)},
+        {sf::Color(232, 196, 124), sf::Color(214, 176, 104)},
+        {sf::Color(200, 60, 30), sf::Color(245, 235, 215)},
+        sf::Color(245, 235, 215)};
+
+    const RoadPalette NIGHT_CITY_PALETTE = {
+        sf::Color(18, 16, 44),
+        {sf::Color(52, 52, 62), sf::Color(46, 46, 56)},
+        {sf::Color(28, 26, 48), sf::Color(20, 18, 38)},
+        {sf::Color(255, 60, 200), sf::Color(60, 220, 255)},
+        sf::Color(255, 210, 80)};
+
+    const RoadPalette FOREST_PALETTE = {
+        sf::Color(160, 200, 215),
+        {sf::Color(92, 90, 86), sf::Color(86, 84, 80)},
+        {sf::Color(24, 110, 36), sf::Color(12, 86, 26)},
+        {sf::Color(200, 40, 40), sf::Color(230, 230, 220)},
+        sf::Color(230, 230, 220)};
+
+    // How far behind the player the hazard cursors stay (the rear wheels)
+    constexpr int HAZARD_CURSOR_MARGIN = 2;
+    // Entries a lookup walks forward from the cursor before it binary searches
+    constexpr std::size_t HAZARD_SCAN_LIMIT = 8;
+    // Pickups a captured window holds before its list has to grow
+    constexpr std::size_t RENDER_PICKUP_RESERVE = 16;
+    // Hashed potholes hit in one lap before the hit list has to grow
+    constexpr std::size_t HIT_POTHOLE_RESERVE = 64;
+
+    bool containsSegment(const std::vector<int> &segments, int segment)
+    {
+        return std::binary_search(segments.begin(), segments.end(), segment);
+    }
+
+    void insertSegment(std::vector<int> &segments, int segment)
+    {
+        auto it = std::lower_bound(segments.begin(), segments.end(), segment);
+        if (it == segments.end() || *it != segment)
+            segments.insert(it, segment);
+    }
+
+    void eraseSegment(std::vector<int> &segments, int segment)
+    {
+        auto it = std::lower_bound(segments.begin(), segments.end(), segment);
+        if (it != segments.end() && *it == segment)
+            segments.erase(it);
+    }
+
+    // Index of the first hazard at or after segment, searched from cursor
+    // (the common case: a few steps forward) or by binary search otherwise
+    template <typename Hazard>
+    std::size_t seekHazard(const std::vector<Hazard> &hazards, std::size_t cursor, int segment)
+    {
+        cursor = std::min(cursor, hazards.size());
+        if (cursor == 0 || hazards[cursor - 1].segment < segment)
+        {
+            for (std::size_t steps = 0; steps < HAZARD_SCAN_LIMIT; ++steps, ++cursor)
+            {
+                if (cursor == hazards.size() || hazards[cursor].segment >= segment)
+                    return cursor;
+            }
+        }
+        auto it = std::lower_bound(hazards.begin(), hazards.end(), segment,
+                                   [](const Hazard &hazard, int value) { return hazard.segment < value; });
+        return static_cast<std::size_t>(it - hazards.begin());
+    }
+
+    template <typename Hazard>
+    Hazard *findHazard(std::vector<Hazard> &hazards, std::size_t cursor, int segment)
+    {
+        const std::size_t index = seekHazard(hazards, cursor, segment);
+        return index < hazards.size() && hazards[index].segment == segment ? &hazards[index] : nullptr;
+    }
+
+    // Copies the hazards of the window segments [first, first + window), in road order
+    template <typename Hazard>
+    void copyHazardWindow(const std::vector<Hazard> &hazards, std::size_t cursor, int first, int window, int segmentCount,
+                          std::vector<Hazard> &out)
+    {
+        out.clear();
+        const std::size_t start = seekHazard(hazards, cursor, first);
+        for (std::size_t n = 0; n < hazards.size(); ++n)
+        {
+            const Hazard &hazard = hazards[(start + n) % hazards.size()];
+            int offset = hazard.segment - first;
+            if (offset < 0)
+                offset += segmentCount;
+            if (offset >= window)
+                break;
+            out.push_back(hazard);
+        }
+    }
+
+    // Steps through a captured hazard window as the scanlines move away from
+    // the camera; starts over when the segment wraps past the end of the road
+    template <typename Hazard>
+    class HazardWindowCursor
+    {
+    public:
+        HazardWindowCursor(const std::vector<Hazard> &hazards, int firstSegment, int segmentCount)
+            : m_hazards(hazards), m_firstSegment(firstSegment), m_segmentCount(segmentCount)
+        {
+        }
+
+        const Hazard *at(int segmentIndex)
+        {
+            const int offset = offsetOf(segmentIndex);
+            if (offset < m_lastOffset)
+                m_next = 0;
+            m_lastOffset = offset;
+            while (m_next < m_hazards.size() && offsetOf(m_hazards[m_next].segment) < offset)
+                ++m_next;
+            return m_next < m_hazards.size() && m_hazards[m_next].segment == segmentIndex ? &m_hazards[m_next] : nullptr;
+        }
+
+    private:
+        int offsetOf(int segmentIndex) const
+        {
+            const int offset = segmentIndex - m_firstSegment;
+            return offset < 0 ? offset + m_segmentCount : offset;
+        }
+
+        const std::vector<Hazard> &m_hazards;
+        int m_firstSegment;
+        int m_segmentCount;
+        std::size_t m_next = 0;
+        int m_lastOffset = 0;
+    };
+
+    // [0, 1) from 24 bits of a hash
+    float unitFromBits(std::uint64_t bits)
+    {
+        return static_cast<float>(bits & 0xFFFFFF) * (1.0f / 16777216.0f);
+    }
+
+    // One 64-bit hash per segment: the top bits decide whether there is a
+    // pothole, the next ones give its position and a remix its width
+    float potholeRoll(std::uint64_t hash)
+    {
+        return unitFromBits(hash >> 40);
+    }
+
+    Pothole makeHashedPothole(std::uint64_t hash, int segment)
+    {
+        Pothole pothole;
+        pothole.segment = segment;
+        pothole.offsetX = -400.0f + 800.0f * unitFromBits(hash >> 16);
+        pothole.width = RoadConfig::POTHOLE_MIN_WIDTH +
+                        (RoadConfig::POTHOLE_MAX_WIDTH - RoadConfig::POTHOLE_MIN_WIDTH) * unitFromBits(mix64(hash));
+        return pothole;
+    }
+}
+
+const RoadPalette &RoadPalette::getPalette(const std::string &theme)
+{
+    if (theme == "desert")
+        return DESERT_PALETTE;
+    if (theme == "night_city")
+        return NIGHT_CITY_PALETTE;
+    if (theme == "forest")
+        return FOREST_PALETTE;
+    return DEFAULT_PALETTE;
 }
 
 Road::Road()
-    : m_playerZ(0.0f), m_rng(std::random_device{}()), m_potholeChance(RoadConfig::POTHOLE_SPAWN_CHANCE), m_repairChance(RoadConfig::REPAIR_SPAWN_CHANCE), m_potholeCount(0)
+    : m_palette(&DEFAULT_PALETTE), m_playerZ(0.0f), m_rng(RandomService::getInstance().stream("road")), m_potholeChance(RoadConfig::POTHOLE_SPAWN_CHANCE), m_repairChance(RoadConfig::REPAIR_SPAWN_CHANCE), m_potholeCount(0)
 {
+    m_hitPotholes.reserve(HIT_POTHOLE_RESERVE);
+}
+
+void Road::createSegments(int segmentCount)
+{
+    const int COLOR_PATTERN_LENGTH = 6;
+    int adjustedCount = ((segmentCount + COLOR_PATTERN_LENGTH - 1) / COLOR_PATTERN_LENGTH) * COLOR_PATTERN_LENGTH;
+
+    m_curves.assign(adjustedCount, 0.0f);
+    m_worldY.assign(adjustedCount, 0.0f);
+
+    m_potholes.clear();
+    m_pickups.clear();
+    m_potholeCursor = 0;
+    m_pickupCursor = 0;
+    m_hashedPotholes = false;
+    m_hitPotholes.clear();
+    m_streaming = false;
 }
 
 void Road::generate(int segmentCount)
@@ -28,33 +212,16 @@ void Road::generate(int segmentCount)
 
 void Road::generateWithDifficulty(int segmentCount, EndlessDifficultyLevel difficulty)
 {
-    m_segments.clear();
-    m_segments.reserve(segmentCount);
+    generateWithDifficulty(segmentCount, EndlessDifficultySettings::getSettings(difficulty));
+}
 
-    auto settings = EndlessDifficultySettings::getSettings(difficulty);
+void Road::generateWithDifficulty(int segmentCount, const EndlessDifficultySettings& settings)
+{
     m_potholeChance = settings.potholeChance;
     m_repairChance = settings.repairPickupChance;
 
-    const int COLOR_PATTERN_LENGTH = 6;
-    int adjustedCount = ((segmentCount + COLOR_PATTERN_LENGTH - 1) / COLOR_PATTERN_LENGTH) * COLOR_PATTERN_LENGTH;
-
-    for (int i = 0; i < adjustedCount; ++i)
-    {
-        RoadSegment segment;
-        segment.worldZ = i * RoadConfig::SEGMENT_LENGTH;
-        segment.curve = 0.0f;
-        segment.worldY = 0.0f;
-
-        bool isDark = ((i / 3) % 2) == 0;
-        segment.roadColor = isDark ? sf::Color(107, 107, 107) : sf::Color(105, 105, 105);
-        segment.grassColor = isDark ? sf::Color(16, 200, 16) : sf::Color(0, 154, 0);
-        segment.rumbleColor = (i % 3 == 0) ? sf::Color::Red : sf::Color::White;
-        segment.laneColor = sf::Color::White;
-
-        segment.repairPickup.animTimer = static_cast<float>(i) * 0.1f;
-
-        m_segments.push_back(segment);
-    }
+    createSegments(segmentCount);
+    const int adjustedCount = getSegmentCount();
 
     int pos = 0;
     addStraight(pos, adjustedCount / 6);
@@ -80,45 +247,21 @@ void Road::generateWithDifficulty(int segmentCount, EndlessDifficultyLevel diffi
 
 void Road::init(int segmentCount)
 {
-    m_segments.clear();
-    m_segments.reserve(segmentCount);
-
-    const int COLOR_PATTERN_LENGTH = 6;
-    int adjustedCount = ((segmentCount + COLOR_PATTERN_LENGTH - 1) / COLOR_PATTERN_LENGTH) * COLOR_PATTERN_LENGTH;
-
-    for (int i = 0; i < adjustedCount; ++i)
-    {
-        RoadSegment segment;
-        segment.worldZ = i * RoadConfig::SEGMENT_LENGTH;
-        segment.curve = 0.0f;
-        segment.worldY = 0.0f;
-
-        bool isDark = ((i / 3) % 2) == 0;
-        segment.roadColor = isDark ? sf::Color(107, 107, 107) : sf::Color(105, 105, 105);
-        segment.grassColor = isDark ? sf::Color(16, 200, 16) : sf::Color(0, 154, 0);
-        segment.rumbleColor = (i % 3 == 0) ? sf::Color::Red : sf::Color::White;
-        segment.laneColor = sf::Color::White;
-
-        segment.repairPickup.animTimer = static_cast<float>(i) * 0.1f;
-
-        m_segments.push_back(segment);
-    }
+    createSegments(segmentCount);
 
     generatePotholes();
     generateRepairPickupsFixed(RoadConfig::PICKUPS_LOW_DAMAGE);
 
-    std::cout << "Road initialized (flat): " << m_segments.size() << " segments" << std::endl;
+    std::cout << "Road initialized (flat): " << m_curves.size() << " segments" << std::endl;
 }
 
 // NEW: Regenerate pickups based on current damage
 void Road::regeneratePickupsForDamage(float currentDamage)
 {
+    PROFILE_SCOPE("Road::regeneratePickupsForDamage");
     // Clear all existing pickups
-    for (auto &seg : m_segments)
-    {
-        seg.repairPickup.exists = false;
-        seg.repairPickup.collected = false;
-    }
+    m_pickups.clear();
+    m_pickupCursor = 0;
 
     // Decide how many pickups to spawn
     int pickupCount;
@@ -135,6 +278,13 @@ void Road::regeneratePickupsForDamage(float currentDamage)
         pickupCount = RoadConfig::PICKUPS_HIGH_DAMAGE; // 1 pickup
     }
 
+    if (m_streaming)
+    {
+        // Only the segments generated from now on get the new rate
+        m_streamPickupCount = pickupCount;
+        return;
+    }
+
     generateRepairPickupsFixed(pickupCount);
 
     std::cout << "[ROAD] Regenerated " << pickupCount << " pickups for "
@@ -144,27 +294,27 @@ void Road::regeneratePickupsForDamage(float currentDamage)
 // Modify generateRepairPickupsFixed for uniform random placement:
 void Road::generateRepairPickupsFixed(int count)
 {
-    std::uniform_real_distribution<float> positionDist(-350.0f, 350.0f);
-
     // Distribute pickups uniformly along the track
-    int segmentCount = static_cast<int>(m_segments.size());
+    int segmentCount = getSegmentCount();
     int spacing = segmentCount / (count + 1); // uniform spacing
 
     // Add variation so placement is not predictable
-    std::uniform_int_distribution<int> offsetDist(-spacing / 3, spacing / 3);
 
     int pickupCount = 0;
 
     for (int i = 0; i < count; ++i)
     {
         int basePos = spacing * (i + 1);
-        int offset = offsetDist(m_rng);
+        int offset = m_rng.rangeInt(-spacing / 3, spacing / 3);
         int segIdx = std::clamp(basePos + offset, 50, segmentCount - 1);
 
         // Find a valid segment (no pothole and no pickup)
+        auto isTaken = [this](int segment)
+        {
+            return hasPothole(segment) || findHazard(m_pickups, 0, segment);
+        };
         int attempts = 0;
-        while (attempts < 20 &&
-               (m_segments[segIdx].pothole.exists || m_segments[segIdx].repairPickup.exists))
+        while (attempts < 20 && isTaken(segIdx))
         {
             segIdx = (segIdx + 1) % segmentCount;
             if (segIdx < 50)
@@ -172,13 +322,9 @@ void Road::generateRepairPickupsFixed(int count)
             attempts++;
         }
 
-        if (!m_segments[segIdx].pothole.exists && !m_segments[segIdx].repairPickup.exists)
+        if (!isTaken(segIdx))
         {
-            m_segments[segIdx].repairPickup.exists = true;
-            m_segments[segIdx].repairPickup.offsetX = positionDist(m_rng);
-            m_segments[segIdx].repairPickup.width = 80.0f;
-            m_segments[segIdx].repairPickup.healAmount = RoadConfig::REPAIR_HEAL_AMOUNT;
-            m_segments[segIdx].repairPickup.collected = false;
+            insertPickup(segIdx);
             pickupCount++;
         }
     }
@@ -186,6 +332,18 @@ void Road::generateRepairPickupsFixed(int count)
     std::cout << "[ROAD] Generated " << pickupCount << " repair pickups" << std::endl;
 }
 
+void Road::insertPickup(int segment)
+{
+    RepairPickup pickup;
+    pickup.segment = segment;
+    pickup.offsetX = m_rng.range(-350.0f, 350.0f);
+    pickup.width = 80.0f;
+    pickup.healAmount = RoadConfig::REPAIR_HEAL_AMOUNT;
+    pickup.collected = false;
+    pickup.animTimer = static_cast<float>(segment) * 0.1f;
+    m_pickups.insert(m_pickups.begin() + seekHazard(m_pickups, 0, segment), pickup);
+}
+
 void Road::generatePotholes()
 {
     generatePotholesWithChance(RoadConfig::POTHOLE_SPAWN_CHANCE);
@@ -194,27 +352,39 @@ void Road::generatePotholes()
 // Replaces generatePotholesWithChance:
 void Road::generatePotholesWithChance(float chance)
 {
-    std::uniform_real_distribution<float> chanceDist(0.0f, 1.0f);
-    std::uniform_real_distribution<float> positionDist(-400.0f, 400.0f);
-    std::uniform_real_distribution<float> widthDist(RoadConfig::POTHOLE_MIN_WIDTH, RoadConfig::POTHOLE_MAX_WIDTH);
-
     m_potholeCount = 0;
+    m_potholes.clear();
+    m_potholeCursor = 0;
+    m_hitPotholes.clear();
+
+    m_potholeChance = chance;
+    m_hashedPotholes = getSegmentCount() >= RoadConfig::HASHED_POTHOLE_MIN_SEGMENTS;
+    if (m_hashedPotholes)
+    {
+        // Nothing to place: the layout is a function of the seed
+        m_potholeSeed = m_rng();
+        setLap(0);
+        std::cout << "[ROAD] Potholes hashed per segment (" << getSegmentCount() << " segments)" << std::endl;
+        return;
+    }
 
     int lastPotholeSegment = -10;
 
-    for (size_t i = 50; i < m_segments.size(); ++i)
+    for (size_t i = RoadConfig::HAZARD_FREE_START; i < m_curves.size(); ++i)
     {
-        if (static_cast<int>(i) - lastPotholeSegment < 5)
+        if (static_cast<int>(i) - lastPotholeSegment < RoadConfig::POTHOLE_MIN_SPACING)
         {
             continue;
         }
 
-        if (chanceDist(m_rng) < chance)
+        if (m_rng.chance(chance))
         {
-            m_segments[i].pothole.exists = true;
-            m_segments[i].pothole.offsetX = positionDist(m_rng);
-            m_segments[i].pothole.width = widthDist(m_rng); // Fix: was using wrong variable
-            m_segments[i].pothole.wasHit = false;
+            Pothole pothole;
+            pothole.segment = static_cast<int>(i);
+            pothole.offsetX = m_rng.range(-400.0f, 400.0f);
+            pothole.width = m_rng.range(RoadConfig::POTHOLE_MIN_WIDTH, RoadConfig::POTHOLE_MAX_WIDTH); // Fix: was using wrong variable
+            pothole.wasHit = false;
+            m_potholes.push_back(pothole);
             m_potholeCount++;
             lastPotholeSegment = static_cast<int>(i);
         }
@@ -223,20 +393,93 @@ void Road::generatePotholesWithChance(float chance)
     std::cout << "[ROAD] Generated " << m_potholeCount << " potholes" << std::endl;
 }
 
+// A candidate segment rolled under the pothole chance; it only gets a pothole
+// when none of the POTHOLE_MIN_SPACING - 1 segments before it is a candidate,
+// which keeps the spacing rule without looking back at placed potholes
+bool Road::isPotholeCandidate(std::int64_t key) const
+{
+    return key >= RoadConfig::HAZARD_FREE_START &&
+           potholeRoll(m_lapPotholes.at(static_cast<std::uint64_t>(key))) < m_potholeChance;
+}
+
+// What hashed hazards are keyed by: the segment index, or on a streamed road
+// the absolute index of the segment the slot currently holds
+std::int64_t Road::hazardKey(int segment) const
+{
+    if (!m_streaming)
+        return segment;
+    const int count = getSegmentCount();
+    const std::int64_t oldest = m_streamHead - count;
+    return oldest + ((segment - oldest) % count + count) % count;
+}
+
+bool Road::findHashedPothole(int segment, Pothole &out) const
+{
+    const std::int64_t key = hazardKey(segment);
+    if (!isPotholeCandidate(key))
+        return false;
+    for (int back = 1; back < RoadConfig::POTHOLE_MIN_SPACING; ++back)
+    {
+        if (isPotholeCandidate(key - back))
+            return false;
+    }
+    out = makeHashedPothole(m_lapPotholes.at(static_cast<std::uint64_t>(key)), segment);
+    out.wasHit = containsSegment(m_hitPotholes, segment);
+    return true;
+}
+
+// Same rule as findHashedPothole, hashing each segment of the window once
+void Road::collectHashedPotholes(int first, int window, std::vector<Pothole> &out) const
+{
+    out.clear();
+    const int count = getSegmentCount();
+    int lastCandidate = -RoadConfig::POTHOLE_MIN_SPACING;
+    for (int offset = 1 - RoadConfig::POTHOLE_MIN_SPACING; offset < window; ++offset)
+    {
+        const int segment = ((first + offset) % count + count) % count;
+        const std::int64_t key = hazardKey(segment);
+        if (!isPotholeCandidate(key))
+            continue;
+        if (offset >= 0 && offset - lastCandidate >= RoadConfig::POTHOLE_MIN_SPACING)
+        {
+            out.push_back(makeHashedPothole(m_lapPotholes.at(static_cast<std::uint64_t>(key)), segment));
+            out.back().wasHit = containsSegment(m_hitPotholes, segment);
+        }
+        lastCandidate = offset;
+    }
+}
+
+bool Road::hasPothole(int segment) const
+{
+    Pothole pothole;
+    if (m_hashedPotholes)
+        return findHashedPothole(segment, pothole);
+    const std::size_t index = seekHazard(m_potholes, 0, segment);
+    return index < m_potholes.size() && m_potholes[index].segment == segment;
+}
+
 bool Road::checkPotholeCollision(float wheelX, float wheelZ, float &damageOut)
 {
-    RoadSegment *segment = getSegmentAt(wheelZ);
-    if (!segment || !segment->pothole.exists || segment->pothole.wasHit)
+    const int index = getSegmentIndex(wheelZ);
+    Pothole hashed;
+    Pothole *pothole = nullptr;
+    if (index >= 0 && m_hashedPotholes)
+        pothole = findHashedPothole(index, hashed) ? &hashed : nullptr;
+    else if (index >= 0)
+        pothole = findHazard(m_potholes, m_potholeCursor, index);
+    if (!pothole || pothole->wasHit)
     {
         return false;
     }
 
-    float potholeLeft = segment->pothole.offsetX - segment->pothole.width / 2.0f;
-    float potholeRight = segment->pothole.offsetX + segment->pothole.width / 2.0f;
+    float potholeLeft = pothole->offsetX - pothole->width / 2.0f;
+    float potholeRight = pothole->offsetX + pothole->width / 2.0f;
 
     if (wheelX >= potholeLeft && wheelX <= potholeRight)
     {
-        segment->pothole.wasHit = true;
+        pothole->wasHit = true;
+        if (m_hashedPotholes)
+            insertSegment(m_hitPotholes, index);
         damageOut = RoadConfig::POTHOLE_DAMAGE;
         return true;
     }
@@ -246,19 +489,20 @@ bool Road::checkPotholeCollision(float wheelX, float wheelZ, float &damageOut)
 
 bool Road::checkRepairPickupCollision(float playerX, float playerZ, float &healOut)
 {
-    RoadSegment *segment = getSegmentAt(playerZ);
-    if (!segment || !segment->repairPickup.exists || segment->repairPickup.collected)
+    const int index = getSegmentIndex(playerZ);
+    RepairPickup *pickup = index < 0 ? nullptr : findHazard(m_pickups, m_pickupCursor, index);
+    if (!pickup || pickup->collected)
     {
         return false;
     }
 
-    float pickupLeft = segment->repairPickup.offsetX - segment->repairPickup.width / 2.0f;
-    float pickupRight = segment->repairPickup.offsetX + segment->repairPickup.width / 2.0f;
+    float pickupLeft = pickup->offsetX - pickup->width / 2.0f;
+    float pickupRight = pickup->offsetX + pickup->width / 2.0f;
 
     if (playerX >= pickupLeft - 60.0f && playerX <= pickupRight + 60.0f)
     {
-        segment->repairPickup.collected = true;
-        healOut = segment->repairPickup.healAmount;
+        pickup->collected = true;
+        healOut = pickup->healAmount;
         return true;
     }
 
@@ -267,67 +511,129 @@ bool Road::checkRepairPickupCollision(float playerX, float playerZ, float &healO
 
 void Road::resetPotholes()
 {
-    for (auto &seg : m_segments)
+    for (auto &pothole : m_potholes)
     {
-        seg.pothole.wasHit = false;
+        pothole.wasHit = false;
     }
+    m_hitPotholes.clear();
+}
+
+void Road::setLap(int lap)
+{
+    // A streamed road never repeats, its hazards are keyed by absolute segment
+    if (m_streaming)
+        return;
+    m_lapPotholes = RandomStream(m_potholeSeed).fork(static_cast<std::uint64_t>(lap));
 }
 
 void Road::resetPickups()
 {
-    for (auto &seg : m_segments)
+    for (auto &pickup : m_pickups)
     {
-        seg.repairPickup.collected = false;
+        pickup.collected = false;
     }
 }
 
 void Road::addStraight(int startIndex, int count)
 {
-    for (int i = 0; i < count && startIndex + i < static_cast<int>(m_segments.size()); ++i)
+    for (int i = 0; i < count && startIndex + i < getSegmentCount(); ++i)
     {
-        m_segments[startIndex + i].curve = 0.0f;
-        m_segments[startIndex + i].worldY = 0.0f;
+        m_curves[startIndex + i] = 0.0f;
+        m_worldY[startIndex + i] = 0.0f;
     }
 }
 
 void Road::addCurve(int startIndex, int count, float curvature)
 {
-    for (int i = 0; i < count && startIndex + i < static_cast<int>(m_segments.size()); ++i)
+    for (int i = 0; i < count && startIndex + i < getSegmentCount(); ++i)
     {
-        m_segments[startIndex + i].curve = curvature;
+        m_curves[startIndex + i] = curvature;
     }
 }
 
 void Road::addHill(int startIndex, int count, float height)
 {
-    for (int i = 0; i < count && startIndex + i < static_cast<int>(m_segments.size()); ++i)
+    for (int i = 0; i < count && startIndex + i < getSegmentCount(); ++i)
     {
         float t = static_cast<float>(i) / count;
         float calculatedY = std::sin(t * 3.14159f) * height;
-        m_segments[startIndex + i].worldY = calculatedY;
+        m_worldY[startIndex + i] = calculatedY;
     }
 }
 
 void Road::update(float playerZ, float deltaTime)
 {
     m_playerZ = playerZ;
+    if (m_streaming)
+        advanceStream(playerZ);
+
+    // Keep the cursors just behind the player
+    int cursorSegment = getSegmentIndex(playerZ);
+    if (cursorSegment >= 0)
+    {
+        cursorSegment -= HAZARD_CURSOR_MARGIN;
+        if (cursorSegment < 0)
+            cursorSegment += getSegmentCount();
+        m_potholeCursor = seekHazard(m_potholes, m_potholeCursor, cursorSegment);
+        m_pickupCursor = seekHazard(m_pickups, m_pickupCursor, cursorSegment);
+    }
 
-    for (auto &seg : m_segments)
+    // There are only a handful of pickups on a lap
+    for (auto &pickup : m_pickups)
     {
-        if (seg.repairPickup.exists && !seg.repairPickup.collected)
+        if (!pickup.collected)
         {
-            seg.repairPickup.animTimer += deltaTime;
-            seg.repairPickup.bobOffset = std::sin(seg.repairPickup.animTimer * RoadConfig::PICKUP_BOB_SPEED) * RoadConfig::PICKUP_BOB_AMOUNT;
+            pickup.animTimer += deltaTime;
+            pickup.bobOffset = std::sin(pickup.animTimer * RoadConfig::PICKUP_BOB_SPEED) * RoadConfig::PICKUP_BOB_AMOUNT;
         }
     }
 }
 
-void Road::render(sf::RenderWindow &window, float cameraZ)
+void Road::captureRenderState(float cameraZ, RoadRenderState &out) const
 {
-    const float windowWidth = static_cast<float>(window.getSize().x);
-    const float windowHeight = static_cast<float>(window.getSize().y);
+    int index = getSegmentIndex(cameraZ);
+    if (index < 0)
+    {
+        out.segmentCount = 0;
+        out.curves.clear();
+        out.potholes.clear();
+        out.pickups.clear();
+        return;
+    }
 
-    const int trackSegmentCount = static_cast<int>(m_segments.size());
+    // One segment of margin behind the camera for render interpolation
+    const int count = getSegmentCount();
+    if (--index < 0)
+        index += count;
+
+    out.firstSegment = index;
+    out.segmentCount = std::min(count, RoadConfig::DRAW_DISTANCE + 2);
+
+    // render() must not read m_curves: when streaming, update() rewrites the
+    // ring on the simulation thread while the main thread draws
+    out.curves.resize(out.segmentCount);
+    const int firstRun = std::min(out.segmentCount, count - index);
+    std::copy_n(m_curves.begin() + index, firstRun, out.curves.begin());
+    std::copy_n(m_curves.begin(), out.segmentCount - firstRun, out.curves.begin() + firstRun);
+
+    // Sized for the fullest window up front, so steady frames never grow them
+    // (the spacing rule caps the potholes)
+    out.potholes.reserve(out.segmentCount / RoadConfig::POTHOLE_MIN_SPACING + 1);
+    out.pickups.reserve(RENDER_PICKUP_RESERVE);
+    if (m_hashedPotholes)
+        collectHashedPotholes(index, out.segmentCount, out.potholes);
+    else
+        copyHazardWindow(m_potholes, m_potholeCursor, index, out.segmentCount, count, out.potholes);
+    copyHazardWindow(m_pickups, m_pickupCursor, index, out.segmentCount, count, out.pickups);
+}
+
+void Road::render(RenderCommandBuffer &commands, float cameraZ, const RoadRenderState &hazards)
+{
+    PROFILE_SCOPE("Road::render");
+    const float windowWidth = static_cast<float>(commands.getSize().x);
+    const float windowHeight = static_cast<float>(commands.getSize().y);
+
+    const int trackSegmentCount = getSegmentCount();
     const float trackLength = getLength();
 
     float normalizedCameraZ = std::fmod(cameraZ, trackLength);
@@ -336,29 +642,29 @@ void Road::render(sf::RenderWindow &window, float cameraZ)
 
     int baseIndex = static_cast<int>(normalizedCameraZ / RoadConfig::SEGMENT_LENGTH);
 
-    // Background
-    sf::RectangleShape sky(sf::Vector2f(windowWidth, windowHeight * 0.5f));
-    sky.setFillColor(sf::Color(135, 206, 250));
-    window.draw(sky);
+    const RoadPalette &palette = *m_palette;
 
-    sf::RectangleShape ground(sf::Vector2f(windowWidth, windowHeight * 0.5f));
-    ground.setPosition(sf::Vector2f(0.0f, windowHeight * 0.5f));
-    ground.setFillColor(sf::Color(16, 200, 16));
-    window.draw(ground);
+    // Background
+    commands.setLayer(RenderLayer::Background);
+    commands.fillRect(sf::Vector2f(0.0f, 0.0f), sf::Vector2f(windowWidth, windowHeight * 0.5f), palette.sky);
+    commands.fillRect(sf::Vector2f(0.0f, windowHeight * 0.5f), sf::Vector2f(windowWidth, windowHeight * 0.5f), palette.grass[0]);
 
-    std::vector<float> segmentCurves(m_segments.size());
-    for (size_t i = 0; i < m_segments.size(); ++i)
-    {
-        segmentCurves[i] = m_segments[i].curve;
-    }
+    // Transient buffers come from the frame arena, released at the end of the frame
+    FrameArena &arena = FrameArena::getInstance();
 
     float cameraSegmentPos = (normalizedCameraZ - (baseIndex * RoadConfig::SEGMENT_LENGTH)) / RoadConfig::SEGMENT_LENGTH;
 
+    // The snapshot starts at hazards.firstSegment, at most two segments behind baseIndex
+    int windowIndex = baseIndex - hazards.firstSegment;
+    if (windowIndex < 0)
+        windowIndex += trackSegmentCount;
+
     auto curveData = CurveProcessor::processSegmentCurves(
-        segmentCurves,
-        baseIndex,
+        hazards.curves,
+        windowIndex,
         RoadConfig::DRAW_DISTANCE,
-        cameraSegmentPos);
+        cameraSegmentPos,
+        &arena);
 
     const float CURVE_AMPLIFICATION = 2.5f;
 
@@ -370,7 +676,13 @@ void Road::render(sf::RenderWindow &window, float cameraZ)
         float pulse;
         int segmentIndex;
     };
-    std::vector<PickupRenderData> pickupsToRender;
+    FrameVector<PickupRenderData> pickupsToRender(&arena);
+
+    HazardWindowCursor<Pothole> potholes(hazards.potholes, hazards.firstSegment, trackSegmentCount);
+    HazardWindowCursor<RepairPickup> pickups(hazards.pickups, hazards.firstSegment, trackSegmentCount);
+
+    // Scanlines are plain quads; the backend merges them into one batch
+    commands.setLayer(RenderLayer::Road);
 
     for (int y = static_cast<int>(windowHeight); y >= static_cast<int>(windowHeight * 0.5f); --y)
     {
@@ -404,37 +716,25 @@ void Road::render(sf::RenderWindow &window, float cameraZ)
         if (segmentIndex < 0)
             segmentIndex += trackSegmentCount;
 
-        RoadSegment &seg = m_segments[segmentIndex];
+        const int band = RoadPalette::getBand(segmentIndex);
+        const sf::Color rumbleColor = palette.rumble[RoadPalette::getRumble(segmentIndex)];
         float scale = RoadConfig::CAMERA_DEPTH / (z - normalizedCameraZ);
 
         float roadCenterX = windowWidth * 0.5f + (relativeCurve * CURVE_AMPLIFICATION * scale * windowWidth * 0.5f);
         float roadWidth = RoadConfig::ROAD_WIDTH * scale * windowWidth * 0.5f;
 
         // Grass
-        sf::RectangleShape grassLine(sf::Vector2f(windowWidth, 1.0f));
-        grassLine.setPosition(sf::Vector2f(0.0f, static_cast<float>(y)));
-        grassLine.setFillColor(seg.grassColor);
-        window.draw(grassLine);
+        commands.fillRect(sf::Vector2f(0.0f, static_cast<float>(y)), sf::Vector2f(windowWidth, 1.0f), palette.grass[band]);
 
         // Road
         if (roadWidth > 0.5f)
         {
-            sf::RectangleShape roadLine(sf::Vector2f(roadWidth * 2.0f, 1.0f));
-            roadLine.setPosition(sf::Vector2f(roadCenterX - roadWidth, static_cast<float>(y)));
-            roadLine.setFillColor(seg.roadColor);
-            window.draw(roadLine);
+            commands.fillRect(sf::Vector2f(roadCenterX - roadWidth, static_cast<float>(y)), sf::Vector2f(roadWidth * 2.0f, 1.0f), palette.road[band]);
 
             float rumbleWidth = roadWidth * 0.15f;
 
-            sf::RectangleShape leftRumble(sf::Vector2f(rumbleWidth, 1.0f));
-            leftRumble.setPosition(sf::Vector2f(roadCenterX - roadWidth, static_cast<float>(y)));
-            leftRumble.setFillColor(seg.rumbleColor);
-            window.draw(leftRumble);
-
-            sf::RectangleShape rightRumble(sf::Vector2f(rumbleWidth, 1.0f));
-            rightRumble.setPosition(sf::Vector2f(roadCenterX + roadWidth - rumbleWidth, static_cast<float>(y)));
-            rightRumble.setFillColor(seg.rumbleColor);
-            window.draw(rightRumble);
+            commands.fillRect(sf::Vector2f(roadCenterX - roadWidth, static_cast<float>(y)), sf::Vector2f(rumbleWidth, 1.0f), rumbleColor);
+            commands.fillRect(sf::Vector2f(roadCenterX + roadWidth - rumbleWidth, static_cast<float>(y)), sf::Vector2f(rumbleWidth, 1.0f), rumbleColor);
 
             // Start/Finish line - checkered pattern (single segment)
             if (segmentIndex == 0)
@@ -448,32 +748,29 @@ void Road::render(sf::RenderWindow &window, float cameraZ)
                     bool isWhite = (c % 2 == 0);
                     sf::Color checkerColor = isWhite ? sf::Color::White : sf::Color(15, 15, 15);
 
-                    sf::RectangleShape checker(sf::Vector2f(checkerWidth + 1.0f, 1.0f));
-                    checker.setPosition(sf::Vector2f(checkerX, static_cast<float>(y)));
-                    checker.setFillColor(checkerColor);
-                    window.draw(checker);
+                    commands.fillRect(sf::Vector2f(checkerX, static_cast<float>(y)), sf::Vector2f(checkerWidth + 1.0f, 1.0f), checkerColor);
                 }
             }
 
             // Pothole
-            if (seg.pothole.exists)
+            if (const Pothole *visiblePothole = potholes.at(segmentIndex))
             {
-                float potholeScreenX = roadCenterX + (seg.pothole.offsetX / static_cast<float>(RoadConfig::ROAD_WIDTH)) * roadWidth * 2.0f;
-                float potholeScreenWidth = (seg.pothole.width / static_cast<float>(RoadConfig::ROAD_WIDTH)) * roadWidth * 2.0f;
+                const Pothole &pothole = *visiblePothole;
+                float potholeScreenX = roadCenterX + (pothole.offsetX / static_cast<float>(RoadConfig::ROAD_WIDTH)) * roadWidth * 2.0f;
+                float potholeScreenWidth = (pothole.width / static_cast<float>(RoadConfig::ROAD_WIDTH)) * roadWidth * 2.0f;
 
                 potholeScreenWidth = std::max(potholeScreenWidth, 8.0f);
 
-                sf::Color potholeColor = seg.pothole.wasHit ? sf::Color(60, 55, 50) : sf::Color(30, 25, 20);
+                sf::Color potholeColor = pothole.wasHit ? sf::Color(60, 55, 50) : sf::Color(30, 25, 20);
 
-                sf::RectangleShape potholeLine(sf::Vector2f(potholeScreenWidth, 1.0f));
-                potholeLine.setPosition(sf::Vector2f(potholeScreenX - potholeScreenWidth / 2.0f, static_cast<float>(y)));
-                potholeLine.setFillColor(potholeColor);
-                window.draw(potholeLine);
+                commands.fillRect(sf::Vector2f(potholeScreenX - potholeScreenWidth / 2.0f, static_cast<float>(y)), sf::Vector2f(potholeScreenWidth, 1.0f), potholeColor);
             }
 
             // Collect pickup for rendering
-            if (seg.repairPickup.exists && !seg.repairPickup.collected)
+            const RepairPickup *visiblePickup = pickups.at(segmentIndex);
+            if (visiblePickup && !visiblePickup->collected)
             {
+                const RepairPickup &pickup = *visiblePickup;
                 bool alreadyAdded = false;
                 for (const auto &p : pickupsToRender)
                 {
@@ -486,14 +783,14 @@ void Road::render(sf::RenderWindow &window, float cameraZ)
 
                 if (!alreadyAdded)
                 {
-                    float pickupScreenX = roadCenterX + (seg.repairPickup.offsetX / static_cast<float>(RoadConfig::ROAD_WIDTH)) * roadWidth * 2.0f;
+                    float pickupScreenX = roadCenterX + (pickup.offsetX / static_cast<float>(RoadConfig::ROAD_WIDTH)) * roadWidth * 2.0f;
 
                     // Fix: calculate pickup Y relative to the road
                     // Use same logic as road, but shift upward
-                    float floatHeight = RoadConfig::PICKUP_FLOAT_HEIGHT + seg.repairPickup.bobOffset;
+                    float floatHeight = RoadConfig::PICKUP_FLOAT_HEIGHT + pickup.bobOffset;
                     float pickupScreenY = static_cast<float>(y) - floatHeight * scale * 50.0f;
 
-                    float pulse = 0.8f + 0.2f * std::sin(seg.repairPickup.animTimer * 4.0f);
+                    float pulse = 0.8f + 0.2f * std::sin(pickup.animTimer * 4.0f);
 
                     pickupsToRender.push_back({pickupScreenX,
                                                pickupScreenY,
@@ -512,6 +809,7 @@ void Road::render(sf::RenderWindow &window, float cameraZ)
                   return a.scale < b.scale; // far -> near
               });
 
+    commands.setLayer(RenderLayer::Pickups);
     for (const auto &pickup : pickupsToRender)
     {
         if (pickup.scale < 0.00001f)
@@ -539,141 +837,83 @@ void Road::render(sf::RenderWindow &window, float cameraZ)
 
         float outlineThickness = std::max(1.5f, size * 0.08f);
 
-        // Cross - vertical bar
-        sf::RectangleShape verticalBar(sf::Vector2f(crossWidth, crossLength));
-        verticalBar.setOrigin(sf::Vector2f(crossWidth / 2.0f, crossLength / 2.0f));
-        verticalBar.setPosition(sf::Vector2f(pickup.screenX, pickup.screenY));
-        verticalBar.setFillColor(crossColor);
-        verticalBar.setOutlineColor(sf::Color(120, 255, 120));
-        verticalBar.setOutlineThickness(outlineThickness);
-
-        // Cross - horizontal bar
-        sf::RectangleShape horizontalBar(sf::Vector2f(crossLength, crossWidth));
-        horizontalBar.setOrigin(sf::Vector2f(crossLength / 2.0f, crossWidth / 2.0f));
-        horizontalBar.setPosition(sf::Vector2f(pickup.screenX, pickup.screenY));
-        horizontalBar.setFillColor(crossColor);
-        horizontalBar.setOutlineColor(sf::Color(120, 255, 120));
-        horizontalBar.setOutlineThickness(outlineThickness);
+        const sf::Vector2f pickupCenter(pickup.screenX, pickup.screenY);
+        const sf::Color outlineColor(120, 255, 120);
 
         // Glow effect - larger
         float glowRadius = size * 1.0f;
-        sf::CircleShape glow(glowRadius);
-        glow.setOrigin(sf::Vector2f(glowRadius, glowRadius));
-        glow.setPosition(sf::Vector2f(pickup.screenX, pickup.screenY));
-        glow.setFillColor(sf::Color(50, 255, 50, static_cast<std::uint8_t>(50 * pickup.pulse)));
+        commands.drawCircle(pickupCenter, glowRadius, sf::Color(50, 255, 50, static_cast<std::uint8_t>(50 * pickup.pulse)));
 
-        window.draw(glow);
-        window.draw(verticalBar);
-        window.draw(horizontalBar);
+        // Cross - vertical bar
+        commands.drawRect(pickupCenter - sf::Vector2f(crossWidth / 2.0f, crossLength / 2.0f),
+                          sf::Vector2f(crossWidth, crossLength), crossColor, outlineColor, outlineThickness);
+
+        // Cross - horizontal bar
+        commands.drawRect(pickupCenter - sf::Vector2f(crossLength / 2.0f, crossWidth / 2.0f),
+                          sf::Vector2f(crossLength, crossWidth), crossColor, outlineColor, outlineThickness);
 
         // Bright center - larger
         float centerRadius = crossWidth * 0.5f;
-        sf::CircleShape center(centerRadius);
-        center.setOrigin(sf::Vector2f(centerRadius, centerRadius));
-        center.setPosition(sf::Vector2f(pickup.screenX, pickup.screenY));
-        center.setFillColor(sf::Color(220, 255, 220, static_cast<std::uint8_t>(240 * pickup.pulse)));
-        window.draw(center);
+        commands.drawCircle(pickupCenter, centerRadius, sf::Color(220, 255, 220, static_cast<std::uint8_t>(240 * pickup.pulse)));
     }
 }
 
 void Road::setSegmentCurve(int index, float curve)
 {
-    if (index >= 0 && index < static_cast<int>(m_segments.size()))
-    {
-        m_segments[index].curve = curve;
-    }
-}
-
-void Road::project(RoadSegment &segment, float cameraX, float cameraY, float cameraZ)
-{
-    auto &settings = SettingsManager::getInstance();
-    const float windowWidth = static_cast<float>(settings.getWindowWidth());
-    const float windowHeight = static_cast<float>(settings.getWindowHeight());
-    ;
-
-    float relativeZ = segment.worldZ - cameraZ;
-
-    if (relativeZ <= 0)
+    if (index >= 0 && index < getSegmentCount())
     {
-        segment.scale = -1.0f;
-        return;
+        m_curves[index] = curve;
     }
-
-    segment.scale = RoadConfig::CAMERA_DEPTH / relativeZ;
-    segment.screenX = windowWidth * 0.5f + (segment.curve - cameraX) * segment.scale * windowWidth;
-    segment.screenY = windowHeight * 0.5f + (cameraY - segment.worldY) * segment.scale * windowHeight;
-    segment.screenW = RoadConfig::ROAD_WIDTH * segment.scale * windowWidth * 0.5f;
 }
 
 float Road::getCurveAt(float z) const
 {
-    const RoadSegment *segment = getSegmentAt(z);
-    return segment ? segment->curve : 0.0f;
+    const int index = getSegmentIndex(z);
+    return index >= 0 ? m_curves[index] : 0.0f;
 }
 
-RoadSegment *Road::getSegmentAt(float z)
+float Road::getCurveAhead(float z, int segmentsAhead) const
 {
-    if (m_segments.empty())
-        return nullptr;
+    int index = getSegmentIndex(z);
+    if (index < 0 || segmentsAhead <= 0)
+        return 0.0f;
 
-    const float trackLength = getLength();
-    float normalizedZ = std::fmod(z, trackLength);
-    if (normalizedZ < 0.0f)
-        normalizedZ += trackLength;
-
-    int index = static_cast<int>(normalizedZ / RoadConfig::SEGMENT_LENGTH) % m_segments.size();
-    if (index < 0)
-        index += static_cast<int>(m_segments.size());
-
-    return &m_segments[index];
+    const int count = getSegmentCount();
+    float sum = 0.0f;
+    for (int i = 0; i < segmentsAhead; ++i)
+    {
+        sum += m_curves[index];
+        if (++index == count)
+            index = 0;
+    }
+    return sum;
 }
 
-const RoadSegment *Road::getSegmentAt(float z) const
+int Road::getSegmentIndex(float z) const
 {
-    if (m_segments.empty())
-        return nullptr;
+    if (m_curves.empty())
+        return -1;
 
+    const int count = getSegmentCount();
     const float trackLength = getLength();
     float normalizedZ = std::fmod(z, trackLength);
     if (normalizedZ < 0.0f)
         normalizedZ += trackLength;
 
-    int index = static_cast<int>(normalizedZ / RoadConfig::SEGMENT_LENGTH) % m_segments.size();
+    int index = static_cast<int>(normalizedZ / RoadConfig::SEGMENT_LENGTH) % count;
     if (index < 0)
-        index += static_cast<int>(m_segments.size());
+        index += count;
 
-    return &m_segments[index];
+    return index;
 }
 
 // Add a new function for Campaign:
 
 void Road::generateForCampaign(int segmentCount)
 {
-    m_segments.clear();
-    m_segments.reserve(segmentCount);
-
-    const int COLOR_PATTERN_LENGTH = 6;
-    int adjustedCount = ((segmentCount + COLOR_PATTERN_LENGTH - 1) / COLOR_PATTERN_LENGTH) * COLOR_PATTERN_LENGTH;
-
-    for (int i = 0; i < adjustedCount; ++i)
-    {
-        RoadSegment segment;
-        segment.worldZ = i * RoadConfig::SEGMENT_LENGTH;
-        segment.curve = 0.0f;
-        segment.worldY = 0.0f;
-
-        bool isDark = ((i / 3) % 2) == 0;
-        segment.roadColor = isDark ? sf::Color(107, 107, 107) : sf::Color(105, 105, 105);
-        segment.grassColor = isDark ? sf::Color(16, 200, 16) : sf::Color(0, 154, 0);
-        segment.rumbleColor = (i % 3 == 0) ? sf::Color::Red : sf::Color::White;
-        segment.laneColor = sf::Color::White;
-
-        // No potholes or pickups in Campaign
-        segment.pothole.exists = false;
-        segment.repairPickup.exists = false;
-
-        m_segments.push_back(segment);
-    }
+    // No potholes or pickups in Campaign
+    createSegments(segmentCount);
+    const int adjustedCount = getSegmentCount();
 
     // Road layout (curves, hills)
     int pos = 0;
@@ -692,37 +932,117 @@ void Road::generateForCampaign(int segmentCount)
     std::cout << "[ROAD] Generated for Campaign mode (no obstacles)" << std::endl;
 }
 
-// Add this function after init():
-void Road::initClean(int segmentCount)
+void Road::generateStreaming(const EndlessDifficultySettings &settings)
 {
-    m_segments.clear();
-    m_segments.reserve(segmentCount);
+    m_potholeChance = settings.potholeChance;
+    m_repairChance = settings.repairPickupChance;
 
-    const int COLOR_PATTERN_LENGTH = 6;
-    int adjustedCount = ((segmentCount + COLOR_PATTERN_LENGTH - 1) / COLOR_PATTERN_LENGTH) * COLOR_PATTERN_LENGTH;
+    createSegments(RoadConfig::STREAM_CAPACITY);
+    m_potholeCount = 0;
+    m_streaming = true;
+    m_streamHead = 0;
+    m_streamPlayer = 0;
+    m_streamPickupCount = RoadConfig::PICKUPS_LOW_DAMAGE;
+    m_streamDifficulty = EndlessDifficulty{};
+
+    // Potholes are hashed like on any long road, but never re-keyed per lap
+    m_hashedPotholes = true;
+    m_potholeSeed = m_rng();
+    m_lapPotholes = RandomStream(m_potholeSeed);
+
+    // The start line sits on a straight, as on the old loop
+    m_streamSection = StreamSection{};
+    m_streamSection.length = getSegmentCount() / 6;
+    streamSegments(getSegmentCount());
+
+    std::cout << "[ROAD] Streaming " << getSegmentCount() << " segments with " << settings.name << " difficulty" << std::endl;
+}
 
-    for (int i = 0; i < adjustedCount; ++i)
-    {
-        RoadSegment segment;
-        segment.worldZ = i * RoadConfig::SEGMENT_LENGTH;
-        segment.curve = 0.0f;
-        segment.worldY = 0.0f;
+// Follows the player around the ring and keeps STREAM_LOOKAHEAD segments
+// generated ahead: the render window is generated right away if needed, the
+// rest at STREAM_SEGMENTS_PER_TICK so the cost per tick stays flat
+void Road::advanceStream(float playerZ)
+{
+    const int count = getSegmentCount();
+    const int segment = getSegmentIndex(playerZ);
+    int delta = segment - static_cast<int>((m_streamPlayer % count + count) % count);
+    if (delta > count / 2)
+        delta -= count;
+    else if (delta < -count / 2)
+        delta += count;
+    m_streamPlayer += delta;
+
+    const std::int64_t needed = m_streamPlayer + RoadConfig::DRAW_DISTANCE + 2 - m_streamHead;
+    const std::int64_t wanted = m_streamPlayer + RoadConfig::STREAM_LOOKAHEAD - m_streamHead;
+    const std::int64_t budget = std::max<std::int64_t>(RoadConfig::STREAM_SEGMENTS_PER_TICK, needed);
+    const std::int64_t generate = std::min(budget, wanted);
+    if (generate > 0)
+        streamSegments(static_cast<int>(generate));
+}
+
+// Overwrites the oldest slots with the next segments of the current section,
+// dropping whatever hazard state the slots had
+void Road::streamSegments(int count)
+{
+    const int segmentCount = getSegmentCount();
+    const float pickupChance = static_cast<float>(m_streamPickupCount) / segmentCount;
 
-        bool isDark = ((i / 3) % 2) == 0;
-        segment.roadColor = isDark ? sf::Color(107, 107, 107) : sf::Color(105, 105, 105);
-        segment.grassColor = isDark ? sf::Color(16, 200, 16) : sf::Color(0, 154, 0);
-        segment.rumbleColor = (i % 3 == 0) ? sf::Color::Red : sf::Color::White;
-        segment.laneColor = sf::Color::White;
+    for (int n = 0; n < count; ++n)
+    {
+        if (m_streamSection.done >= m_streamSection.length)
+            startStreamSection();
+
+        const int slot = static_cast<int>(m_streamHead % segmentCount);
+        const StreamSection &section = m_streamSection;
+        m_curves[slot] = section.curve;
+        m_worldY[slot] = section.hill != 0.0f
+                             ? std::sin(static_cast<float>(section.done) / section.length * 3.14159f) * section.hill
+                             : 0.0f;
+        ++m_streamSection.done;
+        const std::int64_t absolute = m_streamHead++;
+
+        eraseSegment(m_hitPotholes, slot);
+        const std::size_t old = seekHazard(m_pickups, m_pickupCursor, slot);
+        if (old < m_pickups.size() && m_pickups[old].segment == slot)
+            m_pickups.erase(m_pickups.begin() + old);
+
+        if (absolute >= RoadConfig::HAZARD_FREE_START && m_rng.chance(pickupChance) && !hasPothole(slot))
+            insertPickup(slot);
+    }
+}
 
-        // Do not generate potholes or pickups
-        segment.pothole.exists = false;
-        segment.pothole.wasHit = false;
-        segment.repairPickup.exists = false;
-        segment.repairPickup.collected = false;
+// Picks the next stretch: higher levels give shorter straights and, through
+// the curve multiplier, sharper curves
+void Road::startStreamSection()
+{
+    const int level = std::clamp(m_streamDifficulty.level, 1, 10);
 
-        m_segments.push_back(segment);
+    StreamSection section;
+    const float roll = m_rng.nextFloat();
+    if (roll < 0.4f)
+    {
+        section.length = m_rng.rangeInt(40, 90) - 3 * (level - 1);
+    }
+    else if (roll < 0.8f)
+    {
+        const float direction = m_rng.chance(0.5f) ? 1.0f : -1.0f;
+        section.length = m_rng.rangeInt(40, 80);
+        section.curve = direction * m_rng.range(4.0f, 8.0f) * m_streamDifficulty.curveMultiplier;
+    }
+    else
+    {
+        section.length = m_rng.rangeInt(60, 100);
+        section.hill = m_rng.range(300.0f, 600.0f);
     }
+    m_streamSection = section;
+}
+
+// Add this function after init():
+void Road::initClean(int segmentCount)
+{
+    // Do not generate potholes or pickups
+    createSegments(segmentCount);
 
     m_potholeCount = 0;
-    std::cout << "[ROAD] Initialized clean (no obstacles): " << m_segments.size() << " segments" << std::endl;
+    std::cout << "[ROAD] Initialized clean (no obstacles): " << m_curves.size() << " segments" << std::endl;
 }
@@ -1,10 +1,12 @@
 ﻿#pragma once
 #include <SFML/Graphics.hpp>
+#include <string>
 #include <vector>
-#include <random>
 #include "GameModeConfig.h"
+#include "Core/Random.h"
 
 class CurveProcessor;
+class RenderCommandBuffer;
 
 namespace RoadConfig {
     constexpr float SEGMENT_LENGTH = 10.0f;
@@ -19,6 +21,10 @@ namespace RoadConfig {
     constexpr float POTHOLE_DAMAGE = 5.0f;
     constexpr float POTHOLE_MIN_WIDTH = 80.0f;
     constexpr float POTHOLE_MAX_WIDTH = 150.0f;
+    constexpr int POTHOLE_MIN_SPACING = 5;         // segments between two potholes
+    constexpr int HAZARD_FREE_START = 50;          // segments after the start line
+    // From this length on potholes are hashed from (seed, lap, segment) instead of stored
+    constexpr int HASHED_POTHOLE_MIN_SEGMENTS = 10000;
     
     // Repair pickup settings
     constexpr float REPAIR_SPAWN_CHANCE = 0.05f;
@@ -31,45 +37,62 @@ namespace RoadConfig {
     constexpr int PICKUPS_LOW_DAMAGE = 5;      // 0-29 DMG: 5 pickups per turn
     constexpr int PICKUPS_MED_DAMAGE = 3;      // 30-49 DMG: 3 pickups per turn
     constexpr int PICKUPS_HIGH_DAMAGE = 1;     // 50+ DMG: 1 pickup per turn
+
+    // Endless streaming: a ring of segments generated ahead of the player and
+    // recycled behind; one trip around it (a lap) is as long as the old loop
+    constexpr int STREAM_CAPACITY = 504;                // whole colour patterns
+    constexpr int STREAM_LOOKAHEAD = DRAW_DISTANCE + 20;
+    constexpr int STREAM_SEGMENTS_PER_TICK = 4;
+    static_assert(STREAM_LOOKAHEAD + 16 < STREAM_CAPACITY, "the ring must keep the segments behind the camera");
 }
 
 struct Pothole {
+    int segment = 0;
     float offsetX = 0.0f;
     float width = 150.0f;
-    bool exists = false;
     bool wasHit = false;
 };
 
 struct RepairPickup {
+    int segment = 0;
     float offsetX = 0.0f;
     float width = 100.0f;
-    bool exists = false;
     bool collected = false;
     float healAmount = 25.0f;
     float animTimer = 0.0f;
     float bobOffset = 0.0f;
 };
 
-class RoadSegment {
-public:
-    RoadSegment();
+// Colours of a road theme. Segments store no colours: the renderer derives
+// them from the segment index (bands of 3 segments alternate dark and light,
+// every third rumble strip is marked), so a theme switch only swaps the palette.
+struct RoadPalette {
+    sf::Color sky;
+    sf::Color road[2];          // dark band, light band
+    sf::Color grass[2];
+    sf::Color rumble[2];        // marked, plain
+    sf::Color lane;
 
-    float worldZ;
-    float curve;
-    float worldY;
+    static int getBand(int segmentIndex) { return (segmentIndex / 3) % 2; }
+    static int getRumble(int segmentIndex) { return segmentIndex % 3 == 0 ? 0 : 1; }
 
-    sf::Color roadColor;
-    sf::Color grassColor;
-    sf::Color rumbleColor;
-    sf::Color laneColor;
+    // Campaign track ids with their own look ("desert", "night_city",
+    // "forest"); anything else gets the default green countryside
+    static const RoadPalette& getPalette(const std::string& theme);
+};
 
-    float screenX;
-    float screenY;
-    float screenW;
-    float scale;
-    
-    Pothole pothole;
-    RepairPickup repairPickup;
+// Curves and hazards of the segments in view, copied once per frame so the
+// simulation can stream segments, hit potholes and collect pickups while the
+// copy is being drawn. All lists are in road order starting at firstSegment.
+// The window starts one segment behind the older player pose and the camera
+// moves less than a segment per tick (see GameplayManager), so it covers the
+// DRAW_DISTANCE segments ahead of any interpolated camera.
+struct RoadRenderState {
+    int firstSegment = 0;
+    int segmentCount = 0;           // segments in the window, 0 when empty
+    std::vector<float> curves;      // one per segment in the window
+    std::vector<Pothole> potholes;
+    std::vector<RepairPickup> pickups;
 };
 
 class Road {
@@ -78,17 +101,24 @@ public:
 
     void generate(int segmentCount);
     void generateWithDifficulty(int segmentCount, EndlessDifficultyLevel difficulty);
+    void generateWithDifficulty(int segmentCount, const EndlessDifficultySettings& settings);
     void init(int segmentCount);
     void initClean(int segmentCount);  // Pentru Campaign - fără gropi și pickup-uri
     void update(float playerZ, float deltaTime);
-    void render(sf::RenderWindow& window, float cameraZ);
+    void render(RenderCommandBuffer& commands, float cameraZ, const RoadRenderState& hazards);
+    void captureRenderState(float cameraZ, RoadRenderState& out) const;
 
     float getCurveAt(float z) const;
-    RoadSegment* getSegmentAt(float z);
-    const RoadSegment* getSegmentAt(float z) const;
+    // Sum of the curves of the next segmentsAhead segments starting at z (wraps around)
+    float getCurveAhead(float z, int segmentsAhead) const;
+    // Index of the segment under z (wraps around), -1 on an empty road
+    int getSegmentIndex(float z) const;
 
-    int getSegmentCount() const { return static_cast<int>(m_segments.size()); }
-    float getLength() const { return m_segments.size() * RoadConfig::SEGMENT_LENGTH; }
+    int getSegmentCount() const { return static_cast<int>(m_curves.size()); }
+    float getLength() const { return m_curves.size() * RoadConfig::SEGMENT_LENGTH; }
+
+    float getSegmentCurve(int index) const { return m_curves[index]; }
+    float getSegmentWorldY(int index) const { return m_worldY[index]; }
 
     void addStraight(int startIndex, int count);
     void addCurve(int startIndex, int count, float curvature);
@@ -99,6 +129,9 @@ public:
     void generatePotholesWithChance(float chance);
     bool checkPotholeCollision(float wheelX, float wheelZ, float& damageOut);
     void resetPotholes();
+    // Hashed potholes get a new layout every lap; stored ones keep theirs
+    void setLap(int lap);
+    bool hasHashedPotholes() const { return m_hashedPotholes; }
     
     void generateRepairPickups(float chance);
     void generateRepairPickupsFixed(int count);
@@ -111,14 +144,76 @@ public:
     
     void generateForCampaign(int segmentCount);
 
+    // Endless: STREAM_CAPACITY segments laid out ahead of the player by
+    // update(), a few per tick, so the road never repeats
+    void generateStreaming(const EndlessDifficultySettings& settings);
+    bool isStreaming() const { return m_streaming; }
+    // Applies to the segments generated from now on
+    void setStreamDifficulty(const EndlessDifficulty& difficulty) { m_streamDifficulty = difficulty; }
+
+    // Hazard/pickup placement stream (defaults to the global "road" stream)
+    void setRandomStream(const RandomStream& stream) { m_rng = stream; }
+
+    // Takes effect on the next render; the palette must outlive the road
+    void setPalette(const RoadPalette& palette) { m_palette = &palette; }
+    const RoadPalette& getPalette() const { return *m_palette; }
+
 private:
-    std::vector<RoadSegment> m_segments;
+    // Segments are stored as parallel arrays of geometry. Segment i starts at
+    // z = i * SEGMENT_LENGTH; its colours come from m_palette.
+    std::vector<float> m_curves;
+    std::vector<float> m_worldY;
+    const RoadPalette* m_palette;
+
+    // Hazards only exist on a few segments: sorted by segment, each list with
+    // a cursor at the first entry around the player (moved by update), so
+    // collisions look at a handful of entries and lap resets are O(hazards)
+    std::vector<Pothole> m_potholes;
+    std::vector<RepairPickup> m_pickups;
+    std::size_t m_potholeCursor = 0;
+    std::size_t m_pickupCursor = 0;
+
+    // Long roads store no potholes: segment i has one if a counter-based hash
+    // of (seed, lap, i) says so, and only the segments hit this lap are kept
+    bool m_hashedPotholes = false;
+    std::uint64_t m_potholeSeed = 0;
+    RandomStream m_lapPotholes;             // keyed by seed and lap, indexed by segment
+    std::vector<int> m_hitPotholes;         // sorted, reserved up front: hits don't allocate
+
+    // Streaming: slot s holds the segment of [m_streamHead - count, m_streamHead)
+    // whose absolute index is s modulo count; hashed hazards use that index
+    struct StreamSection {
+        int length = 0;
+        int done = 0;
+        float curve = 0.0f;
+        float hill = 0.0f;
+    };
+    bool m_streaming = false;
+    std::int64_t m_streamHead = 0;              // next absolute segment to generate
+    std::int64_t m_streamPlayer = 0;            // absolute segment under the player
+    int m_streamPickupCount = RoadConfig::PICKUPS_LOW_DAMAGE;  // per lap
+    EndlessDifficulty m_streamDifficulty;
+    StreamSection m_streamSection;
+
     float m_playerZ;
-    std::mt19937 m_rng;
+    RandomStream m_rng;
     
     float m_potholeChance = RoadConfig::POTHOLE_SPAWN_CHANCE;
     float m_repairChance = RoadConfig::REPAIR_SPAWN_CHANCE;
     int m_potholeCount = 0;
 
-    void project(RoadSegment& segment, float cameraX, float cameraY, float cameraZ);
+    // Flat, straight segments without hazards; the count is rounded up to
+    // whole colour patterns so the bands line up across the start line
+    void createSegments(int segmentCount);
+
+    std::int64_t hazardKey(int segment) const;
+    bool isPotholeCandidate(std::int64_t key) const;
+    bool findHashedPothole(int segment, Pothole& out) const;
+    void collectHashedPotholes(int first, int window, std::vector<Pothole>& out) const;
+    bool hasPothole(int segment) const;
+    void insertPickup(int segment);
+
+    void advanceStream(float playerZ);
+    void streamSegments(int count);
+    void startStreamSection();
 };
\ No newline at end of file
@@ -66,7 +66,7 @@ void TrackBuilder::smoothLoopTransition(Road& road, int totalSegments) {
     // Calculate total curve accumulation over the entire track
     float totalCurveSum = 0.0f;
     for (int i = 0; i < totalSegments; ++i) {
-        totalCurveSum += road.getSegmentAt(i * 10.0f)->curve;
+        totalCurveSum += road.getSegmentCurve(i);
     }
     
     // If the track doesn't loop back (total curve != 0), apply correction
@@ -79,16 +79,11 @@ void TrackBuilder::smoothLoopTransition(Road& road, int totalSegments) {
             float smoothFactor = 0.5f * (1.0f - std::cos(t * 3.14159f)); // Smooth S-curve
             
             // Correct start of track
-            RoadSegment* startSeg = road.getSegmentAt(i * 10.0f);
-            if (startSeg) {
-                startSeg->curve += correction * smoothFactor;
-            }
+            road.setSegmentCurve(i, road.getSegmentCurve(i) + correction * smoothFactor);
             
             // Correct end of track
-            RoadSegment* endSeg = road.getSegmentAt((totalSegments - TRANSITION_LENGTH + i) * 10.0f);
-            if (endSeg) {
-                endSeg->curve += correction * (1.0f - smoothFactor);
-            }
+            const int endIndex = totalSegments - TRANSITION_LENGTH + i;
+            road.setSegmentCurve(endIndex, road.getSegmentCurve(endIndex) + correction * (1.0f - smoothFactor));
         }
         
         std::cout << "      Applied curve correction: " << correction << " per segment" << std::endl;
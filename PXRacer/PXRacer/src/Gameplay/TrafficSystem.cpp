@@ -1,8 +1,9 @@
 ﻿#include "TrafficSystem.h"
-#include <random>
+#include "Rendering/RenderCommandBuffer.h"
+#include "Core/FrameArena.h"
+#include "Core/Profiler.h"
 #include <algorithm>
 #include <cmath>
-#include <filesystem>
 
 namespace TrafficConfig {
     constexpr float CAMERA_HEIGHT = 1500.0f;
@@ -11,59 +12,72 @@ namespace TrafficConfig {
     constexpr float PLAYER_Z_OFFSET = 85.0f;
     constexpr float TRAFFIC_SIZE_MULT = 2.1f;
     constexpr float CLIP_BEHIND_DISTANCE = -150.0f;
+    constexpr int TEXTURE_VARIANTS = 4;
 }
 
 TrafficSystem::TrafficSystem() {}
 
-void TrafficSystem::init(float trackLength) {
+void TrafficSystem::init(float trackLength, RandomStream rng) {
     m_trackLength = trackLength;
     m_cars.clear();
-    std::mt19937 rng(std::random_device{}());
-    std::uniform_real_distribution<float> distZ(0.0f, trackLength);
-    std::uniform_real_distribution<float> speedDist(40.0f, 85.0f);
     float lanes[] = { -550.0f, 0.0f, 550.0f };
 
     for (int i = 0; i < 25; ++i) {
         TrafficCar car;
-        car.worldZ = distZ(rng);
+        car.worldZ = rng.range(0.0f, trackLength);
+        car.previousZ = car.worldZ;
         car.worldX = lanes[i % 3];
-        car.speed = speedDist(rng);
+        car.speed = rng.range(40.0f, 85.0f);
         car.width = 180.0f; car.height = 240.0f;
         m_cars.push_back(car);
     }
 
-    namespace fs = std::filesystem;
-    for (int i = 1; i <= 4; ++i) {
+    // Texture variant is rolled up front so the layout doesn't depend on which assets exist
+    for (auto& c : m_cars) c.texIndex = rng.rangeInt(0, TrafficConfig::TEXTURE_VARIANTS - 1);
+}
+
+// Called lazily from render() so headless simulation never touches the GPU
+void TrafficSystem::loadTextures() {
+    m_trafficTexturesRequested = true;
+    for (int i = 1; i <= TrafficConfig::TEXTURE_VARIANTS; ++i) {
         sf::Texture tex;
         if (tex.loadFromFile("assets/textures/traffic_car_" + std::to_string(i) + ".png"))
             m_trafficTextures.push_back(std::move(tex));
     }
     m_trafficTexturesLoaded = !m_trafficTextures.empty();
-    if (m_trafficTexturesLoaded) {
-        std::uniform_int_distribution<int> tDist(0, (int)m_trafficTextures.size() - 1);
-        for (auto& c : m_cars) c.texIndex = tDist(rng);
-    }
+}
+
+void TrafficSystem::savePreviousState() {
+    for (auto& car : m_cars) car.previousZ = car.worldZ;
 }
 
 void TrafficSystem::update(float deltaTime, float trackLength, float playerZ, float playerSpeed) {
+    PROFILE_SCOPE("TrafficSystem::update");
     m_trackLength = trackLength;
     for (auto& car : m_cars) {
         car.worldZ += car.speed * deltaTime;
-        if (car.worldZ >= trackLength) car.worldZ -= trackLength;
-        if (car.worldZ < 0) car.worldZ += trackLength;
+        // Wrap previousZ along with worldZ so interpolation stays continuous
+        if (car.worldZ >= trackLength) { car.worldZ -= trackLength; car.previousZ -= trackLength; }
+        if (car.worldZ < 0) { car.worldZ += trackLength; car.previousZ += trackLength; }
     }
 }
 
-void TrafficSystem::render(sf::RenderWindow& window, float cameraZ, float cameraX) {
-    sf::Vector2u winSize = window.getSize();
+void TrafficSystem::render(RenderCommandBuffer& commands, const std::vector<TrafficCar>& cars, float trackLength,
+                           float cameraZ, float cameraX, float alpha) {
+    PROFILE_SCOPE("TrafficSystem::render");
+    if (!m_trafficTexturesRequested) loadTextures();
+
+    sf::Vector2u winSize = commands.getSize();
     float halfW = static_cast<float>(winSize.x) / 2.0f;
     float halfH = static_cast<float>(winSize.y) / 2.0f;
 
-    std::vector<std::pair<float, TrafficCar*>> renderList;
-    for (auto& car : m_cars) {
-        float dz = car.worldZ - cameraZ;
-        if (dz < -m_trackLength / 2.0f) dz += m_trackLength;
-        else if (dz > m_trackLength / 2.0f) dz -= m_trackLength;
+    FrameVector<std::pair<float, const TrafficCar*>> renderList(&FrameArena::getInstance());
+    renderList.reserve(cars.size());
+    for (const auto& car : cars) {
+        float carZ = car.previousZ + (car.worldZ - car.previousZ) * alpha;
+        float dz = carZ - cameraZ;
+        if (dz < -trackLength / 2.0f) dz += trackLength;
+        else if (dz > trackLength / 2.0f) dz -= trackLength;
 
         if (dz > TrafficConfig::CLIP_BEHIND_DISTANCE && dz < TrafficConfig::DRAW_DISTANCE)
             renderList.push_back({ dz, &car });
@@ -73,9 +87,11 @@ void TrafficSystem::render(sf::RenderWindow& window, float cameraZ, float camera
         return a.first > b.first;
         });
 
+    // Cars at the same depth may be drawn in any order, so let the buffer group them by texture
+    commands.setLayer(RenderLayer::Traffic, true);
     for (auto& item : renderList) {
         float dz = item.first;
-        TrafficCar* car = item.second;
+        const TrafficCar* car = item.second;
         float projectedZ = dz + TrafficConfig::PLAYER_Z_OFFSET;
         if (projectedZ <= 1.0f) projectedZ = 1.0f;
 
@@ -90,12 +106,14 @@ void TrafficSystem::render(sf::RenderWindow& window, float cameraZ, float camera
         float drawH = car->height * finalScale;
 
         if (m_trafficTexturesLoaded) {
-            sf::Sprite spr(m_trafficTextures[car->texIndex]);
-            sf::Vector2u ts = m_trafficTextures[car->texIndex].getSize();
+            const sf::Texture& tex = m_trafficTextures[car->texIndex % m_trafficTextures.size()];
+            sf::Sprite spr(tex);
+            sf::Vector2u ts = tex.getSize();
             spr.setOrigin(sf::Vector2f(static_cast<float>(ts.x) / 2.0f, static_cast<float>(ts.y)));
             spr.setScale(sf::Vector2f(drawW / ts.x, drawH / ts.y));
             spr.setPosition(sf::Vector2f(screenX, screenY));
-            window.draw(spr);
+            commands.setDepth(dz / TrafficConfig::DRAW_DISTANCE);
+            commands.draw(spr);
         }
     }
 }
\ No newline at end of file
@@ -1,9 +1,13 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include "Core/Random.h"
+
+class RenderCommandBuffer;
 
 struct TrafficCar {
     float worldZ; float worldX; float speed;
+    float previousZ = 0.0f;   // worldZ at the start of the tick, for render interpolation
     float width = 160.0f; float height = 220.0f;
     sf::Color color; int texIndex = 0;
 };
@@ -11,13 +15,22 @@ struct TrafficCar {
 class TrafficSystem {
 public:
     TrafficSystem();
-    void init(float trackLength);
+    void init(float trackLength, RandomStream rng = RandomService::getInstance().stream("traffic"));
+    void savePreviousState();
     void update(float deltaTime, float trackLength, float playerZ, float playerSpeed);
-    void render(sf::RenderWindow& window, float cameraZ, float cameraX);
+    // Draws a copy of the cars (see GameplayRenderState) so the simulation can run meanwhile
+    void render(RenderCommandBuffer& commands, const std::vector<TrafficCar>& cars, float trackLength,
+                float cameraZ, float cameraX, float alpha = 1.0f);
+
+    const std::vector<TrafficCar>& getCars() const { return m_cars; }
+    float getTrackLength() const { return m_trackLength; }
 
 private:
+    void loadTextures();
+
     std::vector<TrafficCar> m_cars;
     float m_trackLength = 0.0f;
     std::vector<sf::Texture> m_trafficTextures;
     bool m_trafficTexturesLoaded = false;
+    bool m_trafficTexturesRequested = false;
 };
\ No newline at end of file
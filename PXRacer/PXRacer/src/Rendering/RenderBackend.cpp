@@ -0,0 +1,208 @@
+#include "RenderBackend.h"
+#include "RenderCommandBuffer.h"
+#include "Core/Profiler.h"
+#include <cmath>
+
+namespace {
+    constexpr float PI = 3.14159265358979f;
+
+    sf::Vector2f computeNormal(sf::Vector2f p1, sf::Vector2f p2) {
+        sf::Vector2f normal(p1.y - p2.y, p2.x - p1.x);
+        const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+        if (length != 0.0f) normal /= length;
+        return normal;
+    }
+
+    float dot(sf::Vector2f a, sf::Vector2f b) {
+        return a.x * b.x + a.y * b.y;
+    }
+
+    void appendTriangle(std::vector<sf::Vertex>& out, sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Color color) {
+        out.push_back({ a, color, {} });
+        out.push_back({ b, color, {} });
+        out.push_back({ c, color, {} });
+    }
+}
+
+void RenderBackend::execute(const RenderCommandBuffer& commands) {
+    PROFILE_SCOPE("RenderBackend::execute");
+    m_stats = RenderStats{};
+    m_vertices.clear();
+    // Room for the buffer's worst case of quads, so a steady frame doesn't reallocate
+    m_vertices.reserve(commands.getCommands().capacity() * 6);
+    m_batchTexture = nullptr;
+    m_boundTexture = nullptr;
+    m_hasBound = false;
+
+    for (const RenderCommand& cmd : commands.getCommands()) {
+        m_stats.commands++;
+
+        // Anything that can't join the current batch closes it
+        const sf::Texture* texture = nullptr;
+        if (cmd.type == RenderCommandType::Sprite) texture = commands.getSprite(cmd.index).texture;
+        if (cmd.type == RenderCommandType::Vertices) texture = commands.getVertices(cmd.index).texture;
+        if (cmd.type == RenderCommandType::Text || texture != m_batchTexture) flush();
+
+        switch (cmd.type) {
+        case RenderCommandType::Quad: {
+            const QuadCommand& quad = commands.getQuad(cmd.index);
+            const sf::Vector2f topLeft = quad.rect.position;
+            const sf::Vector2f bottomRight = quad.rect.position + quad.rect.size;
+            appendTriangle(m_vertices, topLeft, sf::Vector2f(bottomRight.x, topLeft.y), bottomRight, quad.color);
+            appendTriangle(m_vertices, topLeft, bottomRight, sf::Vector2f(topLeft.x, bottomRight.y), quad.color);
+            m_stats.quads++;
+            break;
+        }
+        case RenderCommandType::Shape:
+            appendShape(commands.getShape(cmd.index));
+            m_stats.shapes++;
+            break;
+        case RenderCommandType::Sprite:
+            m_batchTexture = texture;
+            appendSprite(commands.getSprite(cmd.index));
+            m_stats.sprites++;
+            break;
+        case RenderCommandType::Vertices: {
+            const VerticesCommand& list = commands.getVertices(cmd.index);
+            m_batchTexture = texture;
+            m_vertices.insert(m_vertices.end(), list.vertices, list.vertices + list.count);
+            break;
+        }
+        case RenderCommandType::Text: {
+            const sf::Text& text = commands.getText(cmd.index);
+            bindTexture(&text.getFont());
+            drawText(text);
+            m_stats.texts++;
+            m_stats.drawCalls++;
+            break;
+        }
+        }
+    }
+    flush();
+}
+
+void RenderBackend::flush() {
+    if (!m_vertices.empty()) {
+        bindTexture(m_batchTexture);
+        drawBatch(m_vertices, m_batchTexture);
+        m_stats.drawCalls++;
+        m_stats.vertices += static_cast<std::uint32_t>(m_vertices.size());
+        m_vertices.clear();
+    }
+    m_batchTexture = nullptr;
+}
+
+void RenderBackend::bindTexture(const void* texture) {
+    if (m_hasBound && texture == m_boundTexture) return;
+    if (m_hasBound) m_stats.textureSwitches++;
+    m_boundTexture = texture;
+    m_hasBound = true;
+}
+
+void RenderBackend::appendShape(const ShapeCommand& shape) {
+    // Outline points in local space, same construction as sf::Shape
+    m_points.clear();
+    if (shape.pointCount == 0) {
+        m_points.push_back(sf::Vector2f(0.0f, 0.0f));
+        m_points.push_back(sf::Vector2f(shape.size.x, 0.0f));
+        m_points.push_back(sf::Vector2f(shape.size.x, shape.size.y));
+        m_points.push_back(sf::Vector2f(0.0f, shape.size.y));
+    } else {
+        const float radius = shape.size.x;
+        for (std::uint32_t i = 0; i < shape.pointCount; ++i) {
+            const float angle = static_cast<float>(i) / shape.pointCount * 2.0f * PI - PI / 2.0f;
+            m_points.push_back(sf::Vector2f(radius + std::cos(angle) * radius, radius + std::sin(angle) * radius));
+        }
+    }
+
+    const std::size_t count = m_points.size();
+    sf::Vector2f center(0.0f, 0.0f);
+    for (const sf::Vector2f& p : m_points) center += p;
+    center /= static_cast<float>(count);
+
+    if (shape.fillColor.a > 0) {
+        const sf::Vector2f worldCenter = shape.transform.transformPoint(center);
+        for (std::size_t i = 0; i < count; ++i) {
+            appendTriangle(m_vertices, worldCenter,
+                           shape.transform.transformPoint(m_points[i]),
+                           shape.transform.transformPoint(m_points[(i + 1) % count]),
+                           shape.fillColor);
+        }
+    }
+
+    if (shape.outlineThickness == 0.0f || shape.outlineColor.a == 0) return;
+
+    // Push every point out along the averaged normals of its two edges
+    auto outer = [&](std::size_t i) {
+        const sf::Vector2f p0 = m_points[(i + count - 1) % count];
+        const sf::Vector2f p1 = m_points[i];
+        const sf::Vector2f p2 = m_points[(i + 1) % count];
+        sf::Vector2f n1 = computeNormal(p0, p1);
+        sf::Vector2f n2 = computeNormal(p1, p2);
+        if (dot(n1, center - p1) > 0.0f) n1 = -n1;
+        if (dot(n2, center - p1) > 0.0f) n2 = -n2;
+        const float factor = 1.0f + dot(n1, n2);
+        return p1 + (n1 + n2) / factor * shape.outlineThickness;
+    };
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t next = (i + 1) % count;
+        const sf::Vector2f inner0 = shape.transform.transformPoint(m_points[i]);
+        const sf::Vector2f inner1 = shape.transform.transformPoint(m_points[next]);
+        const sf::Vector2f outer0 = shape.transform.transformPoint(outer(i));
+        const sf::Vector2f outer1 = shape.transform.transformPoint(outer(next));
+        appendTriangle(m_vertices, inner0, outer0, inner1, shape.outlineColor);
+        appendTriangle(m_vertices, inner1, outer0, outer1, shape.outlineColor);
+    }
+}
+
+void RenderBackend::appendSprite(const SpriteCommand& sprite) {
+    const sf::FloatRect rect(sf::Vector2f(sprite.textureRect.position), sf::Vector2f(sprite.textureRect.size));
+    const sf::Vector2f size(std::abs(rect.size.x), std::abs(rect.size.y));
+
+    const sf::Vertex corners[4] = {
+        { sprite.transform.transformPoint(sf::Vector2f(0.0f, 0.0f)), sprite.color, rect.position },
+        { sprite.transform.transformPoint(sf::Vector2f(size.x, 0.0f)), sprite.color, sf::Vector2f(rect.position.x + rect.size.x, rect.position.y) },
+        { sprite.transform.transformPoint(size), sprite.color, rect.position + rect.size },
+        { sprite.transform.transformPoint(sf::Vector2f(0.0f, size.y)), sprite.color, sf::Vector2f(rect.position.x, rect.position.y + rect.size.y) },
+    };
+    m_vertices.push_back(corners[0]);
+    m_vertices.push_back(corners[1]);
+    m_vertices.push_back(corners[2]);
+    m_vertices.push_back(corners[0]);
+    m_vertices.push_back(corners[2]);
+    m_vertices.push_back(corners[3]);
+}
+
+SfmlRenderBackend::SfmlRenderBackend(sf::RenderTarget& target)
+    : m_target(target)
+{
+}
+
+void SfmlRenderBackend::drawBatch(const std::vector<sf::Vertex>& vertices, const sf::Texture* texture) {
+    m_target.draw(vertices.data(), vertices.size(), sf::PrimitiveType::Triangles, sf::RenderStates(texture));
+}
+
+void SfmlRenderBackend::drawText(const sf::Text& text) {
+    m_target.draw(text);
+}
+
+bool OffscreenRenderBackend::create(sf::Vector2u size) {
+    return m_texture.resize(size);
+}
+
+void OffscreenRenderBackend::clear(sf::Color color) {
+    m_texture.clear(color);
+}
+
+void OffscreenRenderBackend::display() {
+    m_texture.display();
+}
+
+void OffscreenRenderBackend::drawBatch(const std::vector<sf::Vertex>& vertices, const sf::Texture* texture) {
+    m_texture.draw(vertices.data(), vertices.size(), sf::PrimitiveType::Triangles, sf::RenderStates(texture));
+}
+
+void OffscreenRenderBackend::drawText(const sf::Text& text) {
+    m_texture.draw(text);
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+class RenderCommandBuffer;
+struct ShapeCommand;
+struct SpriteCommand;
+
+// What one execute() cost, filled by every backend (the null one included)
+struct RenderStats {
+    std::uint32_t commands = 0;
+    std::uint32_t quads = 0;
+    std::uint32_t shapes = 0;
+    std::uint32_t sprites = 0;
+    std::uint32_t texts = 0;
+    std::uint32_t drawCalls = 0;
+    std::uint32_t vertices = 0;
+    std::uint32_t textureSwitches = 0;
+};
+
+// Plays a sorted RenderCommandBuffer back. Consecutive untextured commands
+// (and consecutive sprites sharing a texture) are merged into one triangle
+// batch, so the road's scanlines cost a single draw call.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    void execute(const RenderCommandBuffer& commands);
+    const RenderStats& getStats() const { return m_stats; }
+
+protected:
+    // One merged batch of triangles; texture is null for untextured geometry
+    virtual void drawBatch(const std::vector<sf::Vertex>& vertices, const sf::Texture* texture) = 0;
+    virtual void drawText(const sf::Text& text) = 0;
+
+private:
+    void flush();
+    void bindTexture(const void* texture);
+    void appendShape(const ShapeCommand& shape);
+    void appendSprite(const SpriteCommand& sprite);
+
+    std::vector<sf::Vertex> m_vertices;
+    std::vector<sf::Vector2f> m_points;
+    const sf::Texture* m_batchTexture = nullptr;
+    const void* m_boundTexture = nullptr;
+    bool m_hasBound = false;
+    RenderStats m_stats;
+};
+
+// Draws into any SFML target (the game window)
+class SfmlRenderBackend : public RenderBackend {
+public:
+    explicit SfmlRenderBackend(sf::RenderTarget& target);
+
+protected:
+    void drawBatch(const std::vector<sf::Vertex>& vertices, const sf::Texture* texture) override;
+    void drawText(const sf::Text& text) override;
+
+private:
+    sf::RenderTarget& m_target;
+};
+
+// Draws into its own texture, e.g. for screenshots or GPU timing without a window
+class OffscreenRenderBackend : public RenderBackend {
+public:
+    // Returns false when the render texture could not be created
+    bool create(sf::Vector2u size);
+    void clear(sf::Color color = sf::Color::Black);
+    // Resolves the frame; call after execute() before reading the texture
+    void display();
+    const sf::Texture& getTexture() const { return m_texture.getTexture(); }
+
+protected:
+    void drawBatch(const std::vector<sf::Vertex>& vertices, const sf::Texture* texture) override;
+    void drawText(const sf::Text& text) override;
+
+private:
+    sf::RenderTexture m_texture;
+};
+
+// Builds every batch but never touches the GPU: measures the CPU side of
+// rendering in headless builds
+class NullRenderBackend : public RenderBackend {
+protected:
+    void drawBatch(const std::vector<sf::Vertex>&, const sf::Texture*) override {}
+    void drawText(const sf::Text&) override {}
+};
@@ -0,0 +1,177 @@
+#include "RenderCommandBuffer.h"
+#include <algorithm>
+
+namespace {
+    constexpr int LAYER_SHIFT = 56;
+    constexpr int DEPTH_SHIFT = 40;
+    constexpr int TEXTURE_SHIFT = 28;
+    constexpr std::uint32_t DEPTH_MAX = 0xFFFF;
+    constexpr std::uint32_t TEXTURE_SLOT_MAX = 0xFFF;
+    constexpr std::uint32_t SEQUENCE_MAX = 0x0FFFFFFF;
+
+    // Worst case per road scanline: grass, road, two rumbles, a pothole and the
+    // start line's checkers; plus room for the HUD and sprites
+    constexpr std::size_t COMMANDS_PER_SCANLINE = 20;
+    constexpr std::size_t EXTRA_COMMANDS = 1024;
+    constexpr std::size_t RESERVED_SHAPES = 256;
+    constexpr std::size_t RESERVED_SPRITES = 64;
+    constexpr std::size_t RESERVED_TEXTURE_SLOTS = 16;
+    constexpr std::size_t RESERVED_VERTEX_LISTS = 4;
+}
+
+RenderCommandBuffer::RenderCommandBuffer()
+    : m_textCount(0)
+    , m_targetSize(0, 0)
+    , m_reservedSize(0, 0)
+    , m_layer(RenderLayer::Background)
+    , m_batchByTexture(false)
+    , m_depthKey(0)
+    , m_sequence(0)
+{
+}
+
+void RenderCommandBuffer::begin(sf::Vector2u targetSize) {
+    m_commands.clear();
+    m_quads.clear();
+    m_shapes.clear();
+    m_sprites.clear();
+    m_vertexLists.clear();
+    m_textCount = 0;
+    m_textureSlots.clear();
+
+    // Sized once per resolution so a steady frame never grows the arrays
+    if (targetSize != m_reservedSize) reserveFor(targetSize);
+
+    m_targetSize = targetSize;
+    m_layer = RenderLayer::Background;
+    m_batchByTexture = false;
+    m_depthKey = 0;
+    m_sequence = 0;
+}
+
+void RenderCommandBuffer::reserveFor(sf::Vector2u targetSize) {
+    const std::size_t commands = targetSize.y / 2 * COMMANDS_PER_SCANLINE + EXTRA_COMMANDS;
+    m_commands.reserve(commands);
+    m_quads.reserve(commands);
+    m_shapes.reserve(RESERVED_SHAPES);
+    m_sprites.reserve(RESERVED_SPRITES);
+    m_vertexLists.reserve(RESERVED_VERTEX_LISTS);
+    m_textureSlots.reserve(RESERVED_TEXTURE_SLOTS);
+    m_reservedSize = targetSize;
+}
+
+void RenderCommandBuffer::setLayer(RenderLayer layer, bool batchByTexture) {
+    m_layer = layer;
+    m_batchByTexture = batchByTexture;
+    m_depthKey = 0;
+}
+
+void RenderCommandBuffer::setDepth(float depth) {
+    // Far first: the key grows as depth shrinks
+    const float clamped = std::clamp(depth, 0.0f, 1.0f);
+    m_depthKey = DEPTH_MAX - static_cast<std::uint32_t>(clamped * DEPTH_MAX);
+}
+
+std::uint32_t RenderCommandBuffer::textureSlot(const void* texture) {
+    if (!m_batchByTexture || !texture) return 0;
+
+    // A frame only ever sees a handful of textures
+    for (std::size_t i = 0; i < m_textureSlots.size(); ++i) {
+        if (m_textureSlots[i] == texture) return static_cast<std::uint32_t>(i) + 1;
+    }
+    m_textureSlots.push_back(texture);
+    return static_cast<std::uint32_t>(std::min<std::size_t>(m_textureSlots.size(), TEXTURE_SLOT_MAX));
+}
+
+void RenderCommandBuffer::push(RenderCommandType type, std::uint32_t index, const void* texture) {
+    std::uint64_t key = static_cast<std::uint64_t>(m_layer) << LAYER_SHIFT;
+    key |= static_cast<std::uint64_t>(m_depthKey) << DEPTH_SHIFT;
+    key |= static_cast<std::uint64_t>(textureSlot(texture)) << TEXTURE_SHIFT;
+    key |= std::min(m_sequence, SEQUENCE_MAX);
+    ++m_sequence;
+
+    m_commands.push_back({ key, type, index });
+}
+
+void RenderCommandBuffer::fillRect(sf::Vector2f position, sf::Vector2f size, sf::Color color) {
+    m_quads.push_back({ sf::FloatRect(position, size), color });
+    push(RenderCommandType::Quad, static_cast<std::uint32_t>(m_quads.size() - 1), nullptr);
+}
+
+void RenderCommandBuffer::pushShape(const ShapeCommand& shape) {
+    m_shapes.push_back(shape);
+    push(RenderCommandType::Shape, static_cast<std::uint32_t>(m_shapes.size() - 1), nullptr);
+}
+
+void RenderCommandBuffer::drawRect(sf::Vector2f position, sf::Vector2f size, sf::Color fillColor,
+                                   sf::Color outlineColor, float outlineThickness) {
+    ShapeCommand cmd;
+    cmd.transform.translate(position);
+    cmd.size = size;
+    cmd.pointCount = 0;
+    cmd.fillColor = fillColor;
+    cmd.outlineColor = outlineColor;
+    cmd.outlineThickness = outlineThickness;
+    pushShape(cmd);
+}
+
+void RenderCommandBuffer::drawCircle(sf::Vector2f center, float radius, sf::Color fillColor, std::uint32_t pointCount) {
+    ShapeCommand cmd;
+    cmd.transform.translate(center - sf::Vector2f(radius, radius));
+    cmd.size = sf::Vector2f(radius, radius);
+    cmd.pointCount = std::max<std::uint32_t>(pointCount, 3);
+    cmd.fillColor = fillColor;
+    cmd.outlineColor = sf::Color::Transparent;
+    cmd.outlineThickness = 0.0f;
+    pushShape(cmd);
+}
+
+void RenderCommandBuffer::draw(const sf::RectangleShape& shape) {
+    ShapeCommand cmd;
+    cmd.transform = shape.getTransform();
+    cmd.size = shape.getSize();
+    cmd.pointCount = 0;
+    cmd.fillColor = shape.getFillColor();
+    cmd.outlineColor = shape.getOutlineColor();
+    cmd.outlineThickness = shape.getOutlineThickness();
+    pushShape(cmd);
+}
+
+void RenderCommandBuffer::draw(const sf::CircleShape& shape) {
+    ShapeCommand cmd;
+    cmd.transform = shape.getTransform();
+    cmd.size = sf::Vector2f(shape.getRadius(), shape.getRadius());
+    cmd.pointCount = static_cast<std::uint32_t>(std::max<std::size_t>(shape.getPointCount(), 3));
+    cmd.fillColor = shape.getFillColor();
+    cmd.outlineColor = shape.getOutlineColor();
+    cmd.outlineThickness = shape.getOutlineThickness();
+    pushShape(cmd);
+}
+
+void RenderCommandBuffer::draw(const sf::Sprite& sprite) {
+    const sf::Texture& texture = sprite.getTexture();
+    m_sprites.push_back({ sprite.getTransform(), &texture, sprite.getTextureRect(), sprite.getColor() });
+    push(RenderCommandType::Sprite, static_cast<std::uint32_t>(m_sprites.size() - 1), &texture);
+}
+
+void RenderCommandBuffer::draw(const sf::Text& text) {
+    // Copy-assigning into last frame's slot reuses its string and vertex storage
+    if (m_textCount < m_texts.size()) {
+        m_texts[m_textCount] = text;
+    } else {
+        m_texts.push_back(text);
+    }
+    push(RenderCommandType::Text, static_cast<std::uint32_t>(m_textCount++), &text.getFont());
+}
+
+void RenderCommandBuffer::drawVertices(const sf::Vertex* vertices, std::size_t count, const sf::Texture* texture) {
+    if (count == 0) return;
+    m_vertexLists.push_back({ vertices, count, texture });
+    push(RenderCommandType::Vertices, static_cast<std::uint32_t>(m_vertexLists.size() - 1), texture);
+}
+
+void RenderCommandBuffer::sort() {
+    std::sort(m_commands.begin(), m_commands.end(), [](const RenderCommand& a, const RenderCommand& b) {
+        return a.sortKey < b.sortKey;
+    });
+}
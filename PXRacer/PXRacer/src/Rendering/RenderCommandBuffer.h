@@ -0,0 +1,123 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+// Draw order, back to front. Commands are sorted by layer first, so a system
+// can submit out of order (e.g. the HUD before the road) and still land right.
+enum class RenderLayer : std::uint8_t {
+    Background,
+    Road,
+    Pickups,
+    Traffic,
+    Player,
+    Hud,
+    Overlay
+};
+
+enum class RenderCommandType : std::uint8_t {
+    Quad,     // axis aligned, untextured rectangle (road scanlines)
+    Shape,    // rectangle or circle with transform and outline
+    Sprite,
+    Text,
+    Vertices  // prebuilt triangles (debug overlays)
+};
+
+struct RenderCommand {
+    std::uint64_t sortKey;
+    RenderCommandType type;
+    std::uint32_t index;      // into the payload array of its type
+};
+
+struct QuadCommand {
+    sf::FloatRect rect;
+    sf::Color color;
+};
+
+struct ShapeCommand {
+    sf::Transform transform;
+    sf::Vector2f size;                // rectangle size, or radius in x for circles
+    std::uint32_t pointCount;         // 0 = rectangle
+    sf::Color fillColor;
+    sf::Color outlineColor;
+    float outlineThickness;
+};
+
+struct SpriteCommand {
+    sf::Transform transform;
+    const sf::Texture* texture;
+    sf::IntRect textureRect;
+    sf::Color color;
+};
+
+struct VerticesCommand {
+    const sf::Vertex* vertices;     // owned by the caller, must live until playback
+    std::size_t count;
+    const sf::Texture* texture;
+};
+
+// One frame of draw calls recorded by the game systems instead of going
+// straight to the window. A RenderBackend plays it back against a window,
+// an off-screen texture or nothing at all (benchmarks, headless builds).
+//
+// Sort key, high to low bits:
+//   layer (8) | depth, far first (16) | texture slot (12) | submission order (28)
+// The texture slot is only filled on layers opened with batchByTexture, where
+// draw order between commands at the same depth does not matter.
+class RenderCommandBuffer {
+public:
+    RenderCommandBuffer();
+
+    // Starts a new frame for a target of the given size; keeps the allocations
+    void begin(sf::Vector2u targetSize);
+    sf::Vector2u getSize() const { return m_targetSize; }
+
+    void setLayer(RenderLayer layer, bool batchByTexture = false);
+    // 0 = nearest, 1 = farthest; farther commands of a layer are drawn first
+    void setDepth(float depth);
+
+    void fillRect(sf::Vector2f position, sf::Vector2f size, sf::Color color);
+    // Same as drawing an sf::RectangleShape / sf::CircleShape, without building one
+    // (their constructors allocate vertex storage)
+    void drawRect(sf::Vector2f position, sf::Vector2f size, sf::Color fillColor,
+                  sf::Color outlineColor = sf::Color::Transparent, float outlineThickness = 0.0f);
+    void drawCircle(sf::Vector2f center, float radius, sf::Color fillColor, std::uint32_t pointCount = 30);
+    void draw(const sf::RectangleShape& shape);
+    void draw(const sf::CircleShape& shape);
+    void draw(const sf::Sprite& sprite);
+    void draw(const sf::Text& text);
+    // Triangles in target coordinates; not copied, see VerticesCommand
+    void drawVertices(const sf::Vertex* vertices, std::size_t count, const sf::Texture* texture);
+
+    // Orders the commands by sort key (stable thanks to the submission order)
+    void sort();
+
+    const std::vector<RenderCommand>& getCommands() const { return m_commands; }
+    const QuadCommand& getQuad(std::uint32_t index) const { return m_quads[index]; }
+    const ShapeCommand& getShape(std::uint32_t index) const { return m_shapes[index]; }
+    const SpriteCommand& getSprite(std::uint32_t index) const { return m_sprites[index]; }
+    const sf::Text& getText(std::uint32_t index) const { return m_texts[index]; }
+    const VerticesCommand& getVertices(std::uint32_t index) const { return m_vertexLists[index]; }
+
+private:
+    void push(RenderCommandType type, std::uint32_t index, const void* texture);
+    void pushShape(const ShapeCommand& shape);
+    void reserveFor(sf::Vector2u targetSize);
+    std::uint32_t textureSlot(const void* texture);
+
+    std::vector<RenderCommand> m_commands;
+    std::vector<QuadCommand> m_quads;
+    std::vector<ShapeCommand> m_shapes;
+    std::vector<SpriteCommand> m_sprites;
+    std::vector<VerticesCommand> m_vertexLists;
+    std::vector<sf::Text> m_texts;          // reused between frames, see draw(sf::Text)
+    std::size_t m_textCount;
+    std::vector<const void*> m_textureSlots;
+
+    sf::Vector2u m_targetSize;
+    sf::Vector2u m_reservedSize;
+    RenderLayer m_layer;
+    bool m_batchByTexture;
+    std::uint32_t m_depthKey;
+    std::uint32_t m_sequence;
+};
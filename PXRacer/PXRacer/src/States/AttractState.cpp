@@ -0,0 +1,96 @@
+#include "AttractState.h"
+#include "Core/Game.h"
+#include "Core/Random.h"
+#include "Core/ResourceCache.h"
+#include "Core/SettingsManager.h"
+#include "States/StateManager.h"
+#include <iostream>
+
+AttractState::AttractState(Game* game)
+    : State(game)
+    , m_autopilot(0.0f, 0.6f)
+    , m_font(ResourceCache::getInstance().getFont("assets/fonts/PressStart2P-Regular.ttf"))
+    , m_elapsed(0.0f)
+    , m_blinkTimer(0.0f)
+    , m_showPrompt(true)
+    , m_leaving(false)
+{
+    m_gameplayManager = std::make_unique<GameplayManager>(GameMode::Endless, EndlessDifficultyLevel::Medium,
+                                                          RandomService::getInstance().nextAttractSeed());
+    m_hud = std::make_unique<GameHUD>();
+    m_gameplayManager->captureRenderState(m_renderStates[0]);
+    m_gameplayManager->captureRenderState(m_renderStates[1]);
+
+    auto& settings = SettingsManager::getInstance();
+    m_promptText = std::make_unique<sf::Text>(m_font);
+    m_promptText->setString("DEMO - PRESS ANY KEY");
+    m_promptText->setCharacterSize(24);
+    m_promptText->setFillColor(sf::Color(255, 200, 0));
+    auto bounds = m_promptText->getLocalBounds();
+    m_promptText->setOrigin(sf::Vector2f(
+        bounds.position.x + bounds.size.x * 0.5f,
+        bounds.position.y + bounds.size.y * 0.5f
+    ));
+    m_promptText->setPosition(sf::Vector2f(settings.getWindowWidth() * 0.5f, settings.getWindowHeight() * 0.85f));
+}
+
+void AttractState::leave() {
+    if (m_leaving) return;
+    m_leaving = true;
+    m_game->getStateManager()->popState();
+}
+
+void AttractState::handleInput(const sf::Event& event) {
+    if (event.is<sf::Event::KeyPressed>() || event.is<sf::Event::MouseButtonPressed>()) {
+        leave();
+    }
+}
+
+void AttractState::update(float deltaTime) {
+    m_elapsed += deltaTime;
+    if (m_elapsed >= AttractConfig::DEMO_DURATION ||
+        m_gameplayManager->isGameOver() || m_gameplayManager->isRaceFinished()) {
+        leave();
+        return;
+    }
+
+    m_gameplayManager->setInput(m_autopilot.computeInput(m_gameplayManager->getRoad(), m_gameplayManager->getPlayer()));
+    m_gameplayManager->update(deltaTime);
+    m_pendingTime += deltaTime;
+}
+
+void AttractState::captureRenderState() {
+    GameplayRenderState& back = m_renderStates[1 - m_frontRenderState];
+    m_gameplayManager->captureRenderState(back);
+    back.elapsed = m_pendingTime;
+    m_pendingTime = 0.0f;
+}
+
+void AttractState::publishRenderState() {
+    m_frontRenderState = 1 - m_frontRenderState;
+    const GameplayRenderState& front = m_renderStates[m_frontRenderState];
+    m_hud->update(front.hud, front.elapsed);
+
+    m_blinkTimer += front.elapsed;
+    if (m_blinkTimer >= AttractConfig::PROMPT_BLINK) {
+        m_showPrompt = !m_showPrompt;
+        m_blinkTimer = 0.0f;
+    }
+}
+
+void AttractState::render(sf::RenderWindow&) {
+    RenderCommandBuffer& commands = m_game->getRenderCommands();
+    const GameplayRenderState& state = m_renderStates[m_frontRenderState];
+    const bool raceOver = state.hud.gameOver || state.hud.raceFinished;
+    m_gameplayManager->render(commands, state, raceOver ? 1.0f : m_game->getInterpolationAlpha());
+    m_hud->render(commands, state.hud);
+
+    if (m_showPrompt) {
+        commands.setLayer(RenderLayer::Overlay);
+        commands.draw(*m_promptText);
+    }
+}
+
+void AttractState::onEnter() {
+    std::cout << "Entered Attract State" << std::endl;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "State.h"
+#include "Gameplay/GameplayManager.h"
+#include "Gameplay/Autopilot.h"
+#include "UI/GameHUD.h"
+#include <memory>
+
+namespace AttractConfig {
+    constexpr float IDLE_TIMEOUT = 20.0f;     // seconds on the title screen before the demo starts
+    constexpr float DEMO_DURATION = 45.0f;    // demo length before returning to the title
+    constexpr float PROMPT_BLINK = 0.5f;
+}
+
+// Attract mode: an endless run driven by the autopilot, pushed on top of the
+// title screen when nobody touches the keyboard. Any key returns to the title.
+class AttractState : public State {
+public:
+    explicit AttractState(Game* game);
+
+    void handleInput(const sf::Event& event) override;
+    void update(float deltaTime) override;
+    void render(sf::RenderWindow& window) override;
+    void onEnter() override;
+
+    bool supportsPipelinedUpdate() const override { return true; }
+    void captureRenderState() override;
+    void publishRenderState() override;
+    std::size_t getActiveTrafficCars() const override { return m_renderStates[m_frontRenderState].traffic.size(); }
+
+private:
+    void leave();
+
+    std::unique_ptr<GameplayManager> m_gameplayManager;
+    std::unique_ptr<GameHUD> m_hud;
+    Autopilot m_autopilot;
+
+    GameplayRenderState m_renderStates[2];
+    int m_frontRenderState = 0;
+    float m_pendingTime = 0.0f;
+
+    const sf::Font& m_font;    // owned by ResourceCache
+    std::unique_ptr<sf::Text> m_promptText;
+
+    float m_elapsed;
+    float m_blinkTimer;
+    bool m_showPrompt;
+    bool m_leaving;
+};
@@ -1,6 +1,7 @@
 #include "CreditsState.h"
 #include "../Core/SettingsManager.h"
 #include "Core/Game.h"
+#include "Core/ResourceCache.h"
 #include "Core/Constants.h"
 #include "States/StateManager.h"
 #include "Core/AudioManager.h"
@@ -8,10 +9,8 @@
 
 CreditsState::CreditsState(Game* game)
     : State(game)
+    , m_font(ResourceCache::getInstance().getFont("assets/fonts/PressStart2P-Regular.ttf"))
 {
-    if (!m_font.openFromFile("assets/fonts/PressStart2P-Regular.ttf")) {
-        std::cerr << "Failed to load font in CreditsState" << std::endl;
-    }
     initializeUI();
 }
 
@@ -17,7 +17,7 @@ public:
     void onEnter() override;
 
 private:
-    sf::Font m_font;
+    const sf::Font& m_font;    // owned by ResourceCache
     std::unique_ptr<sf::Text> m_titleText;
     std::vector<std::unique_ptr<sf::Text>> m_creditTexts;
     std::unique_ptr<sf::Text> m_asciiArt;
@@ -1,6 +1,7 @@
 ﻿#include "GameModeSelectState.h"
 #include "../Core/SettingsManager.h"
 #include "Core/Game.h"
+#include "Core/ResourceCache.h"
 #include "Core/Constants.h"
 #include "States/PlayState.h"
 #include "States/TrackSelectState.h"
@@ -11,14 +12,11 @@
 
 GameModeSelectState::GameModeSelectState(Game* game)
     : State(game)
+    , m_font(ResourceCache::getInstance().getFont("assets/fonts/PressStart2P-Regular.ttf"))
     , m_selectedIndex(0)
     , m_transitionTimer(0.0f)
     , m_bgAnimTimer(0.0f)
 {
-    if (!m_font.openFromFile("assets/fonts/PressStart2P-Regular.ttf")) {
-        std::cerr << "[GameModeSelect] Failed to load font!" << std::endl;
-    }
-
     initializeCards();
 }
 
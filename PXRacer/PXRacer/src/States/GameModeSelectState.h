@@ -37,7 +37,7 @@ private:
     };
 
     std::vector<GameModeCard> m_cards;
-    sf::Font m_font;
+    const sf::Font& m_font;    // owned by ResourceCache
     std::unique_ptr<sf::Text> m_headerText;
     std::unique_ptr<sf::Text> m_hintText;
     
@@ -1,5 +1,6 @@
 ﻿#include "MainMenuState.h"
 #include "Core/Game.h"
+#include "Core/ResourceCache.h"
 #include "Core/Constants.h"
 #include "States/StateManager.h"
 #include "States/GameModeSelectState.h"
@@ -12,15 +13,16 @@
 
 MainMenuState::MainMenuState(Game* game)
     : State(game)
+    , m_font(ResourceCache::getInstance().getFont(MenuStyle::MENU_FONT_PATH))
     , m_selectedIndex(0)
     , m_blinkTimer(0.0f)
     , m_showSelector(true)
 {
     //Load background
 
-    m_backgroundTexture = std::make_unique<sf::Texture>();
+    m_backgroundTexture = ResourceCache::getInstance().getTexture(MenuStyle::MENU_BACKGROUND_PATH);
 
-    if (m_backgroundTexture->loadFromFile(MenuStyle::MENU_BACKGROUND_PATH)) {
+    if (m_backgroundTexture) {
 
         m_backgroundSprite = std::make_unique<sf::Sprite>(*m_backgroundTexture);
 
@@ -32,12 +34,6 @@ MainMenuState::MainMenuState(Game* game)
     }
     else {
     std::cerr<< "Failed to load background texture!" <<std::endl;
-    m_backgroundTexture.reset();
-    }
-
-    // Load font
-    if (!m_font.openFromFile(MenuStyle::MENU_FONT_PATH)) {
-        std::cerr << "Failed to load font in MainMenuState" << std::endl;
     }
 
     // Initialize title text with font
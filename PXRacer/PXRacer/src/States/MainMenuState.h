@@ -21,10 +21,10 @@ public:
 private:
 		std::unique_ptr<sf::Text> m_titleText;
 		std::vector<std::unique_ptr<sf::Text>> m_menuItems;
-		sf::Font m_font;
+		const sf::Font& m_font;    // owned by ResourceCache
 
 		std::unique_ptr<sf::Sprite> m_backgroundSprite;
-		std::unique_ptr<sf::Texture> m_backgroundTexture;
+		const sf::Texture* m_backgroundTexture = nullptr;    // owned by ResourceCache
 
 		std::vector<std::string> m_menuOptions;
 		
@@ -1,16 +1,20 @@
 ﻿#include "MenuState.h"
 #include "Core/Game.h"
+#include "Core/ResourceCache.h"
 #include "Core/Constants.h"
 #include "States/StateManager.h"
 #include "States/MainMenuState.h"
+#include "States/AttractState.h"
 #include "Core/SettingsManager.h"
 #include <iostream>
 
 // Constructor - Initializes the main menu
 MenuState::MenuState(Game *game)
 	: State(game)
+	, m_font(ResourceCache::getInstance().getFont("assets/fonts/PressStart2P-Regular.ttf"))
 	, m_blinkTimer(0.0f)
 	, m_showStartText(true)
+	, m_idleTimer(0.0f)
 {
 	auto& settings = SettingsManager::getInstance();
 
@@ -18,9 +22,9 @@ MenuState::MenuState(Game *game)
 	m_startText = std::make_unique<sf::Text>(m_font, sf::String());
 	m_versionText = std::make_unique<sf::Text>(m_font, sf::String());
 
-	m_backgroundTexture = std::make_unique<sf::Texture>();
+	m_backgroundTexture = ResourceCache::getInstance().getTexture("assets/textures/mainmenubg.png");
 
-	if (m_backgroundTexture->loadFromFile("assets/textures/mainmenubg.png")) {
+	if (m_backgroundTexture) {
 		m_backgroundSprite = std::make_unique<sf::Sprite>(*m_backgroundTexture);
 
 		auto textureSize = m_backgroundTexture->getSize();
@@ -31,11 +35,6 @@ MenuState::MenuState(Game *game)
 	}
 	else {
 		std::cerr << "Failed to load background texture!" << std::endl;
-		m_backgroundTexture.reset();
-	}
-
-	if (!m_font.openFromFile("assets/fonts/PressStart2P-Regular.ttf")) {
-		std::cerr << "Failed to load font, using default" << std::endl;
 	}
 
 	m_titleText->setString(sf::String("PIXELRACER"));
@@ -74,6 +73,7 @@ void MenuState::handleInput(const sf::Event &event)
 	if (event.is<sf::Event::KeyPressed>())
 	{
 		const auto *key = event.getIf<sf::Event::KeyPressed>();
+		m_idleTimer = 0.0f;
 
 		if (key->code == sf::Keyboard::Key::Enter)
 		{
@@ -102,6 +102,13 @@ void MenuState::update(float deltaTime)
 			m_showStartText = !m_showStartText;
 			m_blinkTimer = 0.0f;
 		}
+
+		m_idleTimer += deltaTime;
+		if (m_idleTimer >= AttractConfig::IDLE_TIMEOUT)
+		{
+			m_idleTimer = 0.0f;
+			m_game->getStateManager()->pushState(std::make_unique<AttractState>(m_game));
+		}
 	}
 }
 
@@ -126,4 +133,5 @@ void MenuState::render(sf::RenderWindow &window)
 void MenuState::onEnter()
 {
 	std::cout << "Entered Menu State" << std::endl;
+	m_idleTimer = 0.0f;
 }
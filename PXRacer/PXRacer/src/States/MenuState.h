@@ -20,10 +20,10 @@ public:
 private:
 
 	std::unique_ptr<sf::Sprite> m_backgroundSprite;
-	std::unique_ptr<sf::Texture> m_backgroundTexture;
+	const sf::Texture* m_backgroundTexture = nullptr;    // owned by ResourceCache
 
 	// Font and texts for menu
-	sf::Font m_font;
+	const sf::Font& m_font;    // owned by ResourceCache
 
 	// Title text (used only for position calculation, not drawn)
 	std::unique_ptr<sf::Text> m_titleText;
@@ -40,4 +40,7 @@ private:
 	// Blink timer variables
 	float m_blinkTimer;
 	bool m_showStartText;
+
+	// Time without input on the title screen, starts the attract demo
+	float m_idleTimer;
 };
\ No newline at end of file
@@ -3,15 +3,32 @@
 #include "../Core/SettingsManager.h"
 #include "MainMenuState.h"
 #include "Core/Game.h"
+#include "Core/ResourceCache.h"
 #include "Core/Constants.h"
 #include "States/StateManager.h"
 #include "Core/AudioManager.h"
 #include <iostream>
 
+namespace {
+    bool isHeld(sf::Keyboard::Scan a, sf::Keyboard::Scan b) {
+        return sf::Keyboard::isKeyPressed(a) || sf::Keyboard::isKeyPressed(b);
+    }
+
+    InputSnapshot readKeyboardInput() {
+        InputSnapshot input;
+        if (isHeld(sf::Keyboard::Scan::W, sf::Keyboard::Scan::Up)) input.throttle = 1.0f;
+        if (isHeld(sf::Keyboard::Scan::S, sf::Keyboard::Scan::Down)) input.brake = 1.0f;
+        if (isHeld(sf::Keyboard::Scan::A, sf::Keyboard::Scan::Left)) input.steer = -1.0f;
+        else if (isHeld(sf::Keyboard::Scan::D, sf::Keyboard::Scan::Right)) input.steer = 1.0f;
+        return input;
+    }
+}
+
 PlayState::PlayState(Game* game, GameMode mode, const TrackDefinition* track)
     : State(game)
     , m_isPaused(false)
     , m_showingTasks(false)
+    , m_pauseFont(ResourceCache::getInstance().getFont("assets/fonts/PressStart2P-Regular.ttf"))
     , m_pauseSelectedIndex(0)
     , m_currentMode(mode)
 {
@@ -25,16 +42,13 @@ PlayState::PlayState(Game* game, GameMode mode, const TrackDefinition* track)
     }
     
     m_hud = std::make_unique<GameHUD>();
+    resetRenderState();
     
     initPauseMenu();
     std::cout << "[PlayState] Initialized" << std::endl;
 }
 
 void PlayState::initPauseMenu() {
-    if (!m_pauseFont.openFromFile("assets/fonts/PressStart2P-Regular.ttf")) {
-        std::cerr << "[PlayState] Failed to load pause font!" << std::endl;
-    }
-    
     auto& settings = SettingsManager::getInstance();
     float windowWidth = static_cast<float>(settings.getWindowWidth());
     float windowHeight = static_cast<float>(settings.getWindowHeight());
@@ -292,35 +306,48 @@ void PlayState::handlePauseMenuAction() {
     }
 }
 
-void PlayState::renderTaskOverlay(sf::RenderWindow& window) {
-    window.draw(*m_taskOverlayBg);
-    window.draw(*m_taskOverlayTitle);
-    window.draw(*m_currentTaskText);
-    window.draw(*m_taskProgressText);
-    window.draw(*m_taskCheckmark);
-    window.draw(*m_taskCheckmarkText);
-    window.draw(*m_taskHintText);
+void PlayState::renderTaskOverlay(RenderCommandBuffer& commands) {
+    commands.draw(*m_taskOverlayBg);
+    commands.draw(*m_taskOverlayTitle);
+    commands.draw(*m_currentTaskText);
+    commands.draw(*m_taskProgressText);
+    commands.draw(*m_taskCheckmark);
+    commands.draw(*m_taskCheckmarkText);
+    commands.draw(*m_taskHintText);
 }
 
-void PlayState::render(sf::RenderWindow& window) {
-    m_gameplayManager->render(window);
-    m_hud->render(window, *m_gameplayManager);
+bool PlayState::isSteadyFrame() const {
+    const HudState& hud = m_renderStates[m_frontRenderState].hud;
+    return hud.countdownPhase == CountdownPhase::Finished
+        && !m_isPaused && !hud.raceFinished && !hud.gameOver
+        && !m_hud->isShowingBoostFeedback();
+}
+
+void PlayState::render(sf::RenderWindow&) {
+    RenderCommandBuffer& commands = m_game->getRenderCommands();
+    const GameplayRenderState& state = m_renderStates[m_frontRenderState];
+    const bool raceOver = state.hud.raceFinished || state.hud.gameOver;
+
+    // Interpolate only while the simulation is advancing, a frozen frame must not wobble
+    const bool simulating = !m_isPaused && !raceOver;
+    m_gameplayManager->render(commands, state, simulating ? m_game->getInterpolationAlpha() : 1.0f);
+    m_hud->render(commands, state.hud);
     
     // Don't show pause menu if race is finished or game over (Hud handles those screens)
-    if (m_isPaused && !m_gameplayManager->isRaceFinished() && !m_gameplayManager->isGameOver()) {
+    if (m_isPaused && !raceOver) {
+        commands.setLayer(RenderLayer::Overlay);
+
         // Dim overlay
-        sf::RectangleShape overlay(sf::Vector2f(
-            static_cast<float>(window.getSize().x),
-            static_cast<float>(window.getSize().y)));
-        overlay.setFillColor(sf::Color(0, 0, 0, 150));
-        window.draw(overlay);
+        commands.fillRect(sf::Vector2f(0.0f, 0.0f), sf::Vector2f(
+            static_cast<float>(commands.getSize().x),
+            static_cast<float>(commands.getSize().y)), sf::Color(0, 0, 0, 150));
         
         if (m_showingTasks) {
-            renderTaskOverlay(window);
+            renderTaskOverlay(commands);
         } else {
-            window.draw(*m_pauseTitle);
+            commands.draw(*m_pauseTitle);
             for (const auto& item : m_pauseMenuItems) {
-                window.draw(*item);
+                commands.draw(*item);
             }
         }
     }
@@ -357,6 +384,7 @@ void PlayState::restartGame() {
     
     // Reset Hud
     m_hud = std::make_unique<GameHUD>();
+    resetRenderState();
     
     // Unpause
     m_isPaused = false;
@@ -369,9 +397,36 @@ void PlayState::restartGame() {
 void PlayState::update(float deltaTime) {
     // Don't update gameplay if paused, race finished, or game over
     if (!m_isPaused && !m_gameplayManager->isRaceFinished() && !m_gameplayManager->isGameOver()) {
+        m_gameplayManager->setInput(m_pendingInput);
         m_gameplayManager->update(deltaTime);
     }
     
-    // Always update Hud (for animations)
-    m_hud->update(*m_gameplayManager, deltaTime);
+    // Hud animations keep running (applied when the snapshot is published)
+    m_pendingHudTime += deltaTime;
+}
+
+void PlayState::beginTicks() {
+    // Devices are polled on the main thread, update() may run on the simulation thread
+    m_pendingInput = readKeyboardInput();
+}
+
+void PlayState::captureRenderState() {
+    GameplayRenderState& back = m_renderStates[1 - m_frontRenderState];
+    m_gameplayManager->captureRenderState(back);
+    back.elapsed = m_pendingHudTime;
+    m_pendingHudTime = 0.0f;
+}
+
+void PlayState::publishRenderState() {
+    m_frontRenderState = 1 - m_frontRenderState;
+    const GameplayRenderState& front = m_renderStates[m_frontRenderState];
+    m_hud->update(front.hud, front.elapsed);
+}
+
+void PlayState::resetRenderState() {
+    m_gameplayManager->captureRenderState(m_renderStates[0]);
+    m_gameplayManager->captureRenderState(m_renderStates[1]);
+    m_renderStates[0].elapsed = m_renderStates[1].elapsed = 0.0f;
+    m_pendingHudTime = 0.0f;
+    m_hud->update(m_renderStates[m_frontRenderState].hud, 0.0f);
 }
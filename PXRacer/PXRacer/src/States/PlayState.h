@@ -17,23 +17,38 @@ public:
     void onEnter() override;
     void onExit() override;
 
+    bool supportsPipelinedUpdate() const override { return true; }
+    void beginTicks() override;
+    void captureRenderState() override;
+    void publishRenderState() override;
+    bool isSteadyFrame() const override;
+    std::size_t getActiveTrafficCars() const override { return m_renderStates[m_frontRenderState].traffic.size(); }
+
 private:
     void initPauseMenu();
     void initTaskOverlay();
     void updatePauseMenuDisplay();
     void handlePauseMenuAction();
     void restartGame();
-    void renderTaskOverlay(sf::RenderWindow& window);
+    void renderTaskOverlay(RenderCommandBuffer& commands);
+    void resetRenderState();
     
     std::unique_ptr<GameplayManager> m_gameplayManager;
     std::unique_ptr<GameHUD> m_hud;
+
+    // Double-buffered snapshot: render() draws the front one while the
+    // simulation fills the back one (on the simulation thread when pipelined)
+    GameplayRenderState m_renderStates[2];
+    int m_frontRenderState = 0;
+    float m_pendingHudTime = 0.0f;
+    InputSnapshot m_pendingInput;
     
     // Pause state
     bool m_isPaused;
     bool m_showingTasks;
     
     // Pause menu
-    sf::Font m_pauseFont;
+    const sf::Font& m_pauseFont;    // owned by ResourceCache
     std::unique_ptr<sf::Text> m_pauseTitle;
     std::vector<std::unique_ptr<sf::Text>> m_pauseMenuItems;
     int m_pauseSelectedIndex;
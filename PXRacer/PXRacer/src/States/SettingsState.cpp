@@ -8,16 +8,17 @@
 #include "../UI/AudioSettingsState.h"
 #include "Core/SettingsManager.h"
 #include "Core/AudioManager.h"
+#include "Core/ResourceCache.h"
 
 
 SettingsState::SettingsState(Game *game)
-    : State(game), m_selectedIndex(0), m_blinkTimer(0.0f), m_showSelector(true)
+    : State(game), m_font(ResourceCache::getInstance().getFont(MenuStyle::MENU_FONT_PATH)), m_selectedIndex(0), m_blinkTimer(0.0f), m_showSelector(true)
 {
     // Load background
-    m_backgroundTexture = std::make_unique<sf::Texture>();
+    m_backgroundTexture = ResourceCache::getInstance().getTexture(MenuStyle::MENU_BACKGROUND_PATH);
     
     // Load background texture
-    if (m_backgroundTexture->loadFromFile(MenuStyle::MENU_BACKGROUND_PATH)){
+    if (m_backgroundTexture){
         // Create background sprite
         m_backgroundSprite = std::make_unique<sf::Sprite>(*m_backgroundTexture);
 
@@ -30,13 +31,6 @@ SettingsState::SettingsState(Game *game)
     }
     else{
          std::cerr << "Failed to load background texture!" << std::endl;
-         m_backgroundTexture.reset();
-    }
-
-    // Load font
-    if (!m_font.openFromFile(MenuStyle::MENU_FONT_PATH))
-    {
-        std::cerr << "Failed to load font!" << std::endl;
     }
 
     // Define menu options
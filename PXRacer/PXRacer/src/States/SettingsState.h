@@ -23,10 +23,10 @@ private:
     
     // Backround
     std::unique_ptr<sf::Sprite> m_backgroundSprite;
-    std::unique_ptr<sf::Texture> m_backgroundTexture;
+    const sf::Texture* m_backgroundTexture = nullptr;    // owned by ResourceCache
 
     // Fonts for text
-    sf::Font m_font;
+    const sf::Font& m_font;    // owned by ResourceCache
 
     // UI Elements
     std::unique_ptr<sf::Text> m_titleText;
@@ -20,6 +20,23 @@ public:
 		virtual void onPause(){}
 		virtual void onResume(){}
 
+		//Frame pipelining (see Game::run)
+		//A state returning true renders only from the snapshot it publishes, so its
+		//update() may run on the simulation thread while the main thread draws.
+		virtual bool supportsPipelinedUpdate() const { return false; }
+		//Main thread, simulation idle: before this frame's ticks (sample devices here)
+		virtual void beginTicks(){}
+		//After this frame's ticks, on the thread that ran them: fill the back snapshot
+		virtual void captureRenderState(){}
+		//Main thread, simulation idle: the captured snapshot becomes the one render() draws
+		virtual void publishRenderState(){}
+
+		//True while the state draws a frame that should not allocate (e.g. racing
+		//with no menus or transient text up); Game checks it in debug builds
+		virtual bool isSteadyFrame() const { return false; }
+		//Traffic cars in the frame being drawn (performance overlay)
+		virtual std::size_t getActiveTrafficCars() const { return 0; }
+
 	protected:
 		Game* m_game;
 	};
@@ -1,16 +1,17 @@
 #include "StateManager.h"
 #include "State.h"
 #include "Core/Game.h"
-#include <iostream>
+#include "Core/Profiler.h"
+#include "Core/Logger.h"
 
 StateManager::StateManager(Game* game)
     : m_game(game)
 {
-    std::cout << "StateManager initialized" << std::endl;
+    LOG_INFO(LogCategory::State, "StateManager initialized");
 }
 
 StateManager::~StateManager() {
-    std::cout << "StateManager shutting down..." << std::endl;
+    LOG_INFO(LogCategory::State, "StateManager shutting down...");
     executeClearStates();
 }
 
@@ -33,35 +34,35 @@ void StateManager::clearStates() {
 
 // Process all pending state changes - called once per frame after render
 void StateManager::processStateChanges() {
+    PROFILE_SCOPE("StateManager::processStateChanges");
     if (m_pendingOperations.empty()) {
         return; // Early exit if nothing to process
     }
 
-    std::cout << "[StateManager] Processing " << m_pendingOperations.size()
-              << " pending operation(s)" << std::endl;
+    LOG_DEBUG(LogCategory::State, "Processing %zu pending operation(s)", m_pendingOperations.size());
 
     for (auto& operation : m_pendingOperations) {
         switch (operation.operation) {
             case StateOperation::Pop:
-                std::cout << "[StateManager] Executing Pop operation" << std::endl;
+                LOG_DEBUG(LogCategory::State, "Executing Pop operation");
                 executePopState();
                 break;
             case StateOperation::Push:
-                std::cout << "[StateManager] Executing Push operation" << std::endl;
+                LOG_DEBUG(LogCategory::State, "Executing Push operation");
                 executePushState(std::move(operation.state));
                 break;
             case StateOperation::Change:
-                std::cout << "[StateManager] Executing Change operation" << std::endl;
+                LOG_DEBUG(LogCategory::State, "Executing Change operation");
                 executeChangeState(std::move(operation.state));
                 break;
             case StateOperation::Clear:
-                std::cout << "[StateManager] Executing Clear operation" << std::endl;
+                LOG_DEBUG(LogCategory::State, "Executing Clear operation");
                 executeClearStates();
                 break;
         }
     }
     m_pendingOperations.clear();
-    std::cout << "[StateManager] All operations processed" << std::endl;
+    LOG_DEBUG(LogCategory::State, "All operations processed");
 }
 
 // Private execution methods - these do the actual state management
@@ -103,17 +104,49 @@ void StateManager::handleInput(const sf::Event& event) {
 }
 
 void StateManager::update(float deltaTime) {
+    PROFILE_SCOPE("StateManager::update");
     if (!m_states.empty()) {
         m_states.top()->update(deltaTime);
     }
 }
 
 void StateManager::render(sf::RenderWindow& window) {
+    PROFILE_SCOPE("StateManager::render");
     if (!m_states.empty()) {
         m_states.top()->render(window);
     }
 }
 
+bool StateManager::supportsPipelinedUpdate() const {
+    return !m_states.empty() && m_states.top()->supportsPipelinedUpdate();
+}
+
+bool StateManager::isSteadyFrame() const {
+    return !m_states.empty() && m_states.top()->isSteadyFrame();
+}
+
+std::size_t StateManager::getActiveTrafficCars() const {
+    return m_states.empty() ? 0 : m_states.top()->getActiveTrafficCars();
+}
+
+void StateManager::beginTicks() {
+    if (!m_states.empty()) {
+        m_states.top()->beginTicks();
+    }
+}
+
+void StateManager::captureRenderState() {
+    if (!m_states.empty()) {
+        m_states.top()->captureRenderState();
+    }
+}
+
+void StateManager::publishRenderState() {
+    if (!m_states.empty()) {
+        m_states.top()->publishRenderState();
+    }
+}
+
 State* StateManager::getCurrentState() const {
     return m_states.empty() ? nullptr : m_states.top().get();
 }
@@ -24,6 +24,14 @@ public:
 	void handleInput(const sf::Event& event);
 	void update(float deltaTime);
 	void render(sf::RenderWindow& window);
+
+	//Frame pipelining, forwarded to the current state (see State)
+	bool supportsPipelinedUpdate() const;
+	void beginTicks();
+	void captureRenderState();
+	void publishRenderState();
+	bool isSteadyFrame() const;
+	std::size_t getActiveTrafficCars() const;
 	void processStateChanges(); // Process pending state changes
 
 	//Queries
@@ -3,6 +3,7 @@
 #include "PlayState.h"
 #include "TrackSelectState.h"
 #include "Core/Game.h"
+#include "Core/ResourceCache.h"
 #include "Core/AudioManager.h"
 #include "States/StateManager.h"
 #include "Core/Constants.h"
@@ -15,6 +16,7 @@ TaskSelectState::TaskSelectState(Game* game, CampaignTrackData trackData, const
     : State(game)
     , m_trackData(std::move(trackData))
     , m_selectedTaskIndex(0)
+    , m_font(ResourceCache::getInstance().getFont("assets/fonts/PressStart2P-Regular.ttf"))
     , m_backHovered(false)
     , m_startHovered(false)
     , m_animTimer(0.0f)
@@ -24,9 +26,6 @@ TaskSelectState::TaskSelectState(Game* game, CampaignTrackData trackData, const
         m_savedTrack = *track;
     }
     
-    if (!m_font.openFromFile("assets/fonts/PressStart2P-Regular.ttf")) {
-        std::cerr << "[TaskSelect] Failed to load font!" << std::endl;
-    }
     createUI();
     updateTaskDisplay();
 }
@@ -29,7 +29,7 @@ private:
     int m_selectedTaskIndex;
     
     // UI Elements
-    sf::Font m_font;
+    const sf::Font& m_font;    // owned by ResourceCache
     std::unique_ptr<sf::Text> m_headerText;
     std::unique_ptr<sf::Text> m_trackNameText;
     std::unique_ptr<sf::Text> m_difficultyText;
@@ -5,6 +5,7 @@
 #include "GameModeSelectState.h"
 #include "Core/Constants.h"
 #include "Core/Game.h"
+#include "Core/ResourceCache.h"
 #include "Core/AudioManager.h"
 #include "States/StateManager.h"
 #include <iostream>
@@ -16,14 +17,11 @@ TrackSelectState::TrackSelectState(Game* game, GameMode gameMode)
     , m_gameMode(gameMode)
     , m_selectedIndex(0)
     , m_scrollOffset(0)
+    , m_font(ResourceCache::getInstance().getFont("assets/fonts/PressStart2P-Regular.ttf"))
     , m_backHovered(false)
     , m_startHovered(false)
     , m_animTimer(0.0f)
 {
-    if (!m_font.openFromFile("assets/fonts/PressStart2P-Regular.ttf")) {
-        std::cerr << "[TrackSelect] Failed to load font!" << std::endl;
-    }
-
     loadTracksForMode();
     createUI();
     createTrackCards();
@@ -393,7 +391,7 @@ void TrackSelectState::confirmSelection() {
         std::cout << "[TrackSelect] Selected track: " << selectedTrack.name << std::endl;
 
         if (m_gameMode == GameMode::Campaign) {
-            auto campaignTracks = CampaignDataManager::getTracks();
+            const auto& campaignTracks = CampaignDataManager::getTracks();
 
             CampaignTrackData campaignTrack;
             bool found = false;
@@ -39,7 +39,7 @@ private:
     int m_scrollOffset;
     
     // UI Elements
-    sf::Font m_font;
+    const sf::Font& m_font;    // owned by ResourceCache
     std::unique_ptr<sf::Text> m_headerText;
     std::unique_ptr<sf::Text> m_modeText;
     std::unique_ptr<sf::Text> m_hintText;
@@ -1,5 +1,6 @@
 #include "AudioSettingsState.h"
 #include "Core/Game.h"
+#include "Core/ResourceCache.h"
 #include "Core/Constants.h"
 #include "Core/SettingsManager.h"
 #include "Core/AudioManager.h"
@@ -9,7 +10,7 @@
 
 // Constructor - Initializes the audio settings menu
 AudioSettingsState::AudioSettingsState(Game *game)
-    : State(game), m_selectedIndex(0), m_blinkTimer(0.0f), m_showSelector(true), m_musicVolume(SettingsManager::getInstance().getMusicVolume()), m_sfxVolume(SettingsManager::getInstance().getSfxVolume()), m_masterVolume(SettingsManager::getInstance().getMasterVolume()), m_musicMuted(SettingsManager::getInstance().isMusicMuted()), m_sfxMuted(SettingsManager::getInstance().isSfxMuted())
+    : State(game), m_font(ResourceCache::getInstance().getFont(MenuStyle::MENU_FONT_PATH)), m_selectedIndex(0), m_blinkTimer(0.0f), m_showSelector(true), m_musicVolume(SettingsManager::getInstance().getMusicVolume()), m_sfxVolume(SettingsManager::getInstance().getSfxVolume()), m_masterVolume(SettingsManager::getInstance().getMasterVolume()), m_musicMuted(SettingsManager::getInstance().isMusicMuted()), m_sfxMuted(SettingsManager::getInstance().isSfxMuted())
 {
     auto &settings = SettingsManager::getInstance();
 
@@ -20,8 +21,8 @@ AudioSettingsState::AudioSettingsState(Game *game)
     m_sfxMuted = settings.isSfxMuted();
 
     // Load background
-    m_backgroundTexture = std::make_unique<sf::Texture>();
-    if (m_backgroundTexture->loadFromFile(MenuStyle::MENU_BACKGROUND_PATH))
+    m_backgroundTexture = ResourceCache::getInstance().getTexture(MenuStyle::MENU_BACKGROUND_PATH);
+    if (m_backgroundTexture)
     {
         m_backgroundSprite = std::make_unique<sf::Sprite>(*m_backgroundTexture);
 
@@ -35,12 +36,6 @@ AudioSettingsState::AudioSettingsState(Game *game)
         std::cerr << "Failed to load background texture!" << std::endl;
     }
 
-    // Load font
-    if (!m_font.openFromFile(MenuStyle::MENU_FONT_PATH))
-    {
-        std::cerr << "Failed to load font!" << std::endl;
-    }
-
     // Create title
     m_titleText = std::make_unique<sf::Text>(m_font, sf::String());
     m_titleText->setString("AUDIO SETTINGS");
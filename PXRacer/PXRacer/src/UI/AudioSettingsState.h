@@ -31,8 +31,8 @@ private:
 
     // UI elements (same pattern as ScreenSettingsState)
     std::unique_ptr<sf::Sprite> m_backgroundSprite;
-    std::unique_ptr<sf::Texture> m_backgroundTexture;
-    sf::Font m_font;
+    const sf::Texture* m_backgroundTexture = nullptr;    // owned by ResourceCache
+    const sf::Font& m_font;    // owned by ResourceCache
     std::unique_ptr<sf::Text> m_titleText;
     std::vector<std::unique_ptr<sf::Text>> m_menuTexts;
 
@@ -1,10 +1,14 @@
 ﻿#include "GameHUD.h"
 #include "../Core/SettingsManager.h"
 #include "Core/Constants.h"
+#include "Core/Profiler.h"
+#include "Core/ResourceCache.h"
+#include "Rendering/RenderCommandBuffer.h"
 #include <sstream>
 #include <iomanip>
 #include <iostream>
 #include <cmath>
+#include <cstdio>
 
 namespace HUDConfig {
     // Layout
@@ -29,11 +33,9 @@ namespace HUDConfig {
     const sf::Color BAR_BG = sf::Color(40, 40, 40);
 }
 
-GameHUD::GameHUD() {
-    if (!m_font.openFromFile("assets/fonts/PressStart2P-Regular.ttf")) {
-        std::cerr << "[HUD] Failed to load font!" << std::endl;
-    }
-    
+GameHUD::GameHUD()
+    : m_font(ResourceCache::getInstance().getFont("assets/fonts/PressStart2P-Regular.ttf"))
+{
     auto& settings = SettingsManager::getInstance();
     float winW = static_cast<float>(settings.getWindowWidth());
     float winH = static_cast<float>(settings.getWindowHeight());
@@ -180,16 +182,32 @@ GameHUD::GameHUD() {
 }
 
 std::string GameHUD::formatTime(float seconds) {
-    if (seconds <= 0.0f) return "--:--.---";
+    char buffer[32];
+    formatTime(seconds, buffer, sizeof(buffer));
+    return buffer;
+}
+
+void GameHUD::formatTime(float seconds, char* out, std::size_t size) {
+    if (seconds <= 0.0f) {
+        std::snprintf(out, size, "--:--.---");
+        return;
+    }
     
     int mins = static_cast<int>(seconds) / 60;
     int secs = static_cast<int>(seconds) % 60;
     int millis = static_cast<int>((seconds - static_cast<int>(seconds)) * 1000);
     
-    std::ostringstream oss;
-    oss << mins << ":" << std::setfill('0') << std::setw(2) << secs 
-        << "." << std::setw(3) << millis;
-    return oss.str();
+    std::snprintf(out, size, "%d:%02d.%03d", mins, secs, millis);
+}
+
+void GameHUD::setTextString(sf::Text& text, const char* value) {
+    // Rebuilt in place: one-character sf::Strings fit the small string buffer and
+    // m_textScratch keeps its capacity, so a changing counter never hits the heap
+    m_textScratch.clear();
+    for (const char* c = value; *c; ++c) {
+        m_textScratch += sf::String(static_cast<char32_t>(*c));
+    }
+    text.setString(m_textScratch);
 }
 
 void GameHUD::centerText(sf::Text& text, float x, float y) {
@@ -198,15 +216,16 @@ void GameHUD::centerText(sf::Text& text, float x, float y) {
     text.setPosition(sf::Vector2f(x, y));
 }
 
-void GameHUD::update(const GameplayManager& gameplay, float deltaTime) {
-    updateSpeedometer(gameplay.getPlayerSpeedKmh());
-    updateScore(gameplay.getStats().currentScore);
-    updateLapInfo(gameplay.getCurrentLapTime(), gameplay.getBestLapTime(), 
-                  gameplay.getLastLapTime(), gameplay.getLapCount());
-    updateDamage(gameplay.getPlayer().getTotalDamage());
+void GameHUD::update(const HudState& hud, float deltaTime) {
+    PROFILE_SCOPE("GameHUD::update");
+    updateSpeedometer(hud.speedKmh);
+    updateScore(hud.stats.currentScore);
+    updateLapInfo(hud.currentLapTime, hud.bestLapTime, 
+                  hud.lastLapTime, hud.lapCount);
+    updateDamage(hud.damage);
     
     // Boost feedback
-    const auto& boost = gameplay.getBoostResult();
+    const auto& boost = hud.boostResult;
     if (boost.attempted && !m_boostFeedbackShown) {
         m_boostFeedbackTimer = 2.0f;
         m_boostFeedbackShown = true;
@@ -223,9 +242,9 @@ void GameHUD::update(const GameplayManager& gameplay, float deltaTime) {
 }
 
 void GameHUD::updateSpeedometer(float speedKmh) {
-    std::ostringstream oss;
-    oss << static_cast<int>(speedKmh);
-    m_speedText->setString(oss.str());
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%d", static_cast<int>(speedKmh));
+    setTextString(*m_speedText, buffer);
     
     // Position KM/H after number
     auto speedBounds = m_speedText->getGlobalBounds();
@@ -257,19 +276,22 @@ void GameHUD::updateSpeedometer(float speedKmh) {
 }
 
 void GameHUD::updateScore(float score) {
-    std::ostringstream oss;
-    oss << static_cast<int>(score);
-    m_scoreText->setString(oss.str());
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%d", static_cast<int>(score));
+    setTextString(*m_scoreText, buffer);
 }
 
 void GameHUD::updateLapInfo(float currentLap, float bestLap, float lastLap, int lapCount) {
-    m_lapTimeText->setString(formatTime(currentLap));
-    m_bestLapText->setString(formatTime(bestLap));
-    m_lastLapText->setString(formatTime(lastLap));
+    char buffer[32];
+    formatTime(currentLap, buffer, sizeof(buffer));
+    setTextString(*m_lapTimeText, buffer);
+    formatTime(bestLap, buffer, sizeof(buffer));
+    setTextString(*m_bestLapText, buffer);
+    formatTime(lastLap, buffer, sizeof(buffer));
+    setTextString(*m_lastLapText, buffer);
     
-    std::ostringstream oss;
-    oss << "LAP " << (lapCount + 1);
-    m_lapCountText->setString(oss.str());
+    std::snprintf(buffer, sizeof(buffer), "LAP %d", lapCount + 1);
+    setTextString(*m_lapCountText, buffer);
     
     // Center text in panel
     float lapPanelX = m_lapPanel->getPosition().x;
@@ -299,44 +321,28 @@ void GameHUD::updateDamage(float damage) {
     }
 }
 
-void GameHUD::renderTrafficLight(sf::RenderWindow& window, float x, float y, bool isOn, bool isGreen) {
-    sf::RectangleShape housing(sf::Vector2f(50.0f, 60.0f));
-    housing.setOrigin(sf::Vector2f(25.0f, 30.0f));
-    housing.setPosition(sf::Vector2f(x, y));
-    housing.setFillColor(sf::Color(30, 30, 30));
-    housing.setOutlineColor(sf::Color(60, 60, 60));
-    housing.setOutlineThickness(3.0f);
-    window.draw(housing);
-    
-    sf::CircleShape bulb(18.0f);
-    bulb.setOrigin(sf::Vector2f(18.0f, 18.0f));
-    bulb.setPosition(sf::Vector2f(x, y));
+void GameHUD::renderTrafficLight(RenderCommandBuffer& commands, float x, float y, bool isOn, bool isGreen) {
+    const sf::Vector2f center(x, y);
+    commands.drawRect(center - sf::Vector2f(25.0f, 30.0f), sf::Vector2f(50.0f, 60.0f),
+                      sf::Color(30, 30, 30), sf::Color(60, 60, 60), 3.0f);
+    
+    sf::Color bulbColor(50, 50, 50);
     
     if (isOn) {
         if (isGreen) {
-            bulb.setFillColor(sf::Color(0, 255, 0));
-            sf::CircleShape glow(25.0f);
-            glow.setOrigin(sf::Vector2f(25.0f, 25.0f));
-            glow.setPosition(sf::Vector2f(x, y));
-            glow.setFillColor(sf::Color(0, 255, 0, 80));
-            window.draw(glow);
+            bulbColor = sf::Color(0, 255, 0);
+            commands.drawCircle(center, 25.0f, sf::Color(0, 255, 0, 80));
         } else {
-            bulb.setFillColor(sf::Color(255, 0, 0));
-            sf::CircleShape glow(25.0f);
-            glow.setOrigin(sf::Vector2f(25.0f, 25.0f));
-            glow.setPosition(sf::Vector2f(x, y));
-            glow.setFillColor(sf::Color(255, 0, 0, 80));
-            window.draw(glow);
+            bulbColor = sf::Color(255, 0, 0);
+            commands.drawCircle(center, 25.0f, sf::Color(255, 0, 0, 80));
         }
-    } else {
-        bulb.setFillColor(sf::Color(50, 50, 50));
     }
     
-    window.draw(bulb);
+    commands.drawCircle(center, 18.0f, bulbColor);
 }
 
-void GameHUD::renderCountdown(sf::RenderWindow& window, const GameplayManager& gameplay) {
-    CountdownPhase phase = gameplay.getCountdownPhase();
+void GameHUD::renderCountdown(RenderCommandBuffer& commands, const HudState& hud) {
+    CountdownPhase phase = hud.countdownPhase;
     
     if (phase == CountdownPhase::Finished) return;
     
@@ -345,13 +351,8 @@ void GameHUD::renderCountdown(sf::RenderWindow& window, const GameplayManager& g
     float centerY = static_cast<float>(settings.getWindowHeight()) * 0.25f;
 
     
-    sf::RectangleShape panel(sf::Vector2f(400.0f, 120.0f));
-    panel.setOrigin(sf::Vector2f(200.0f, 60.0f));
-    panel.setPosition(sf::Vector2f(centerX, centerY));
-    panel.setFillColor(sf::Color(20, 20, 20, 230));
-    panel.setOutlineColor(sf::Color(80, 80, 80));
-    panel.setOutlineThickness(3.0f);
-    window.draw(panel);
+    commands.drawRect(sf::Vector2f(centerX - 200.0f, centerY - 60.0f), sf::Vector2f(400.0f, 120.0f),
+                      sf::Color(20, 20, 20, 230), sf::Color(80, 80, 80), 3.0f);
     
     float lightSpacing = 70.0f;
     float startX = centerX - 2 * lightSpacing;
@@ -368,7 +369,7 @@ void GameHUD::renderCountdown(sf::RenderWindow& window, const GameplayManager& g
             isOn = (i <= lightIndex && lightIndex >= 0);
         }
         
-        renderTrafficLight(window, startX + i * lightSpacing, centerY, isOn, isGo);
+        renderTrafficLight(commands, startX + i * lightSpacing, centerY, isOn, isGo);
     }
     
     sf::Text statusText(m_font);
@@ -386,7 +387,7 @@ void GameHUD::renderCountdown(sf::RenderWindow& window, const GameplayManager& g
     }
     
     centerText(statusText, centerX, centerY + 70.0f);
-    window.draw(statusText);
+    commands.draw(statusText);
     
     if (phase != CountdownPhase::Go && phase != CountdownPhase::Finished) {
         sf::Text hintText(m_font);
@@ -394,14 +395,14 @@ void GameHUD::renderCountdown(sf::RenderWindow& window, const GameplayManager& g
         hintText.setCharacterSize(12);
         hintText.setFillColor(sf::Color(150, 150, 150));
         centerText(hintText, centerX, centerY + 100.0f);
-        window.draw(hintText);
+        commands.draw(hintText);
     }
 }
 
-void GameHUD::renderBoostFeedback(sf::RenderWindow& window, const GameplayManager& gameplay) {
+void GameHUD::renderBoostFeedback(RenderCommandBuffer& commands, const HudState& hud) {
     if (m_boostFeedbackTimer <= 0.0f) return;
     
-    const auto& boost = gameplay.getBoostResult();
+    const auto& boost = hud.boostResult;
     if (!boost.attempted) return;
     
     auto& settings = SettingsManager::getInstance();
@@ -435,26 +436,19 @@ void GameHUD::renderBoostFeedback(sf::RenderWindow& window, const GameplayManage
     float scale = 1.0f + 0.1f * std::sin(m_boostFeedbackTimer * 10.0f);
     feedbackText.setScale(sf::Vector2f(scale, scale));
     
-    window.draw(feedbackText);
+    commands.draw(feedbackText);
 }
 
-void GameHUD::renderGameOver(sf::RenderWindow& window, const GameplayManager& gameplay) {
-    float winW = static_cast<float>(window.getSize().x);
-    float winH = static_cast<float>(window.getSize().y);
+void GameHUD::renderGameOver(RenderCommandBuffer& commands, const HudState& hud) {
+    float winW = static_cast<float>(commands.getSize().x);
+    float winH = static_cast<float>(commands.getSize().y);
     
     // Overlay
-    sf::RectangleShape overlay(sf::Vector2f(winW, winH));
-    overlay.setFillColor(sf::Color(0, 0, 0, 200));
-    window.draw(overlay);
+    commands.fillRect(sf::Vector2f(0.0f, 0.0f), sf::Vector2f(winW, winH), sf::Color(0, 0, 0, 200));
     
     // Central panel
-    sf::RectangleShape panel(sf::Vector2f(400.0f, 250.0f));
-    panel.setOrigin(sf::Vector2f(200.0f, 125.0f));
-    panel.setPosition(sf::Vector2f(winW / 2.0f, winH / 2.0f));
-    panel.setFillColor(sf::Color(20, 20, 20, 240));
-    panel.setOutlineColor(sf::Color(255, 50, 50));
-    panel.setOutlineThickness(3.0f);
-    window.draw(panel);
+    commands.drawRect(sf::Vector2f(winW / 2.0f - 200.0f, winH / 2.0f - 125.0f), sf::Vector2f(400.0f, 250.0f),
+                      sf::Color(20, 20, 20, 240), sf::Color(255, 50, 50), 3.0f);
     
     // Game Over
     sf::Text gameOverText(m_font);
@@ -462,7 +456,7 @@ void GameHUD::renderGameOver(sf::RenderWindow& window, const GameplayManager& ga
     gameOverText.setCharacterSize(48);
     gameOverText.setFillColor(sf::Color::Red);
     centerText(gameOverText, winW / 2.0f, winH / 2.0f - 70.0f);
-    window.draw(gameOverText);
+    commands.draw(gameOverText);
     
     // Car Destroyed
     sf::Text subtitleText(m_font);
@@ -470,27 +464,27 @@ void GameHUD::renderGameOver(sf::RenderWindow& window, const GameplayManager& ga
     subtitleText.setCharacterSize(18);
     subtitleText.setFillColor(sf::Color(255, 150, 150));
     centerText(subtitleText, winW / 2.0f, winH / 2.0f - 20.0f);
-    window.draw(subtitleText);
+    commands.draw(subtitleText);
     
     // Final score
     sf::Text scoreText(m_font);
     std::ostringstream oss;
-    oss << "FINAL SCORE: " << static_cast<int>(gameplay.getStats().currentScore);
+    oss << "FINAL SCORE: " << static_cast<int>(hud.stats.currentScore);
     scoreText.setString(oss.str());
     scoreText.setCharacterSize(16);
     scoreText.setFillColor(HUDConfig::TEXT_GOLD);
     centerText(scoreText, winW / 2.0f, winH / 2.0f + 25.0f);
-    window.draw(scoreText);
+    commands.draw(scoreText);
     
     // Laps completed
     sf::Text lapsText(m_font);
     std::ostringstream lss;
-    lss << "LAPS: " << gameplay.getLapCount();
+    lss << "LAPS: " << hud.lapCount;
     lapsText.setString(lss.str());
     lapsText.setCharacterSize(14);
     lapsText.setFillColor(HUDConfig::TEXT_WHITE);
     centerText(lapsText, winW / 2.0f, winH / 2.0f + 55.0f);
-    window.draw(lapsText);
+    commands.draw(lapsText);
     
     // Instructions
     sf::Text hintText(m_font);
@@ -498,30 +492,23 @@ void GameHUD::renderGameOver(sf::RenderWindow& window, const GameplayManager& ga
     hintText.setCharacterSize(12);
     hintText.setFillColor(sf::Color(120, 120, 120));
     centerText(hintText, winW / 2.0f, winH / 2.0f + 95.0f);
-    window.draw(hintText);
+    commands.draw(hintText);
 }
 
-void GameHUD::renderRaceFinished(sf::RenderWindow& window, const GameplayManager& gameplay) {
-    float winW = static_cast<float>(window.getSize().x);
-    float winH = static_cast<float>(window.getSize().y);
+void GameHUD::renderRaceFinished(RenderCommandBuffer& commands, const HudState& hud) {
+    float winW = static_cast<float>(commands.getSize().x);
+    float winH = static_cast<float>(commands.getSize().y);
     
     // Overlay
-    sf::RectangleShape overlay(sf::Vector2f(winW, winH));
-    overlay.setFillColor(sf::Color(0, 0, 0, 200));
-    window.draw(overlay);
+    commands.fillRect(sf::Vector2f(0.0f, 0.0f), sf::Vector2f(winW, winH), sf::Color(0, 0, 0, 200));
     
     // Central panel - larger to fit all information
-    sf::RectangleShape panel(sf::Vector2f(500.0f, 400.0f));
-    panel.setOrigin(sf::Vector2f(250.0f, 200.0f));
-    panel.setPosition(sf::Vector2f(winW / 2.0f, winH / 2.0f));
-    panel.setFillColor(sf::Color(20, 30, 20, 245));
-    panel.setOutlineColor(sf::Color(100, 255, 100));
-    panel.setOutlineThickness(4.0f);
-    window.draw(panel);
-    
-    const auto& progress = gameplay.getCampaignProgress();
-    const auto& track = gameplay.getCampaignTrack();
-    bool taskCompleted = gameplay.isObjectiveCompleted();
+    commands.drawRect(sf::Vector2f(winW / 2.0f - 250.0f, winH / 2.0f - 200.0f), sf::Vector2f(500.0f, 400.0f),
+                      sf::Color(20, 30, 20, 245), sf::Color(100, 255, 100), 4.0f);
+    
+    const auto& progress = hud.campaignProgress;
+    const auto& track = hud.campaignTrack;
+    bool taskCompleted = hud.objectiveCompleted;
     
     // Race Finished
     sf::Text titleText(m_font);
@@ -529,7 +516,7 @@ void GameHUD::renderRaceFinished(sf::RenderWindow& window, const GameplayManager
     titleText.setCharacterSize(36);
     titleText.setFillColor(sf::Color(100, 255, 100));
     centerText(titleText, winW / 2.0f, winH / 2.0f - 160.0f);
-    window.draw(titleText);
+    commands.draw(titleText);
     
     // Track name
     sf::Text trackText(m_font);
@@ -537,14 +524,11 @@ void GameHUD::renderRaceFinished(sf::RenderWindow& window, const GameplayManager
     trackText.setCharacterSize(16);
     trackText.setFillColor(sf::Color(200, 200, 200));
     centerText(trackText, winW / 2.0f, winH / 2.0f - 115.0f);
-    window.draw(trackText);
+    commands.draw(trackText);
     
     // Separator line
-    sf::RectangleShape separator(sf::Vector2f(400.0f, 2.0f));
-    separator.setOrigin(sf::Vector2f(200.0f, 1.0f));
-    separator.setPosition(sf::Vector2f(winW / 2.0f, winH / 2.0f - 90.0f));
-    separator.setFillColor(sf::Color(80, 80, 80));
-    window.draw(separator);
+    commands.fillRect(sf::Vector2f(winW / 2.0f - 200.0f, winH / 2.0f - 91.0f), sf::Vector2f(400.0f, 2.0f),
+                      sf::Color(80, 80, 80));
     
     // Task result
     sf::Text taskLabel(m_font);
@@ -552,7 +536,7 @@ void GameHUD::renderRaceFinished(sf::RenderWindow& window, const GameplayManager
     taskLabel.setCharacterSize(12);
     taskLabel.setFillColor(sf::Color(150, 150, 150));
     taskLabel.setPosition(sf::Vector2f(winW / 2.0f - 200.0f, winH / 2.0f - 70.0f));
-    window.draw(taskLabel);
+    commands.draw(taskLabel);
     
     const CampaignTask* selectedTask = track.getSelectedTask();
     if (selectedTask) {
@@ -561,7 +545,7 @@ void GameHUD::renderRaceFinished(sf::RenderWindow& window, const GameplayManager
         taskDesc.setCharacterSize(11);
         taskDesc.setFillColor(sf::Color::White);
         taskDesc.setPosition(sf::Vector2f(winW / 2.0f - 200.0f, winH / 2.0f - 50.0f));
-        window.draw(taskDesc);
+        commands.draw(taskDesc);
     }
     
     // Task status (Completed / Failed)
@@ -575,7 +559,7 @@ void GameHUD::renderRaceFinished(sf::RenderWindow& window, const GameplayManager
     }
     taskStatus.setCharacterSize(14);
     taskStatus.setPosition(sf::Vector2f(winW / 2.0f + 100.0f, winH / 2.0f - 60.0f));
-    window.draw(taskStatus);
+    commands.draw(taskStatus);
     
     // Statistics section
     float statsY = winH / 2.0f - 15.0f;
@@ -588,14 +572,14 @@ void GameHUD::renderRaceFinished(sf::RenderWindow& window, const GameplayManager
     timeLabel.setCharacterSize(11);
     timeLabel.setFillColor(sf::Color(150, 150, 150));
     timeLabel.setPosition(sf::Vector2f(leftCol, statsY));
-    window.draw(timeLabel);
+    commands.draw(timeLabel);
     
     sf::Text timeValue(m_font);
     timeValue.setString(formatTime(progress.raceTime));
     timeValue.setCharacterSize(14);
     timeValue.setFillColor(sf::Color::White);
     timeValue.setPosition(sf::Vector2f(leftCol, statsY + 16.0f));
-    window.draw(timeValue);
+    commands.draw(timeValue);
     
     // Best lap
     sf::Text bestLabel(m_font);
@@ -603,14 +587,14 @@ void GameHUD::renderRaceFinished(sf::RenderWindow& window, const GameplayManager
     bestLabel.setCharacterSize(11);
     bestLabel.setFillColor(sf::Color(150, 150, 150));
     bestLabel.setPosition(sf::Vector2f(rightCol, statsY));
-    window.draw(bestLabel);
+    commands.draw(bestLabel);
     
     sf::Text bestValue(m_font);
     bestValue.setString(formatTime(progress.bestLapTime));
     bestValue.setCharacterSize(14);
     bestValue.setFillColor(HUDConfig::TEXT_GREEN);
     bestValue.setPosition(sf::Vector2f(rightCol, statsY + 16.0f));
-    window.draw(bestValue);
+    commands.draw(bestValue);
     
     // Laps and top speed
     statsY += 50.0f;
@@ -620,7 +604,7 @@ void GameHUD::renderRaceFinished(sf::RenderWindow& window, const GameplayManager
     lapsLabel.setCharacterSize(11);
     lapsLabel.setFillColor(sf::Color(150, 150, 150));
     lapsLabel.setPosition(sf::Vector2f(leftCol, statsY));
-    window.draw(lapsLabel);
+    commands.draw(lapsLabel);
     
     sf::Text lapsValue(m_font);
     std::ostringstream lapsSS;
@@ -629,14 +613,14 @@ void GameHUD::renderRaceFinished(sf::RenderWindow& window, const GameplayManager
     lapsValue.setCharacterSize(14);
     lapsValue.setFillColor(sf::Color::White);
     lapsValue.setPosition(sf::Vector2f(leftCol, statsY + 16.0f));
-    window.draw(lapsValue);
+    commands.draw(lapsValue);
     
     sf::Text speedLabel(m_font);
     speedLabel.setString("TOP SPEED:");
     speedLabel.setCharacterSize(11);
     speedLabel.setFillColor(sf::Color(150, 150, 150));
     speedLabel.setPosition(sf::Vector2f(rightCol, statsY));
-    window.draw(speedLabel);
+    commands.draw(speedLabel);
     
     sf::Text speedValue(m_font);
     std::ostringstream speedSS;
@@ -645,7 +629,7 @@ void GameHUD::renderRaceFinished(sf::RenderWindow& window, const GameplayManager
     speedValue.setCharacterSize(14);
     speedValue.setFillColor(sf::Color(255, 200, 100));
     speedValue.setPosition(sf::Vector2f(rightCol, statsY + 16.0f));
-    window.draw(speedValue);
+    commands.draw(speedValue);
     
     // Perfect laps info
     statsY += 50.0f;
@@ -658,26 +642,21 @@ void GameHUD::renderRaceFinished(sf::RenderWindow& window, const GameplayManager
         perfectLabel.setCharacterSize(12);
         perfectLabel.setFillColor(sf::Color(255, 215, 0));
         centerText(perfectLabel, winW / 2.0f, statsY);
-        window.draw(perfectLabel);
+        commands.draw(perfectLabel);
         statsY += 25.0f;
     }
     
     // Unlocked message (if task completed)
     if (taskCompleted) {
-        sf::RectangleShape unlockPanel(sf::Vector2f(380.0f, 40.0f));
-        unlockPanel.setOrigin(sf::Vector2f(190.0f, 20.0f));
-        unlockPanel.setPosition(sf::Vector2f(winW / 2.0f, statsY + 15.0f));
-        unlockPanel.setFillColor(sf::Color(40, 80, 40, 200));
-        unlockPanel.setOutlineColor(sf::Color(100, 200, 100));
-        unlockPanel.setOutlineThickness(2.0f);
-        window.draw(unlockPanel);
+        commands.drawRect(sf::Vector2f(winW / 2.0f - 190.0f, statsY - 5.0f), sf::Vector2f(380.0f, 40.0f),
+                          sf::Color(40, 80, 40, 200), sf::Color(100, 200, 100), 2.0f);
         
         sf::Text unlockText(m_font);
         unlockText.setString("PROGRESS SAVED!");
         unlockText.setCharacterSize(14);
         unlockText.setFillColor(sf::Color(150, 255, 150));
         centerText(unlockText, winW / 2.0f, statsY + 15.0f);
-        window.draw(unlockText);
+        commands.draw(unlockText);
     }
     
     // Instructions
@@ -686,46 +665,49 @@ void GameHUD::renderRaceFinished(sf::RenderWindow& window, const GameplayManager
     hintText.setCharacterSize(10);
     hintText.setFillColor(sf::Color(120, 120, 120));
     centerText(hintText, winW / 2.0f, winH / 2.0f + 175.0f);
-    window.draw(hintText);
+    commands.draw(hintText);
 }
 
-void GameHUD::render(sf::RenderWindow& window, const GameplayManager& gameplay) {
+void GameHUD::render(RenderCommandBuffer& commands, const HudState& hud) {
+    PROFILE_SCOPE("GameHUD::render");
+    commands.setLayer(RenderLayer::Hud);
+
     // Draw panels
-    window.draw(*m_leftPanel);
-    window.draw(*m_speedText);
-    window.draw(*m_speedUnitText);
-    window.draw(*m_speedBarBg);
-    window.draw(*m_speedBar);
-    window.draw(*m_damageLabel);
-    window.draw(*m_damageBarBg);
-    window.draw(*m_damageBar);
-    
-    window.draw(*m_rightPanel);
-    window.draw(*m_scoreLabel);
-    window.draw(*m_scoreText);
-    window.draw(*m_lapTimeLabel);
-    window.draw(*m_lapTimeText);
-    window.draw(*m_bestLapLabel);
-    window.draw(*m_bestLapText);
-    window.draw(*m_lastLapLabel);
-    window.draw(*m_lastLapText);
-    
-    window.draw(*m_lapPanel);
-    window.draw(*m_lapCountText);
+    commands.draw(*m_leftPanel);
+    commands.draw(*m_speedText);
+    commands.draw(*m_speedUnitText);
+    commands.draw(*m_speedBarBg);
+    commands.draw(*m_speedBar);
+    commands.draw(*m_damageLabel);
+    commands.draw(*m_damageBarBg);
+    commands.draw(*m_damageBar);
+    
+    commands.draw(*m_rightPanel);
+    commands.draw(*m_scoreLabel);
+    commands.draw(*m_scoreText);
+    commands.draw(*m_lapTimeLabel);
+    commands.draw(*m_lapTimeText);
+    commands.draw(*m_bestLapLabel);
+    commands.draw(*m_bestLapText);
+    commands.draw(*m_lastLapLabel);
+    commands.draw(*m_lastLapText);
+    
+    commands.draw(*m_lapPanel);
+    commands.draw(*m_lapCountText);
     
     // Countdown
-    renderCountdown(window, gameplay);
+    renderCountdown(commands, hud);
     
     // Boost feedback
-    renderBoostFeedback(window, gameplay);
+    renderBoostFeedback(commands, hud);
     
     // Game over (for Endless when the car is destroyed)
-    if (gameplay.isGameOver()) {
-        renderGameOver(window, gameplay);
+    if (hud.gameOver) {
+        renderGameOver(commands, hud);
     }
     
     // Race finished (for Campaign when all laps are completed)
-    if (gameplay.getGameMode() == GameMode::Campaign && gameplay.isRaceFinished()) {
-        renderRaceFinished(window, gameplay);
+    if (hud.mode == GameMode::Campaign && hud.raceFinished) {
+        renderRaceFinished(commands, hud);
     }
 }
@@ -4,12 +4,21 @@
 #include <array>
 #include "Gameplay/GameplayManager.h"
 
+class RenderCommandBuffer;
+
 class GameHUD {
 public:
     GameHUD();
     
-    void update(const GameplayManager& gameplay, float deltaTime);
-    void render(sf::RenderWindow& window, const GameplayManager& gameplay);
+    void update(const HudState& hud, float deltaTime);
+    void render(RenderCommandBuffer& commands, const HudState& hud);
+    
+    // Transient feedback (boost result) is on screen and builds its text per frame
+    bool isShowingBoostFeedback() const { return m_boostFeedbackTimer > 0.0f; }
+
+    // Lap time as m:ss.mmm, "--:--.---" when there is none yet
+    static std::string formatTime(float seconds);
+    static void formatTime(float seconds, char* out, std::size_t size);
 
 private:
     void updateSpeedometer(float speedKmh);
@@ -17,18 +26,19 @@ private:
     void updateLapInfo(float currentLap, float bestLap, float lastLap, int lapCount);
     void updateDamage(float damage);
     
-    void renderCountdown(sf::RenderWindow& window, const GameplayManager& gameplay);
-    void renderTrafficLight(sf::RenderWindow& window, float x, float y, bool isOn, bool isGreen);
-    void renderBoostFeedback(sf::RenderWindow& window, const GameplayManager& gameplay);
-    void renderGameOver(sf::RenderWindow& window, const GameplayManager& gameplay);
-    void renderRaceFinished(sf::RenderWindow& window, const GameplayManager& gameplay);
+    void renderCountdown(RenderCommandBuffer& commands, const HudState& hud);
+    void renderTrafficLight(RenderCommandBuffer& commands, float x, float y, bool isOn, bool isGreen);
+    void renderBoostFeedback(RenderCommandBuffer& commands, const HudState& hud);
+    void renderGameOver(RenderCommandBuffer& commands, const HudState& hud);
+    void renderRaceFinished(RenderCommandBuffer& commands, const HudState& hud);
     
     // Helper functions
-    std::string formatTime(float seconds);
+    void setTextString(sf::Text& text, const char* value);
     void centerText(sf::Text& text, float x, float y);
     void rightAlignText(sf::Text& text, float rightX, float y);
     
-    sf::Font m_font;
+    const sf::Font& m_font;    // owned by ResourceCache
+    sf::String m_textScratch;
     
     // Left panel - Speed and Damage
     std::unique_ptr<sf::RectangleShape> m_leftPanel;
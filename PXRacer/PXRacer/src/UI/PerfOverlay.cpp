@@ -0,0 +1,224 @@
+#include "PerfOverlay.h"
+#include "Rendering/RenderCommandBuffer.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+
+namespace PerfOverlayConfig {
+    // 5x7 bitmap font, one byte per row, bit 4 = leftmost pixel
+    constexpr char GLYPHS[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ.:/%-()=";
+    constexpr std::uint8_t GLYPH_ROWS[][7] = {
+        { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E }, // 0
+        { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E }, // 1
+        { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F }, // 2
+        { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E }, // 3
+        { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 }, // 4
+        { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E }, // 5
+        { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E }, // 6
+        { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 }, // 7
+        { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E }, // 8
+        { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C }, // 9
+        { 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 }, // A
+        { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E }, // B
+        { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E }, // C
+        { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C }, // D
+        { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F }, // E
+        { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 }, // F
+        { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F }, // G
+        { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 }, // H
+        { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E }, // I
+        { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C }, // J
+        { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 }, // K
+        { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F }, // L
+        { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 }, // M
+        { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 }, // N
+        { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // O
+        { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 }, // P
+        { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D }, // Q
+        { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 }, // R
+        { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E }, // S
+        { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // T
+        { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // U
+        { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 }, // V
+        { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A }, // W
+        { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 }, // X
+        { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 }, // Y
+        { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F }, // Z
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C }, // .
+        { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 }, // :
+        { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 }, // /
+        { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 }, // %
+        { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 }, // -
+        { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 }, // (
+        { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 }, // )
+        { 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00 }, // =
+    };
+    constexpr std::size_t GLYPH_COUNT = sizeof(GLYPH_ROWS) / sizeof(GLYPH_ROWS[0]);
+    static_assert(GLYPH_COUNT == sizeof(GLYPHS) - 1, "one bitmap per glyph");
+
+    constexpr unsigned int CELL_WIDTH = 6;      // 5 pixels + spacing
+    constexpr unsigned int CELL_HEIGHT = 8;
+    constexpr float SCALE = 2.0f;
+    constexpr float ADVANCE = CELL_WIDTH * SCALE;
+    constexpr float LINE_HEIGHT = (CELL_HEIGHT + 1) * SCALE;
+
+    constexpr float MARGIN = 10.0f;
+    constexpr float PADDING = 8.0f;
+    constexpr float PANEL_WIDTH = 300.0f;
+    constexpr float GRAPH_HEIGHT = 60.0f;
+    constexpr float GRAPH_MAX_MS = 1000.0f / 30.0f;
+    constexpr float BUDGET_MS = 1000.0f / 60.0f;
+    constexpr std::size_t RESERVED_VERTICES = 4096;
+}
+
+PerfOverlay::PerfOverlay()
+    : m_frameTimes{}
+    , m_updateTimes{}
+    , m_sorted{}
+    , m_sampleCount(0)
+    , m_nextSample(0)
+{
+    m_vertices.reserve(PerfOverlayConfig::RESERVED_VERTICES);
+}
+
+void PerfOverlay::buildAtlas() {
+    using namespace PerfOverlayConfig;
+    m_atlasBuilt = true;
+
+    // One cell per glyph plus a solid cell at the end for rectangles
+    const unsigned int width = static_cast<unsigned int>(GLYPH_COUNT + 1) * CELL_WIDTH;
+    std::vector<std::uint8_t> pixels(width * CELL_HEIGHT * 4, 0);
+    auto setPixel = [&](unsigned int x, unsigned int y) {
+        std::uint8_t* p = &pixels[(y * width + x) * 4];
+        p[0] = p[1] = p[2] = p[3] = 255;
+    };
+
+    m_glyphIndex.fill(-1);
+    for (std::size_t g = 0; g < GLYPH_COUNT; ++g) {
+        m_glyphIndex[static_cast<unsigned char>(GLYPHS[g])] = static_cast<std::int16_t>(g);
+        for (unsigned int row = 0; row < 7; ++row) {
+            for (unsigned int col = 0; col < 5; ++col) {
+                if (GLYPH_ROWS[g][row] & (0x10 >> col)) setPixel(static_cast<unsigned int>(g) * CELL_WIDTH + col, row);
+            }
+        }
+    }
+    for (unsigned int y = 0; y < CELL_HEIGHT; ++y) {
+        for (unsigned int x = 0; x < CELL_WIDTH; ++x) setPixel(static_cast<unsigned int>(GLYPH_COUNT) * CELL_WIDTH + x, y);
+    }
+
+    if (m_atlas.resize(sf::Vector2u(width, CELL_HEIGHT))) {
+        m_atlas.update(pixels.data());
+    }
+}
+
+void PerfOverlay::recordFrame(float frameSeconds, float updateSeconds) {
+    m_frameTimes[m_nextSample] = frameSeconds * 1000.0f;
+    m_updateTimes[m_nextSample] = updateSeconds * 1000.0f;
+    m_nextSample = (m_nextSample + 1) % HISTORY;
+    m_sampleCount = std::min(m_sampleCount + 1, HISTORY);
+}
+
+float PerfOverlay::percentile(const std::array<float, HISTORY>& samples, float p) {
+    if (m_sampleCount == 0) return 0.0f;
+    std::copy(samples.begin(), samples.begin() + m_sampleCount, m_sorted.begin());
+    const std::size_t index = static_cast<std::size_t>(std::lround(p * (m_sampleCount - 1)));
+    std::nth_element(m_sorted.begin(), m_sorted.begin() + index, m_sorted.begin() + m_sampleCount);
+    return m_sorted[index];
+}
+
+void PerfOverlay::addRect(sf::Vector2f position, sf::Vector2f size, sf::Color color) {
+    using namespace PerfOverlayConfig;
+    // Every corner samples the middle of the solid cell
+    const sf::Vector2f texel(GLYPH_COUNT * CELL_WIDTH + CELL_WIDTH * 0.5f, CELL_HEIGHT * 0.5f);
+    const sf::Vector2f bottomRight = position + size;
+    m_vertices.push_back({ position, color, texel });
+    m_vertices.push_back({ sf::Vector2f(bottomRight.x, position.y), color, texel });
+    m_vertices.push_back({ bottomRight, color, texel });
+    m_vertices.push_back({ position, color, texel });
+    m_vertices.push_back({ bottomRight, color, texel });
+    m_vertices.push_back({ sf::Vector2f(position.x, bottomRight.y), color, texel });
+}
+
+void PerfOverlay::addText(sf::Vector2f position, const char* text, sf::Color color) {
+    using namespace PerfOverlayConfig;
+    for (const char* c = text; *c; ++c, position.x += ADVANCE) {
+        const unsigned char ch = static_cast<unsigned char>(std::toupper(static_cast<unsigned char>(*c)));
+        if (ch >= m_glyphIndex.size() || m_glyphIndex[ch] < 0) continue;   // spaces and unknown characters
+
+        const float u = static_cast<float>(m_glyphIndex[ch] * CELL_WIDTH);
+        const sf::Vector2f size(CELL_WIDTH * SCALE, CELL_HEIGHT * SCALE);
+        const sf::Vector2f bottomRight = position + size;
+        m_vertices.push_back({ position, color, sf::Vector2f(u, 0.0f) });
+        m_vertices.push_back({ sf::Vector2f(bottomRight.x, position.y), color, sf::Vector2f(u + CELL_WIDTH, 0.0f) });
+        m_vertices.push_back({ bottomRight, color, sf::Vector2f(u + CELL_WIDTH, CELL_HEIGHT) });
+        m_vertices.push_back({ position, color, sf::Vector2f(u, 0.0f) });
+        m_vertices.push_back({ bottomRight, color, sf::Vector2f(u + CELL_WIDTH, CELL_HEIGHT) });
+        m_vertices.push_back({ sf::Vector2f(position.x, bottomRight.y), color, sf::Vector2f(u, CELL_HEIGHT) });
+    }
+}
+
+void PerfOverlay::render(RenderCommandBuffer& commands, const PerfOverlayInfo& info) {
+    using namespace PerfOverlayConfig;
+
+    if (!m_atlasBuilt) buildAtlas();
+    m_vertices.clear();
+
+    const sf::Color label(170, 170, 170);
+    const sf::Color value(255, 255, 255);
+    const float left = static_cast<float>(info.resolution.x) - PANEL_WIDTH - MARGIN;
+    const float textLeft = left + PADDING;
+    float y = MARGIN + PADDING;
+
+    const float lines = 6.0f;
+    const float panelHeight = PADDING * 3.0f + lines * LINE_HEIGHT + GRAPH_HEIGHT;
+    addRect(sf::Vector2f(left, MARGIN), sf::Vector2f(PANEL_WIDTH, panelHeight), sf::Color(0, 0, 0, 180));
+
+    char line[64];
+    addText(sf::Vector2f(textLeft, y), "MS      P50   P95   P99", label);
+    y += LINE_HEIGHT;
+    std::snprintf(line, sizeof(line), "FRAME %5.1f %5.1f %5.1f",
+                  percentile(m_frameTimes, 0.5f), percentile(m_frameTimes, 0.95f), percentile(m_frameTimes, 0.99f));
+    addText(sf::Vector2f(textLeft, y), line, value);
+    y += LINE_HEIGHT;
+    std::snprintf(line, sizeof(line), "UPDATE%5.2f %5.2f %5.2f",
+                  percentile(m_updateTimes, 0.5f), percentile(m_updateTimes, 0.95f), percentile(m_updateTimes, 0.99f));
+    addText(sf::Vector2f(textLeft, y), line, value);
+    y += LINE_HEIGHT;
+    std::snprintf(line, sizeof(line), "DRAWS %u  VERTS %u",
+                  static_cast<unsigned int>(info.render.drawCalls), static_cast<unsigned int>(info.render.vertices));
+    addText(sf::Vector2f(textLeft, y), line, value);
+    y += LINE_HEIGHT;
+    if (info.allocationsCounted) {
+        std::snprintf(line, sizeof(line), "ALLOCS %llu  TRAFFIC %u",
+                      static_cast<unsigned long long>(info.allocations), static_cast<unsigned int>(info.trafficCars));
+    } else {
+        std::snprintf(line, sizeof(line), "ALLOCS -  TRAFFIC %u", static_cast<unsigned int>(info.trafficCars));
+    }
+    addText(sf::Vector2f(textLeft, y), line, value);
+    y += LINE_HEIGHT;
+    std::snprintf(line, sizeof(line), "RES %ux%u", info.resolution.x, info.resolution.y);
+    addText(sf::Vector2f(textLeft, y), line, value);
+    y += LINE_HEIGHT + PADDING;
+
+    // Frame-time graph, oldest frame on the left; guides at 60 and 30 FPS
+    const float graphWidth = PANEL_WIDTH - PADDING * 2.0f;
+    const float barWidth = graphWidth / HISTORY;
+    const float graphBottom = y + GRAPH_HEIGHT;
+    addRect(sf::Vector2f(textLeft, graphBottom - GRAPH_HEIGHT * BUDGET_MS / GRAPH_MAX_MS), sf::Vector2f(graphWidth, 1.0f), sf::Color(80, 160, 80));
+    addRect(sf::Vector2f(textLeft, y), sf::Vector2f(graphWidth, 1.0f), sf::Color(160, 80, 80));
+
+    for (std::size_t i = 0; i < m_sampleCount; ++i) {
+        const std::size_t sample = (m_nextSample + HISTORY - m_sampleCount + i) % HISTORY;
+        const float ms = m_frameTimes[sample];
+        const float height = std::min(ms / GRAPH_MAX_MS, 1.0f) * GRAPH_HEIGHT;
+        const sf::Color color = ms <= BUDGET_MS * 1.1f ? sf::Color(90, 220, 90)
+                              : ms <= GRAPH_MAX_MS ? sf::Color(240, 200, 60)
+                              : sf::Color(240, 70, 70);
+        addRect(sf::Vector2f(textLeft + (HISTORY - m_sampleCount + i) * barWidth, graphBottom - height),
+                sf::Vector2f(std::max(barWidth, 1.0f), height), color);
+    }
+
+    commands.setLayer(RenderLayer::Overlay);
+    commands.drawVertices(m_vertices.data(), m_vertices.size(), &m_atlas);
+}
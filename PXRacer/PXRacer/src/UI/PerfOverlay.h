@@ -0,0 +1,50 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Rendering/RenderBackend.h"
+
+class RenderCommandBuffer;
+
+// What the overlay reports besides the timings it collects itself
+struct PerfOverlayInfo {
+    RenderStats render;                 // last played back frame
+    std::uint64_t allocations = 0;      // heap allocations during the last frame, all threads
+    bool allocationsCounted = false;    // false without the allocation hooks (release builds)
+    std::size_t trafficCars = 0;
+    sf::Vector2u resolution;
+};
+
+// Frame-time graph and percentiles (F3). Everything, text included, goes into
+// one vertex array textured with a tiny bitmap font baked the first time it
+// is shown, so showing it costs one extra draw call and no allocations.
+class PerfOverlay {
+public:
+    static constexpr std::size_t HISTORY = 240;     // frames in the graph and percentiles, ~4 s at 60 Hz
+
+    PerfOverlay();
+
+    // Once per frame with the previous frame's wall time and time spent in simulation ticks
+    void recordFrame(float frameSeconds, float updateSeconds);
+    void render(RenderCommandBuffer& commands, const PerfOverlayInfo& info);
+
+private:
+    void buildAtlas();
+    void addRect(sf::Vector2f position, sf::Vector2f size, sf::Color color);
+    void addText(sf::Vector2f position, const char* text, sf::Color color);
+    // p in 0..1 over the recorded history, in milliseconds
+    float percentile(const std::array<float, HISTORY>& samples, float p);
+
+    sf::Texture m_atlas;
+    bool m_atlasBuilt = false;
+    std::array<std::int16_t, 128> m_glyphIndex;
+    std::vector<sf::Vertex> m_vertices;
+
+    std::array<float, HISTORY> m_frameTimes;
+    std::array<float, HISTORY> m_updateTimes;
+    std::array<float, HISTORY> m_sorted;
+    std::size_t m_sampleCount;
+    std::size_t m_nextSample;
+};
@@ -1,5 +1,6 @@
 #include "ScreenSettingsState.h"
 #include "Core/Game.h"
+#include "Core/ResourceCache.h"
 #include "Core/Constants.h"
 #include "Core/AudioManager.h"
 #include "Core/SettingsManager.h"
@@ -10,6 +11,7 @@
 // Constructor - Initializes the screen settings menu
 ScreenSettingsState::ScreenSettingsState(Game* game)
     : State(game)
+    , m_font(ResourceCache::getInstance().getFont(MenuStyle::MENU_FONT_PATH))
     , m_selectedIndex(0)
     , m_blinkTimer(0.0f)
     , m_showSelector(true)
@@ -21,8 +23,8 @@ ScreenSettingsState::ScreenSettingsState(Game* game)
     m_fullscreenEnabled = settings.isFullscreen();
 
     // Load background
-    m_backgroundTexture = std::make_unique<sf::Texture>();
-    if (m_backgroundTexture->loadFromFile(MenuStyle::MENU_BACKGROUND_PATH)) {
+    m_backgroundTexture = ResourceCache::getInstance().getTexture(MenuStyle::MENU_BACKGROUND_PATH);
+    if (m_backgroundTexture) {
         m_backgroundSprite = std::make_unique<sf::Sprite>(*m_backgroundTexture);
         
         auto textureSize = m_backgroundTexture->getSize();
@@ -33,11 +35,6 @@ ScreenSettingsState::ScreenSettingsState(Game* game)
         std::cerr << "Failed to load background texture!" << std::endl;
     }
 
-    // Load font
-    if (!m_font.openFromFile(MenuStyle::MENU_FONT_PATH)) {
-        std::cerr << "Failed to load font!" << std::endl;
-    }
-
     // Create title
     m_titleText = std::make_unique<sf::Text>(m_font, sf::String());
     m_titleText->setString("SCREEN SETTINGS");
@@ -1,16 +1,208 @@
 #include "Core/Game.h"
+#include "Core/Random.h"
+#include "Core/SettingsManager.h"
+#include "Core/AllocationTracker.h"
+#include "Core/TraceExporter.h"
+#include "Core/HitchDetector.h"
+#include "Core/Logger.h"
+#include "Core/SceneBenchmark.h"
+#include "Core/BenchmarkBaseline.h"
+#include "Core/StartupTimeline.h"
 #include <iostream>
+#include <algorithm>
 #include <exception>
+#include <string>
 
-int main() {
+namespace {
+    // "1920x1080" -> index into SettingsManager::AVAILABLE_RESOLUTIONS, -1 if not supported
+    int findResolution(const std::string& text) {
+        const auto& resolutions = SettingsManager::AVAILABLE_RESOLUTIONS;
+        for (int i = 0; i < static_cast<int>(resolutions.size()); ++i) {
+            if (text == std::to_string(resolutions[i].width) + "x" + std::to_string(resolutions[i].height)) return i;
+        }
+        return -1;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    StartupTimeline::getInstance().begin();
     try {
         std::cout << "========================================" << std::endl;
         std::cout << "  PIXELRACER - Alpha 0.1" << std::endl;
         std::cout << "========================================" << std::endl;
         std::cout << std::endl;
 
+        // --seed <n> replays a previous run, otherwise every launch is different
+        std::uint64_t seed = RandomService::makeEntropySeed();
+        unsigned int tickRate = 0;
+        bool pipelined = false;
+        int jobThreads = -1;
+        bool singleThreaded = false;
+        std::string tracePath;
+        std::size_t traceFrames = 0;
+        bool perfOverlay = false;
+        std::string hitchLogPath;
+        float hitchBudgetMs = HitchDetector::DEFAULT_BUDGET_MS;
+        bool sceneBenchmark = false;
+        bool startupBenchmark = false;
+        bool seedGiven = false;
+        SceneBenchmarkOptions sceneOptions;
+        std::string sceneJsonPath;
+        std::string sceneBaselinePath;
+        BaselineComparison sceneBaseline;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--seed" && i + 1 < argc) {
+                seed = std::stoull(argv[++i], nullptr, 0);
+                seedGiven = true;
+            } else if (arg == "--tick-rate" && i + 1 < argc) {
+                tickRate = static_cast<unsigned int>(std::stoul(argv[++i]));
+            } else if (arg == "--pipelined") {
+                pipelined = true;
+            } else if (arg == "--jobs" && i + 1 < argc) {
+                jobThreads = std::stoi(argv[++i]);
+            } else if (arg == "--single-threaded") {
+                singleThreaded = true;
+            } else if (arg == "--trace" && i + 1 < argc) {
+                tracePath = argv[++i];
+            } else if (arg == "--trace-frames" && i + 1 < argc) {
+                traceFrames = static_cast<std::size_t>(std::stoul(argv[++i]));
+            } else if (arg == "--hitch-log" && i + 1 < argc) {
+                hitchLogPath = argv[++i];
+            } else if (arg == "--hitch-budget" && i + 1 < argc) {
+                hitchBudgetMs = std::stof(argv[++i]);
+            } else if (arg == "--benchmark-scene") {
+                sceneBenchmark = true;
+            } else if (arg == "--benchmark-startup") {
+                startupBenchmark = true;
+            } else if (arg == "--benchmark-frames" && i + 1 < argc) {
+                sceneOptions.frames = std::max(1, std::stoi(argv[++i]));
+            } else if (arg == "--benchmark-warmup" && i + 1 < argc) {
+                sceneOptions.warmupFrames = std::max(0, std::stoi(argv[++i]));
+            } else if (arg == "--benchmark-resolution" && i + 1 < argc) {
+                const int index = findResolution(argv[++i]);
+                if (index < 0) {
+                    std::cerr << "[BENCH] Unsupported resolution " << argv[i] << std::endl;
+                    return 1;
+                }
+                sceneOptions.resolutions.push_back(index);
+            } else if (arg == "--benchmark-filter" && i + 1 < argc) {
+                sceneOptions.filter = argv[++i];
+            } else if (arg == "--benchmark-json" && i + 1 < argc) {
+                sceneJsonPath = argv[++i];
+            } else if (arg == "--benchmark-baseline" && i + 1 < argc) {
+                sceneBaselinePath = argv[++i];
+            } else if (arg == "--benchmark-threshold" && i + 1 < argc) {
+                RegressionThreshold threshold;
+                if (!RegressionThreshold::parse(argv[++i], threshold)) {
+                    std::cerr << "[BENCH] Bad threshold " << argv[i] << " (metric:percent[:name], e.g. p95:5:monaco)" << std::endl;
+                    return 1;
+                }
+                sceneBaseline.addThreshold(threshold);
+            } else if (arg == "--benchmark-trust-baseline") {
+                sceneBaseline.setTrustBaseline(true);
+            } else if (arg == "--offscreen") {
+                sceneOptions.offscreen = true;
+            } else if (arg == "--perf-overlay") {
+                perfOverlay = true;
+            } else if (arg == "--track-allocations") {
+                if (AllocationCounter::ENABLED) {
+                    AllocationTracker::getInstance().setEnabled(true);
+                    std::cout << "[ALLOC] Tracking allocations (F9 toggles the overlay, report on exit)" << std::endl;
+                } else {
+                    std::cout << "[ALLOC] --track-allocations needs a Debug build or PXRACER_ALLOCATION_HOOKS=ON" << std::endl;
+                }
+            }
+        }
+        RandomService::getInstance().setSeed(seed);
+
+        // Runs instead of the game; the fixed seed keeps runs comparable
+        if (sceneBenchmark) {
+            if (seedGiven) sceneOptions.seed = seed;
+            std::string error;
+            if (!sceneBaselinePath.empty() && !sceneBaseline.load(sceneBaselinePath, error)) {
+                std::cerr << "[BENCH] Baseline: " << error << std::endl;
+                return 1;
+            }
+            SceneBenchmark benchmark(sceneOptions);
+            const bool completed = benchmark.run();
+            Logger::getInstance().flush();
+            if (!sceneJsonPath.empty()) {
+                if (!benchmark.writeJson(sceneJsonPath)) {
+                    std::cerr << "[BENCH] Failed to write " << sceneJsonPath << std::endl;
+                    return 1;
+                }
+                std::cout << "[BENCH] Wrote " << sceneJsonPath << std::endl;
+            }
+            if (!completed) return 1;
+            if (!sceneBaselinePath.empty()) {
+                std::vector<BenchmarkSamples> samples;
+                for (const SceneBenchmarkResult& result : benchmark.getResults()) {
+                    samples.push_back({ result.getName(), result.frameMs });
+                }
+                if (sceneBaseline.compare(samples, stdout) > 0) return 1;
+            }
+            return 0;
+        }
+        std::cout << "[GAME] Master seed: " << seed << std::endl;
+
+        std::string error;
+        if (startupBenchmark && !sceneBaselinePath.empty() && !sceneBaseline.load(sceneBaselinePath, error)) {
+            std::cerr << "[BENCH] Baseline: " << error << std::endl;
+            return 1;
+        }
+
+        StartupTimeline::getInstance().beginPhase("Game");
         Game game;
+        StartupTimeline::getInstance().endPhase();
+        // Launch to first frame, then exit (results as benchmark JSON with --benchmark-json)
+        game.setExitAfterFirstFrame(startupBenchmark);
+        // Overrides the saved setting (Game loads settings.txt first)
+        if (tickRate > 0) {
+            SettingsManager::getInstance().setSimTickRate(tickRate);
+        }
+        if (pipelined) {
+            SettingsManager::getInstance().setPipelinedSimulation(true);
+        }
+        if (jobThreads >= 0) {
+            SettingsManager::getInstance().setJobThreads(static_cast<unsigned int>(jobThreads));
+        }
+        if (singleThreaded) {
+            SettingsManager::getInstance().setSingleThreadedJobs(true);
+        }
+        if (perfOverlay) {
+            game.setPerfOverlayVisible(true);
+        }
+        if (!hitchLogPath.empty()) {
+            game.setHitchDetection(hitchLogPath, hitchBudgetMs);
+        }
+        if (!tracePath.empty() || traceFrames > 0) {
+            game.setTraceCapture(tracePath, traceFrames > 0 ? traceFrames : TraceExporter::DEFAULT_FRAMES);
+        }
         game.run();
+        Logger::getInstance().flush();
+
+        if (startupBenchmark) {
+            const StartupTimeline& startup = StartupTimeline::getInstance();
+            if (!startup.hasFirstFrame()) {
+                std::cerr << "[BENCH] Window closed before the first frame" << std::endl;
+                return 1;
+            }
+            if (!sceneJsonPath.empty()) {
+                if (!startup.writeJson(sceneJsonPath)) {
+                    std::cerr << "[BENCH] Failed to write " << sceneJsonPath << std::endl;
+                    return 1;
+                }
+                std::cout << "[BENCH] Wrote " << sceneJsonPath << std::endl;
+            }
+            if (!sceneBaselinePath.empty()) {
+                std::vector<BenchmarkSamples> samples = { { "startup/time_to_first_frame", { startup.getTimeToFirstFrameMs() } } };
+                for (const StartupPhase& phase : startup.getPhases()) {
+                    samples.push_back({ std::string("startup/") + phase.name, { phase.durationMs } });
+                }
+                if (sceneBaseline.compare(samples, stdout) > 0) return 1;
+            }
+        }
 
         std::cout << std::endl;
         std::cout << "========================================" << std::endl;